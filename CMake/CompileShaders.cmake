@@ -0,0 +1,30 @@
+project(NorthEngine)
+
+# Builds every shader in Content/Shaders/Source into Content/Shaders/Compiled with the ShaderCompiler tool:
+# <name>.spv, <name>.refl (reflection) and ShaderManifest.txt (content hashes). Runs on every build, the tool skips
+# shaders whose sources, includes and settings haven't changed.
+function(CompileShaders TARGET_NAME)
+    find_program(GLSLC glslc HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin)
+    find_program(DXC dxc HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin)
+    if (NOT GLSLC)
+        message(WARNING "glslc not found, shaders will not be compiled")
+        return()
+    endif ()
+
+    set(SHADER_COMPILER_ARGS
+            --source ${CMAKE_SOURCE_DIR}/Content/Shaders/Source
+            --output ${CMAKE_SOURCE_DIR}/Content/Shaders/Compiled
+            --glslc ${GLSLC}
+    )
+    if (DXC)
+        list(APPEND SHADER_COMPILER_ARGS --dxc ${DXC})
+    endif ()
+
+    add_custom_target(${TARGET_NAME}_shaders
+            COMMAND ShaderCompiler ${SHADER_COMPILER_ARGS}
+            DEPENDS ShaderCompiler
+            COMMENT "Compiling shaders"
+            VERBATIM
+    )
+    add_dependencies(${TARGET_NAME} ${TARGET_NAME}_shaders)
+endfunction()
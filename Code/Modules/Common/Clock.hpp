@@ -0,0 +1,21 @@
+// Author: Jake Rieger
+// Created: 11/20/25.
+//
+
+#pragma once
+
+#include "Typedefs.hpp"
+
+#include <chrono>
+
+namespace North {
+    /// @brief Monotonic clock that doesn't depend on GLFW being initialized (usable in headless runs)
+    class Clock {
+    public:
+        /// @brief Seconds elapsed since an arbitrary fixed point
+        static f64 Now() {
+            using namespace std::chrono;
+            return duration<f64>(steady_clock::now().time_since_epoch()).count();
+        }
+    };
+}  // namespace North
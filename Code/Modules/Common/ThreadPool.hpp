@@ -0,0 +1,161 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Macros.hpp"
+#include "Typedefs.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace North {
+    /// @brief Fixed set of worker threads pulling tasks from a shared FIFO queue
+    class ThreadPool {
+    public:
+        ThreadPool() = default;
+
+        ~ThreadPool() {
+            Stop();
+        }
+
+        NE_CLASS_PREVENT_MOVES_COPIES(ThreadPool)
+
+        /// @brief Spawn the workers. 0 uses every hardware thread but the calling one (at least one worker).
+        void Start(u32 threadCount = 0) {
+            if (!mWorkers.empty()) return;
+
+            if (threadCount == 0) {
+                const u32 hardwareThreads = std::thread::hardware_concurrency();
+                threadCount               = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+            }
+
+            mStopping = false;
+            for (u32 i = 0; i < threadCount; i++) {
+                mWorkers.emplace_back([this] { WorkerLoop(); });
+            }
+        }
+
+        /// @brief Finish every queued task, then join the workers
+        void Stop() {
+            {
+                std::lock_guard lock(mMutex);
+                mStopping = true;
+            }
+            mTaskAvailable.notify_all();
+
+            for (auto& worker : mWorkers) {
+                worker.join();
+            }
+            mWorkers.clear();
+        }
+
+        /// @brief Queue a task. Runs inline when the pool hasn't been started.
+        void Enqueue(std::function<void()> task) {
+            if (mWorkers.empty()) {
+                task();
+                return;
+            }
+
+            {
+                std::lock_guard lock(mMutex);
+                mTasks.push(std::move(task));
+            }
+            mTaskAvailable.notify_one();
+        }
+
+        /**
+         * @brief Run `task(i)` for every i in [0, count) on the workers and the calling thread
+         *
+         * Returns once all of them finished. Unlike WaitIdle() it doesn't wait for anything else queued, so it can
+         * be used every frame while long tasks (texture loads) are running. Indices are claimed one at a time, so
+         * uneven tasks balance out.
+         */
+        void ParallelFor(u32 count, const std::function<void(u32)>& task) {
+            if (mWorkers.empty() || count <= 1) {
+                for (u32 i = 0; i < count; i++) {
+                    task(i);
+                }
+                return;
+            }
+
+            struct Batch {
+                std::atomic<u32> next {0};
+                u32 done = 0;
+                std::mutex mutex;
+                std::condition_variable finished;
+            };
+            auto batch = make_shared<Batch>();
+
+            // Workers that only get to it after every index was claimed leave without touching `task`
+            const auto drain = [batch, count, &task] {
+                u32 completed = 0;
+                for (u32 i = batch->next++; i < count; i = batch->next++) {
+                    task(i);
+                    completed++;
+                }
+                if (completed == 0) return;
+
+                std::lock_guard lock(batch->mutex);
+                batch->done += completed;
+                if (batch->done == count) { batch->finished.notify_all(); }
+            };
+
+            const u32 helpers = NE_MIN(count - 1, GetThreadCount());
+            for (u32 i = 0; i < helpers; i++) {
+                Enqueue(drain);
+            }
+            drain();
+
+            std::unique_lock lock(batch->mutex);
+            batch->finished.wait(lock, [&batch, count] { return batch->done == count; });
+        }
+
+        /// @brief Block until the queue is empty and no task is running
+        void WaitIdle() {
+            std::unique_lock lock(mMutex);
+            mIdle.wait(lock, [this] { return mTasks.empty() && mActiveTasks == 0; });
+        }
+
+        NE_ND u32 GetThreadCount() const {
+            return CAST<u32>(mWorkers.size());
+        }
+
+    private:
+        void WorkerLoop() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(mMutex);
+                    mTaskAvailable.wait(lock, [this] { return mStopping || !mTasks.empty(); });
+                    if (mTasks.empty()) return;  // Stopping and drained
+
+                    task = std::move(mTasks.front());
+                    mTasks.pop();
+                    mActiveTasks++;
+                }
+
+                task();
+
+                {
+                    std::lock_guard lock(mMutex);
+                    mActiveTasks--;
+                    if (mTasks.empty() && mActiveTasks == 0) { mIdle.notify_all(); }
+                }
+            }
+        }
+
+        vector<std::thread> mWorkers;
+        std::queue<std::function<void()>> mTasks;
+        std::mutex mMutex;
+        std::condition_variable mTaskAvailable;
+        std::condition_variable mIdle;
+        u32 mActiveTasks = 0;
+        bool mStopping   = false;
+    };
+}  // namespace North
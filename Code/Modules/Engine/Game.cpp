@@ -10,25 +10,34 @@ namespace North::Engine {
         mActiveScene = make_unique<Scene>();
     }
 
+    void Game::InitializeHeadless(u32 width, u32 height, bool enableRendering) {
+        mRenderingEnabled = enableRendering;
+        if (mRenderingEnabled) { mRenderContext.Initialize(nullptr, width, height); }
+        mActiveScene = make_unique<Scene>();
+    }
+
     void Game::Shutdown() {
         mActiveScene.reset();
         mRenderContext.Shutdown();
     }
 
-    void Game::RequestFrame() {
+    void Game::RequestFrame(f32 alpha) {
+        if (!mRenderingEnabled) return;
+
         // auto frameData = mRenderContext.BeginFrame();
-        mActiveScene->Draw(mRenderContext);
+        mActiveScene->Draw(mRenderContext, alpha);
         // mRenderContext.EndFrame(frameData);
 
         mRenderContext.DrawFrame();
     }
 
     void Game::Resize(u32 width, u32 height) {
-        mRenderContext.Resize(width, height);
+        if (mRenderingEnabled) { mRenderContext.Resize(width, height); }
     }
 
     bool Game::Initialized() const {
-        return mRenderContext.Initialized();
+        if (!mActiveScene) return false;
+        return !mRenderingEnabled || mRenderContext.Initialized();
     }
 
     void Game::Awake() {
@@ -14,12 +14,18 @@ namespace North::Engine {
         Game() = default;
 
         void Initialize(GLFWwindow* window, u32 width, u32 height);
+        /// @brief Initialize without a window, optionally rendering into an offscreen target
+        void InitializeHeadless(u32 width, u32 height, bool enableRendering);
         void Shutdown();
-        void RequestFrame();
+        void RequestFrame(f32 alpha);
         void Resize(u32 width, u32 height);
 
         NE_ND bool Initialized() const;
 
+        NE_ND Graphics::RenderContext& GetRenderContext() {
+            return mRenderContext;
+        }
+
         void Awake();
         void Update(f32 dT);
         void LateUpdate();
@@ -28,5 +34,6 @@ namespace North::Engine {
     private:
         Graphics::RenderContext mRenderContext;
         unique_ptr<Scene> mActiveScene;
+        bool mRenderingEnabled = true;
     };
 }  // namespace North::Engine
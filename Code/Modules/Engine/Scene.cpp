@@ -9,7 +9,7 @@ namespace North::Engine {
         return false;
     }
 
-    void Scene::Draw(Graphics::RenderContext& renderContext) {}
+    void Scene::Draw(Graphics::RenderContext& renderContext, f32 alpha) {}
 
     void Scene::Awake() {}
 
@@ -16,7 +16,8 @@ namespace North::Engine {
         bool LoadFromFile(const fs::path& filrname);
         // bool LoadFromDescriptor(struct SceneDescriptor& descriptor);
 
-        void Draw(Graphics::RenderContext& renderContext);
+        /// @param alpha Interpolation factor between the previous and current fixed update
+        void Draw(Graphics::RenderContext& renderContext, f32 alpha);
 
         void Awake();
         void Update(f32 dT);
@@ -0,0 +1,249 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "BindlessTable.hpp"
+#include <iostream>
+
+namespace North::Graphics {
+    bool BindlessTable::Initialize(VkDevice device, VkPhysicalDevice physicalDevice, DeletionQueue& deletionQueue) {
+        mDevice        = device;
+        mDeletionQueue = &deletionQueue;
+
+        VkPhysicalDeviceVulkan12Properties properties12 {};
+        properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 properties {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &properties12;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+        // Every binding is visible to all stages, so the per-stage limits apply as well as the per-set ones. Those
+        // count every set of a pipeline layout, leave room for the sets bound next to the table.
+        const auto perStage = [](u32 limit) { return limit > kReservedPerStage ? limit - kReservedPerStage : 0; };
+
+        const u32 maxImages   = NE_MIN(properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+                                       perStage(properties12.maxPerStageDescriptorUpdateAfterBindSampledImages));
+        const u32 maxBuffers  = NE_MIN(properties12.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                       perStage(properties12.maxPerStageDescriptorUpdateAfterBindStorageBuffers));
+        const u32 maxSamplers = NE_MIN(properties12.maxDescriptorSetUpdateAfterBindSamplers,
+                                       perStage(properties12.maxPerStageDescriptorUpdateAfterBindSamplers));
+
+        u32 images  = NE_MIN(kMaxSampledImages, maxImages);
+        u32 buffers = NE_MIN(kMaxStorageBuffers, maxBuffers);
+
+        // Images and buffers also share one per-stage resource limit (samplers don't count towards it)
+        const u32 maxResources = perStage(properties12.maxPerStageUpdateAfterBindResources);
+        if (images + buffers > maxResources) {
+            buffers = NE_MIN(buffers, maxResources / 4);
+            images  = NE_MIN(images, maxResources - buffers);
+        }
+
+        mSlots[SampledImages].capacity  = images;
+        mSlots[StorageBuffers].capacity = buffers;
+        mSlots[Samplers].capacity       = NE_MIN(kMaxSamplers, maxSamplers);
+
+        const VkDescriptorType types[KindCount] = {
+          VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_SAMPLER};
+        const u32 bindingIndices[KindCount] = {kSampledImageBinding, kStorageBufferBinding, kSamplerBinding};
+
+        VkDescriptorSetLayoutBinding bindings[KindCount] {};
+        VkDescriptorBindingFlags bindingFlags[KindCount] {};
+        VkDescriptorPoolSize poolSizes[KindCount] {};
+        for (u32 kind = 0; kind < KindCount; kind++) {
+            bindings[kind].binding         = bindingIndices[kind];
+            bindings[kind].descriptorType  = types[kind];
+            bindings[kind].descriptorCount = mSlots[kind].capacity;
+            bindings[kind].stageFlags      = VK_SHADER_STAGE_ALL;
+
+            // Unused entries may stay unwritten, and entries can change while the set is bound in pending work
+            bindingFlags[kind] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                                 VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                 VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+            poolSizes[kind].type            = types[kind];
+            poolSizes[kind].descriptorCount = mSlots[kind].capacity;
+        }
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo {};
+        bindingFlagsInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        bindingFlagsInfo.bindingCount  = KindCount;
+        bindingFlagsInfo.pBindingFlags = bindingFlags;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = &bindingFlagsInfo;
+        layoutInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = KindCount;
+        layoutInfo.pBindings    = bindings;
+
+        if (vkCreateDescriptorSetLayout(mDevice, &layoutInfo, nullptr, &mDescriptorSetLayout) != VK_SUCCESS) {
+            std::cerr << "Failed to create bindless descriptor set layout!" << std::endl;
+            return false;
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo {};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = KindCount;
+        poolInfo.pPoolSizes    = poolSizes;
+
+        if (vkCreateDescriptorPool(mDevice, &poolInfo, nullptr, &mDescriptorPool) != VK_SUCCESS) {
+            std::cerr << "Failed to create bindless descriptor pool!" << std::endl;
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo {};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool     = mDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts        = &mDescriptorSetLayout;
+
+        if (vkAllocateDescriptorSets(mDevice, &allocInfo, &mDescriptorSet) != VK_SUCCESS) {
+            std::cerr << "Failed to allocate bindless descriptor set!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void BindlessTable::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        vkDestroyDescriptorPool(mDevice, mDescriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(mDevice, mDescriptorSetLayout, nullptr);
+
+        mDescriptorPool      = VK_NULL_HANDLE;
+        mDescriptorSet       = VK_NULL_HANDLE;
+        mDescriptorSetLayout = VK_NULL_HANDLE;
+        mDevice              = VK_NULL_HANDLE;
+        mSlots               = {};
+    }
+
+    u32 BindlessTable::RegisterImage(VkImageView view, VkImageLayout layout) {
+        const u32 index = AllocateIndex(SampledImages);
+        if (index != kInvalidIndex) { WriteImage(index, view, layout); }
+        return index;
+    }
+
+    u32 BindlessTable::RegisterBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+        const u32 index = AllocateIndex(StorageBuffers);
+        if (index != kInvalidIndex) { WriteBuffer(index, buffer, offset, range); }
+        return index;
+    }
+
+    u32 BindlessTable::RegisterBuffer(const Buffer& buffer) {
+        return RegisterBuffer(buffer.GetHandle(), 0, buffer.GetSize());
+    }
+
+    u32 BindlessTable::RegisterSampler(VkSampler sampler) {
+        const u32 index = AllocateIndex(Samplers);
+        if (index != kInvalidIndex) { WriteSampler(index, sampler); }
+        return index;
+    }
+
+    void BindlessTable::UpdateImage(u32 index, VkImageView view, VkImageLayout layout) {
+        if (index < mSlots[SampledImages].next) { WriteImage(index, view, layout); }
+    }
+
+    void BindlessTable::UpdateBuffer(u32 index, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+        if (index < mSlots[StorageBuffers].next) { WriteBuffer(index, buffer, offset, range); }
+    }
+
+    void BindlessTable::ReleaseImage(u32 index) {
+        ReleaseIndex(SampledImages, index);
+    }
+
+    void BindlessTable::ReleaseBuffer(u32 index) {
+        ReleaseIndex(StorageBuffers, index);
+    }
+
+    void BindlessTable::ReleaseSampler(u32 index) {
+        ReleaseIndex(Samplers, index);
+    }
+
+    void BindlessTable::Bind(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout) const {
+        vkCmdBindDescriptorSets(cmd, bindPoint, layout, kDescriptorSet, 1, &mDescriptorSet, 0, nullptr);
+    }
+
+    u32 BindlessTable::AllocateIndex(Kind kind) {
+        Slots& slots = mSlots[kind];
+
+        u32 index = kInvalidIndex;
+        if (!slots.freeList.empty()) {
+            index = slots.freeList.back();
+            slots.freeList.pop_back();
+        } else if (slots.next < slots.capacity) {
+            index = slots.next++;
+        } else {
+            std::cerr << "Bindless table is full (" << slots.capacity << " entries)!" << std::endl;
+            return kInvalidIndex;
+        }
+
+        slots.used++;
+        return index;
+    }
+
+    void BindlessTable::ReleaseIndex(Kind kind, u32 index) {
+        if (index >= mSlots[kind].next) return;
+
+        // Frames recorded so far may still index it, reuse only once they have completed. The stale descriptor
+        // stays in place until then, partially bound arrays don't require clearing it.
+        mDeletionQueue->Retire([this, kind, index](VkDevice, VmaAllocator) {
+            mSlots[kind].freeList.push_back(index);
+            mSlots[kind].used--;
+        });
+    }
+
+    void BindlessTable::WriteImage(u32 index, VkImageView view, VkImageLayout layout) const {
+        VkDescriptorImageInfo imageInfo {};
+        imageInfo.imageView   = view;
+        imageInfo.imageLayout = layout;
+
+        VkWriteDescriptorSet write {};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet          = mDescriptorSet;
+        write.dstBinding      = kSampledImageBinding;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        write.pImageInfo      = &imageInfo;
+
+        vkUpdateDescriptorSets(mDevice, 1, &write, 0, nullptr);
+    }
+
+    void BindlessTable::WriteBuffer(u32 index, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) const {
+        VkDescriptorBufferInfo bufferInfo {};
+        bufferInfo.buffer = buffer;
+        bufferInfo.offset = offset;
+        bufferInfo.range  = range;
+
+        VkWriteDescriptorSet write {};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet          = mDescriptorSet;
+        write.dstBinding      = kStorageBufferBinding;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo     = &bufferInfo;
+
+        vkUpdateDescriptorSets(mDevice, 1, &write, 0, nullptr);
+    }
+
+    void BindlessTable::WriteSampler(u32 index, VkSampler sampler) const {
+        VkDescriptorImageInfo imageInfo {};
+        imageInfo.sampler = sampler;
+
+        VkWriteDescriptorSet write {};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet          = mDescriptorSet;
+        write.dstBinding      = kSamplerBinding;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLER;
+        write.pImageInfo      = &imageInfo;
+
+        vkUpdateDescriptorSets(mDevice, 1, &write, 0, nullptr);
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,118 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+#include "DeletionQueue.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+
+namespace North::Graphics {
+    /**
+     * @brief One global descriptor set holding every texture, sampler and storage buffer
+     *
+     * Resources are registered once and get a stable index into large update-after-bind arrays, materials store
+     * those indices and shaders index the arrays directly (see Content/Shaders/Source/Bindless.glsl). The set
+     * is bound once per pipeline layout change rather than once per draw.
+     *
+     * Registering or releasing a resource writes the descriptor while command buffers using the set may be
+     * pending, which update-after-bind plus partially bound arrays allow. Released indices only go back on the
+     * free list after every frame that might still read them has completed.
+     */
+    class BindlessTable {
+    public:
+        static constexpr u32 kInvalidIndex = ~0u;
+
+        /// Set index pipelines bind the table at, matches Bindless.glsl
+        static constexpr u32 kDescriptorSet = 2;
+
+        static constexpr u32 kSampledImageBinding  = 0;
+        static constexpr u32 kStorageBufferBinding = 1;
+        static constexpr u32 kSamplerBinding       = 2;
+
+        /// Upper bounds, clamped to the device's per-set and per-stage update-after-bind limits
+        static constexpr u32 kMaxSampledImages  = 1u << 16;
+        static constexpr u32 kMaxStorageBuffers = 1u << 14;
+        static constexpr u32 kMaxSamplers       = 256;
+
+        /// Per-stage descriptors of each kind left for the other sets in a pipeline layout
+        static constexpr u32 kReservedPerStage = 32;
+
+        BindlessTable() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(BindlessTable)
+
+        bool Initialize(VkDevice device, VkPhysicalDevice physicalDevice, DeletionQueue& deletionQueue);
+        void Shutdown();
+
+        /// @return Index into the sampled image array, kInvalidIndex if it's full
+        u32 RegisterImage(VkImageView view, VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        /// @return Index into the storage buffer array, kInvalidIndex if it's full
+        u32 RegisterBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+        u32 RegisterBuffer(const Buffer& buffer);
+        /// @return Index into the sampler array, kInvalidIndex if it's full
+        u32 RegisterSampler(VkSampler sampler);
+
+        /// @brief Point an existing index at a different resource. Only while no submitted frame can still read the
+        /// index, resources replaced while in use get a new index and release the old one instead.
+        void UpdateImage(u32 index, VkImageView view, VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        void UpdateBuffer(u32 index, VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+
+        /// @brief Give the index back once in-flight frames are done with it. The resource itself is not touched.
+        void ReleaseImage(u32 index);
+        void ReleaseBuffer(u32 index);
+        void ReleaseSampler(u32 index);
+
+        void Bind(VkCommandBuffer cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout) const;
+
+        NE_ND VkDescriptorSetLayout GetDescriptorSetLayout() const {
+            return mDescriptorSetLayout;
+        }
+
+        NE_ND VkDescriptorSet GetDescriptorSet() const {
+            return mDescriptorSet;
+        }
+
+        NE_ND u32 GetImageCount() const {
+            return mSlots[SampledImages].used;
+        }
+
+        NE_ND u32 GetBufferCount() const {
+            return mSlots[StorageBuffers].used;
+        }
+
+        NE_ND u32 GetSamplerCount() const {
+            return mSlots[Samplers].used;
+        }
+
+    private:
+        enum Kind : u32 { SampledImages, StorageBuffers, Samplers, KindCount };
+
+        struct Slots {
+            vector<u32> freeList;
+            u32 next     = 0;  // Next never-used index
+            u32 capacity = 0;
+            u32 used     = 0;
+        };
+
+        u32 AllocateIndex(Kind kind);
+        void ReleaseIndex(Kind kind, u32 index);
+        void WriteImage(u32 index, VkImageView view, VkImageLayout layout) const;
+        void WriteBuffer(u32 index, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) const;
+        void WriteSampler(u32 index, VkSampler sampler) const;
+
+        VkDevice mDevice              = VK_NULL_HANDLE;
+        DeletionQueue* mDeletionQueue = nullptr;
+
+        VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool mDescriptorPool           = VK_NULL_HANDLE;
+        VkDescriptorSet mDescriptorSet             = VK_NULL_HANDLE;
+
+        std::array<Slots, KindCount> mSlots {};
+    };
+}  // namespace North::Graphics
@@ -13,11 +13,18 @@ namespace North::Graphics {
 
     Buffer::Buffer(Buffer&& other) noexcept
         : mAllocator(other.mAllocator), mBuffer(other.mBuffer), mAllocation(other.mAllocation), mSize(other.mSize),
-          mType(other.mType), mMemoryUsage(other.mMemoryUsage), mMappedData(other.mMappedData) {
+          mType(other.mType), mMemoryUsage(other.mMemoryUsage), mUsageFlags(other.mUsageFlags),
+          mMappedData(other.mMappedData), mOnRelocated(std::move(other.mOnRelocated)) {
         // Reset the source object so it doesn't destroy our resources
         other.mBuffer     = VK_NULL_HANDLE;
         other.mAllocation = VK_NULL_HANDLE;
         other.mMappedData = nullptr;
+
+        // The allocation's user data still points at the moved-from object
+        if (other.mRelocatable) {
+            other.mRelocatable = false;
+            UpdateRelocationTarget(true);
+        }
     }
 
     Buffer& Buffer::operator=(Buffer&& other) noexcept {
@@ -30,11 +37,18 @@ namespace North::Graphics {
             mSize        = other.mSize;
             mType        = other.mType;
             mMemoryUsage = other.mMemoryUsage;
+            mUsageFlags  = other.mUsageFlags;
             mMappedData  = other.mMappedData;
+            mOnRelocated = std::move(other.mOnRelocated);
 
             other.mBuffer     = VK_NULL_HANDLE;
             other.mAllocation = VK_NULL_HANDLE;
             other.mMappedData = nullptr;
+
+            if (other.mRelocatable) {
+                other.mRelocatable = false;
+                UpdateRelocationTarget(true);
+            }
         }
         return *this;
     }
@@ -59,12 +73,14 @@ namespace North::Graphics {
         bufferInfo.usage = GetVulkanUsageFlags(type);
 
         // For staging buffers, we need TRANSFER_SRC (source for copies)
-        // For GPU buffers, we need TRANSFER_DST (destination for copies)
+        // For GPU buffers, we need TRANSFER_DST (destination for copies), and TRANSFER_SRC so the defragmenter
+        // can copy them somewhere else
         if (type == Type::Staging) {
             bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         } else if (usage == MemoryUsage::GPU_Only) {
-            bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
         }
+        mUsageFlags = bufferInfo.usage;
 
         // EXCLUSIVE means only one queue family will use this buffer
         // If you need multiple queues (graphics + transfer), use CONCURRENT
@@ -79,6 +95,9 @@ namespace North::Graphics {
         // This means we can map once and keep it mapped
         if (usage == MemoryUsage::CPU_To_GPU || usage == MemoryUsage::CPU_Only) {
             allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+        } else if (usage == MemoryUsage::GPU_To_CPU) {
+            // Readback memory is read by the CPU in arbitrary order, so ask for cached memory
+            allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
         }
 
         // Step 3: Create the buffer and allocate memory in one call
@@ -101,6 +120,11 @@ namespace North::Graphics {
 
         // If we requested persistent mapping, store the pointer
         if (allocationInfo.pMappedData != nullptr) { mMappedData = allocationInfo.pMappedData; }
+
+        // Named so VMA's JSON dump (and a leak report built from it) says what each allocation is
+        vmaSetAllocationName(mAllocator, mAllocation, GetTypeName(mType));
+        sLiveCounts[CAST<u32>(mType)]++;
+        sLiveBytes[CAST<u32>(mType)] += mSize;
     }
 
     void Buffer::Upload(const void* data, VkDeviceSize size, VkDeviceSize offset) {
@@ -137,6 +161,32 @@ namespace North::Graphics {
         }
     }
 
+    void Buffer::Download(void* data, VkDeviceSize size, VkDeviceSize offset) {
+        if (!IsValid()) {
+            std::cerr << "Cannot download from invalid buffer!" << std::endl;
+            return;
+        }
+
+        if (mMemoryUsage == MemoryUsage::GPU_Only) {
+            std::cerr << "Cannot directly download from GPU_Only buffer! Copy into a readback buffer first."
+                      << std::endl;
+            return;
+        }
+
+        if (offset + size > mSize) {
+            std::cerr << "Download size exceeds buffer bounds!" << std::endl;
+            return;
+        }
+
+        void* mappedData = Map();
+        if (mappedData) {
+            // Make GPU writes visible to the CPU (needed for non-coherent memory)
+            vmaInvalidateAllocation(mAllocator, mAllocation, offset, size);
+            memcpy(data, CAST<const u8*>(mappedData) + offset, size);
+            Unmap();
+        }
+    }
+
     void Buffer::CopyFrom(
       VkCommandBuffer cmd, const Buffer& srcBuffer, VkDeviceSize size, VkDeviceSize srcOffset, VkDeviceSize dstOffset) {
         if (!IsValid() || !srcBuffer.IsValid()) {
@@ -197,6 +247,13 @@ namespace North::Graphics {
         }
     }
 
+    void Buffer::Flush(VkDeviceSize offset, VkDeviceSize size) {
+        if (!IsValid() || mMemoryUsage == MemoryUsage::GPU_Only) { return; }
+
+        // VMA rounds the range out to nonCoherentAtomSize and skips coherent memory
+        vmaFlushAllocation(mAllocator, mAllocation, offset, size);
+    }
+
     void Buffer::Destroy() {
         if (mBuffer != VK_NULL_HANDLE && mAllocator != nullptr) {
             // If we have a non-persistent mapping active, unmap it first
@@ -206,11 +263,117 @@ namespace North::Graphics {
 
             // VMA destroys both the buffer and frees the memory in one call
             vmaDestroyBuffer(mAllocator, mBuffer, mAllocation);
+            ReleaseLiveStats();
 
             mBuffer     = VK_NULL_HANDLE;
             mAllocation = VK_NULL_HANDLE;
             mMappedData = nullptr;
         }
+        mRelocatable = false;
+        mOnRelocated = nullptr;
+    }
+
+    void Buffer::Retire(DeletionQueue& deletionQueue) {
+        if (mBuffer == VK_NULL_HANDLE) return;
+
+        // Nothing should move the allocation while it waits to be freed
+        if (mRelocatable) { UpdateRelocationTarget(false); }
+        mOnRelocated = nullptr;
+
+        // Persistent mappings are released by VMA along with the allocation
+        deletionQueue.RetireBuffer(mBuffer, mAllocation);
+        ReleaseLiveStats();
+
+        mBuffer     = VK_NULL_HANDLE;
+        mAllocation = VK_NULL_HANDLE;
+        mMappedData = nullptr;
+    }
+
+    void Buffer::SetRelocatable(std::function<void()> onRelocated) {
+        if (!IsValid()) return;
+
+        // Mapped pointers would go stale, and nothing needs to move the small host-visible buffers anyway
+        if (mMemoryUsage != MemoryUsage::GPU_Only) {
+            std::cerr << "Only GPU_Only buffers can be relocated!" << std::endl;
+            return;
+        }
+
+        mOnRelocated = std::move(onRelocated);
+        UpdateRelocationTarget(true);
+    }
+
+    bool Buffer::Relocate(VkCommandBuffer cmd, VmaAllocation allocation, DeletionQueue& deletionQueue) {
+        if (!IsValid() || !mRelocatable) return false;
+
+        VmaAllocatorInfo allocatorInfo {};
+        vmaGetAllocatorInfo(mAllocator, &allocatorInfo);
+
+        VkBufferCreateInfo bufferInfo {};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size        = mSize;
+        bufferInfo.usage       = mUsageFlags;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VkBuffer buffer = VK_NULL_HANDLE;
+        if (vkCreateBuffer(allocatorInfo.device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) return false;
+        if (vmaBindBufferMemory(mAllocator, allocation, buffer) != VK_SUCCESS) {
+            vkDestroyBuffer(allocatorInfo.device, buffer, nullptr);
+            return false;
+        }
+
+        VkBufferCopy copyRegion {};
+        copyRegion.size = mSize;
+        vkCmdCopyBuffer(cmd, mBuffer, buffer, 1, &copyRegion);
+
+        // Only the handle goes, the memory under it belongs to the allocation VMA is moving
+        deletionQueue.Retire([oldBuffer = mBuffer](VkDevice device, VmaAllocator) {
+            vkDestroyBuffer(device, oldBuffer, nullptr);
+        });
+        mBuffer = buffer;
+
+        if (mOnRelocated) { mOnRelocated(); }
+        return true;
+    }
+
+    Buffer::LiveStats Buffer::GetLiveStats(Type type) {
+        LiveStats stats;
+        stats.count = sLiveCounts[CAST<u32>(type)];
+        stats.bytes = sLiveBytes[CAST<u32>(type)];
+        return stats;
+    }
+
+    const char* Buffer::GetTypeName(Type type) {
+        switch (type) {
+            case Type::Vertex:
+                return "Vertex buffer";
+            case Type::Index:
+                return "Index buffer";
+            case Type::Uniform:
+                return "Uniform buffer";
+            case Type::Storage:
+                return "Storage buffer";
+            case Type::Staging:
+                return "Staging buffer";
+            case Type::Readback:
+                return "Readback buffer";
+            case Type::Indirect:
+                return "Indirect buffer";
+            default:
+                return "Buffer";
+        }
+    }
+
+    void Buffer::ReleaseLiveStats() {
+        sLiveCounts[CAST<u32>(mType)]--;
+        sLiveBytes[CAST<u32>(mType)] -= mSize;
+    }
+
+    void Buffer::UpdateRelocationTarget(bool relocatable) {
+        mRelocatable = relocatable;
+        if (mAllocation == VK_NULL_HANDLE) return;
+
+        IRelocatable* target = relocatable ? this : nullptr;
+        vmaSetAllocationUserData(mAllocator, mAllocation, target);
     }
 
     VkBufferUsageFlags Buffer::GetVulkanUsageFlags(Type type) {
@@ -236,6 +399,14 @@ namespace North::Graphics {
                 // Staging buffer is just a transfer source (we'll copy FROM it)
                 return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 
+            case Type::Readback:
+                // Readback buffer is just a transfer destination (we'll copy INTO it)
+                return VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+            case Type::Indirect:
+                // Written as a storage buffer (GPU culling), then read as draw arguments
+                return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
             default:
                 return 0;
         }
@@ -5,10 +5,16 @@
 #pragma once
 
 #include "Common/Common.hpp"
+#include "DeletionQueue.hpp"
+#include "Relocatable.hpp"
 
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
 
+#include <array>
+#include <atomic>
+#include <functional>
+
 namespace North::Graphics {
     /**
      * @brief Wrapper around VkBuffer that handles memory allocation via VMA
@@ -23,7 +29,7 @@ namespace North::Graphics {
      * VMA (Vulkan Memory Allocator) handles the complex memory allocation for us,
      * so we don't have to manually manage VkDeviceMemory.
      */
-    class Buffer {
+    class Buffer final : public IRelocatable {
     public:
         /**
          * @brief Types of buffers we can create
@@ -34,8 +40,17 @@ namespace North::Graphics {
          * - Uniform: Stores shader constants (updated frequently from CPU)
          * - Storage: Large buffers for compute shaders (read/write)
          * - Staging: Temporary CPU-visible buffer for uploading to GPU
+         * - Readback: CPU-visible destination for GPU copies (screenshots, query results)
+         * - Indirect: Draw arguments written by compute shaders and consumed by indirect draws
          */
-        enum class Type { Vertex, Index, Uniform, Storage, Staging };
+        enum class Type { Vertex, Index, Uniform, Storage, Staging, Readback, Indirect };
+        static constexpr u32 kTypeCount = 7;
+
+        /// @brief Buffers of one type that were created and not destroyed or retired yet
+        struct LiveStats {
+            u32 count          = 0;
+            VkDeviceSize bytes = 0;
+        };
 
         /**
          * @brief How the buffer memory should be allocated
@@ -53,7 +68,7 @@ namespace North::Graphics {
         };
 
         Buffer() = default;
-        ~Buffer();
+        ~Buffer() override;
 
         // Prevent copying (buffers own GPU memory)
         NE_CLASS_PREVENT_COPIES(Buffer)
@@ -93,6 +108,19 @@ namespace North::Graphics {
          */
         void Upload(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
 
+        /**
+         * @brief Read data back from the buffer
+         *
+         * The counterpart of Upload() for GPU_To_CPU buffers. Invalidates the range first so writes
+         * made by the GPU are visible. The caller is responsible for making sure the GPU has finished
+         * writing (e.g. the frame that recorded the copy has completed).
+         *
+         * @param data Destination pointer
+         * @param size Size of data in bytes
+         * @param offset Offset into buffer to start reading
+         */
+        void Download(void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+
         /**
          * @brief Copy data from another buffer (GPU-side copy)
          *
@@ -147,6 +175,18 @@ namespace North::Graphics {
          */
         void Unmap();
 
+        /**
+         * @brief Make host writes to a persistently mapped range visible to the GPU
+         *
+         * Unmap() does nothing for persistent mappings, and CPU_To_GPU memory isn't guaranteed to be
+         * HOST_COHERENT. Call this after writing through Map() and before the submit that reads the range.
+         * Free on coherent memory.
+         *
+         * @param offset Offset into buffer of the first written byte
+         * @param size Size of the written range in bytes, VK_WHOLE_SIZE for the rest of the buffer
+         */
+        void Flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
         /**
          * @brief Destroy the buffer and free its memory
          *
@@ -155,6 +195,27 @@ namespace North::Graphics {
          */
         void Destroy();
 
+        /**
+         * @brief Destroy the buffer once the GPU is done with it
+         *
+         * Hands the buffer over to the deletion queue, which frees it after every frame that may still
+         * read it has completed. Use this instead of Destroy() for buffers that in-flight frames reference,
+         * it never waits on the GPU. The Buffer object is left empty and can be Create()d again right away.
+         */
+        void Retire(DeletionQueue& deletionQueue);
+
+        /**
+         * @brief Let the Defragmenter move the buffer to another place in memory
+         *
+         * The handle changes when it's moved. Anything that keeps GetHandle() around instead of asking for it
+         * every frame (a descriptor set written once) has to be updated in `onRelocated`, which runs right after
+         * the switch. Only GPU_Only buffers can be moved, and while frames are in flight they have to be
+         * Retire()d rather than Destroy()ed. Create() again makes the buffer non-relocatable.
+         */
+        void SetRelocatable(std::function<void()> onRelocated = nullptr);
+
+        bool Relocate(VkCommandBuffer cmd, VmaAllocation allocation, DeletionQueue& deletionQueue) override;
+
         // Getters
         NE_ND VkBuffer GetHandle() const {
             return mBuffer;
@@ -171,15 +232,36 @@ namespace North::Graphics {
         NE_ND bool IsMapped() const {
             return mMappedData != nullptr;
         }
+        NE_ND bool IsRelocatable() const {
+            return mRelocatable;
+        }
+
+        /// @brief Totals across every Buffer in the process, safe to read from any thread
+        static LiveStats GetLiveStats(Type type);
+
+        /// @brief Allocation name shown in VMA's stats dump, e.g. "Vertex buffer"
+        static const char* GetTypeName(Type type);
 
     private:
-        VmaAllocator mAllocator   = nullptr;
-        VkBuffer mBuffer          = VK_NULL_HANDLE;
-        VmaAllocation mAllocation = VK_NULL_HANDLE;
-        VkDeviceSize mSize        = 0;
-        Type mType                = Type::Vertex;
-        MemoryUsage mMemoryUsage  = MemoryUsage::GPU_Only;
-        void* mMappedData         = nullptr;
+        VmaAllocator mAllocator        = nullptr;
+        VkBuffer mBuffer               = VK_NULL_HANDLE;
+        VmaAllocation mAllocation      = VK_NULL_HANDLE;
+        VkDeviceSize mSize             = 0;
+        Type mType                     = Type::Vertex;
+        MemoryUsage mMemoryUsage       = MemoryUsage::GPU_Only;
+        VkBufferUsageFlags mUsageFlags = 0;
+        void* mMappedData              = nullptr;
+        bool mRelocatable              = false;
+        std::function<void()> mOnRelocated;
+
+        static inline std::array<std::atomic<u32>, kTypeCount> sLiveCounts {};
+        static inline std::array<std::atomic<u64>, kTypeCount> sLiveBytes {};
+
+        // Take this buffer out of the live totals, its allocation is about to be freed or handed off
+        void ReleaseLiveStats();
+
+        // Point the allocation's user data back at this object (or at nothing), for the defragmenter
+        void UpdateRelocationTarget(bool relocatable);
 
         // Helper to convert our enum to VkBufferUsageFlags
         static VkBufferUsageFlags GetVulkanUsageFlags(Type type);
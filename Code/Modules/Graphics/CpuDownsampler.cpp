@@ -0,0 +1,109 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "CpuDownsampler.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define NE_DOWNSAMPLE_SSE2
+#endif
+
+namespace North::Graphics {
+    namespace {
+        constexpr u32 kBytesPerTexel = 4;
+
+        /// Rounded average of four texels, one channel at a time
+        void AverageTexel(const u8* a, const u8* b, const u8* c, const u8* d, u8* out) {
+            for (u32 channel = 0; channel < kBytesPerTexel; channel++) {
+                out[channel] = CAST<u8>((a[channel] + b[channel] + c[channel] + d[channel] + 2) >> 2);
+            }
+        }
+
+        /// Filters `count` output texels starting at `x` from two source rows, returns the first one not written
+        u32 DownsampleRowScalar(const u8* row0, const u8* row1, u32 width, u32 x, u32 count, u8* dst) {
+            for (; x < count; x++) {
+                const u32 left  = 2 * x;
+                const u32 right = NE_MIN(left + 1, width - 1);
+                AverageTexel(row0 + left * kBytesPerTexel,
+                             row0 + right * kBytesPerTexel,
+                             row1 + left * kBytesPerTexel,
+                             row1 + right * kBytesPerTexel,
+                             dst + x * kBytesPerTexel);
+            }
+            return x;
+        }
+
+#ifdef NE_DOWNSAMPLE_SSE2
+        /// Two output texels per iteration: 4 texels from each row widened to 16 bits, summed vertically, then
+        /// horizontally by folding the upper half of each pair onto the lower one
+        u32 DownsampleRowSse2(const u8* row0, const u8* row1, u32 count, u8* dst) {
+            const __m128i zero  = _mm_setzero_si128();
+            const __m128i round = _mm_set1_epi16(2);
+
+            u32 x = 0;
+            for (; x + 2 <= count; x += 2) {
+                const __m128i top    = _mm_loadu_si128(RCAST<const __m128i*>(row0 + x * 2 * kBytesPerTexel));
+                const __m128i bottom = _mm_loadu_si128(RCAST<const __m128i*>(row1 + x * 2 * kBytesPerTexel));
+
+                // Texels 0-1 and 2-3 of both rows, each channel summed vertically
+                const __m128i low  = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+                const __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+                // Fold texel 1 onto 0 and 3 onto 2, then pack both sums into one register
+                const __m128i first  = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+                const __m128i second = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+                __m128i sum          = _mm_unpacklo_epi64(first, second);
+
+                sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+                _mm_storel_epi64(RCAST<__m128i*>(dst + x * kBytesPerTexel), _mm_packus_epi16(sum, zero));
+            }
+            return x;
+        }
+#endif
+    }  // namespace
+
+    vector<MipLevel> CpuDownsampler::GenerateRgba8(const u8* texels, u32 width, u32 height) {
+        vector<MipLevel> levels;
+        if (width == 0 || height == 0) return levels;
+
+        MipLevel base;
+        base.width  = width;
+        base.height = height;
+        base.texels.assign(texels, texels + CAST<size_t>(width) * height * kBytesPerTexel);
+        levels.push_back(std::move(base));
+
+        while (levels.back().width > 1 || levels.back().height > 1) {
+            const MipLevel& source = levels.back();
+
+            MipLevel level;
+            level.width  = NE_MAX(source.width / 2, 1u);
+            level.height = NE_MAX(source.height / 2, 1u);
+            level.texels.resize(CAST<size_t>(level.width) * level.height * kBytesPerTexel);
+            DownsampleRgba8(source.texels.data(), source.width, source.height, level.texels.data());
+
+            levels.push_back(std::move(level));
+        }
+
+        return levels;
+    }
+
+    void CpuDownsampler::DownsampleRgba8(const u8* src, u32 width, u32 height, u8* dst) {
+        const u32 dstWidth  = NE_MAX(width / 2, 1u);
+        const u32 dstHeight = NE_MAX(height / 2, 1u);
+        const size_t stride = CAST<size_t>(width) * kBytesPerTexel;
+
+        for (u32 y = 0; y < dstHeight; y++) {
+            const u8* row0 = src + CAST<size_t>(2 * y) * stride;
+            const u8* row1 = src + CAST<size_t>(NE_MIN(2 * y + 1, height - 1)) * stride;
+            u8* out        = dst + CAST<size_t>(y) * dstWidth * kBytesPerTexel;
+
+            u32 x = 0;
+#ifdef NE_DOWNSAMPLE_SSE2
+            // A 1 texel wide source has no right neighbour to load, leave it to the scalar loop
+            if (width > 1) { x = DownsampleRowSse2(row0, row1, dstWidth, out); }
+#endif
+            DownsampleRowScalar(row0, row1, width, x, dstWidth, out);
+        }
+    }
+}  // namespace North::Graphics
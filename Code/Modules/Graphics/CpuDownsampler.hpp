@@ -0,0 +1,34 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+namespace North::Graphics {
+    struct MipLevel {
+        u32 width  = 0;
+        u32 height = 0;
+        vector<u8> texels;  // Tightly packed RGBA8
+    };
+
+    /**
+     * @brief Mip chain generation on the CPU, for offline cooking and devices without the compute path
+     *
+     * Same 2x2 box filter as Downsample.comp: every level is floor(size / 2) of the previous one, and reads past
+     * the edge of a 1 texel wide or tall level repeat the edge. Texels are filtered as linear values, sRGB data
+     * has to be converted first to be filtered correctly.
+     *
+     * Rows are filtered with SSE2 on x86-64 (two output texels per iteration), other platforms use the scalar
+     * loop. Both produce identical results.
+     */
+    class CpuDownsampler {
+    public:
+        /// @brief Every level down to 1x1, [0] is a copy of the source
+        static vector<MipLevel> GenerateRgba8(const u8* texels, u32 width, u32 height);
+
+        /// @brief One level, `dst` must hold max(width / 2, 1) x max(height / 2, 1) texels
+        static void DownsampleRgba8(const u8* src, u32 width, u32 height, u8* dst);
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,412 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "CpuOcclusionCuller.hpp"
+#include "Common/Clock.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(NE_ENABLE_AVX2) && defined(__AVX2__)
+    #include <immintrin.h>
+    #define NE_OCCLUSION_AVX2
+#endif
+
+namespace North::Graphics {
+    namespace {
+        constexpr u32 kFullRow = ~0u;
+
+        /// Pixels from `first` up to `end` of a tile row, both relative to the tile's left edge. A u32 can't be
+        /// shifted by 32, hence the checks.
+        u32 RowMask(i32 first, i32 end) {
+            first               = NE_MAX(first, 0);
+            end                 = NE_MAX(end, 0);
+            const u32 fromFirst = first >= 32 ? 0 : kFullRow >> first;
+            const u32 fromEnd   = end >= 32 ? 0 : kFullRow >> end;
+            return fromFirst & ~fromEnd;
+        }
+
+        /// Clips a triangle to the near plane (z >= 0 in clip space), a quad at most comes out
+        u32 ClipNear(const Vec4* in, Vec4* out) {
+            u32 count = 0;
+            for (u32 i = 0; i < 3; i++) {
+                const Vec4& a = in[i];
+                const Vec4& b = in[(i + 1) % 3];
+                if (a.z >= 0) { out[count++] = a; }
+                if ((a.z >= 0) != (b.z >= 0)) { out[count++] = a + (b - a) * (a.z / (a.z - b.z)); }
+            }
+            return count;
+        }
+
+        /// Every vertex on the outer side of one frustum plane
+        bool OutsideFrustum(const Vec4* clip) {
+            const auto all = [clip](auto outside) {
+                return outside(clip[0]) && outside(clip[1]) && outside(clip[2]);
+            };
+            return all([](const Vec4& v) { return v.x < -v.w; }) || all([](const Vec4& v) { return v.x > v.w; }) ||
+                   all([](const Vec4& v) { return v.y < -v.w; }) || all([](const Vec4& v) { return v.y > v.w; }) ||
+                   all([](const Vec4& v) { return v.z > v.w; });
+        }
+    }  // namespace
+
+    void CpuOcclusionCuller::Resize(u32 width, u32 height) {
+        mWidth  = width;
+        mHeight = height;
+        mTilesX = (width + kTileWidth - 1) / kTileWidth;
+        mTilesY = (height + kTileHeight - 1) / kTileHeight;
+        mTiles.resize(CAST<size_t>(mTilesX) * mTilesY);
+        ClearTiles();
+    }
+
+    void CpuOcclusionCuller::BeginFrame(const Mat4x4& viewProjection) {
+        mViewProjection = viewProjection;
+        mOccluders.clear();
+        mStats = {};
+        ClearTiles();
+    }
+
+    void CpuOcclusionCuller::AddOccluder(const Occluder& occluder) {
+        if (occluder.positions == nullptr || occluder.indices == nullptr || occluder.triangleCount == 0) return;
+        mOccluders.push_back(occluder);
+    }
+
+    void CpuOcclusionCuller::RenderOccluders(ThreadPool& threadPool) {
+        if (mTiles.empty()) return;
+        const f64 start = Clock::Now();
+
+        // Transformed, clipped and culled per occluder
+        const u32 occluderCount = CAST<u32>(mOccluders.size());
+        mTriangles.resize(occluderCount);
+        threadPool.ParallelFor(occluderCount, [this](u32 i) { SetupTriangles(mOccluders[i], mTriangles[i]); });
+
+        for (const auto& triangles : mTriangles) {
+            mStats.triangles += CAST<u32>(triangles.size());
+        }
+
+        // A band of tile rows per task, each owns its tiles so there's nothing to lock. Every band sees the
+        // triangles in the same order, which keeps the result independent of the thread count. More bands than
+        // threads so a band full of occluders doesn't hold everything up.
+        const u32 bandCount   = NE_MIN(mTilesY, (threadPool.GetThreadCount() + 1) * 4);
+        const u32 rowsPerBand = (mTilesY + bandCount - 1) / bandCount;
+        threadPool.ParallelFor(bandCount, [this, rowsPerBand](u32 band) {
+            const u32 firstTileRow = band * rowsPerBand;
+            const u32 endTileRow   = NE_MIN(firstTileRow + rowsPerBand, mTilesY);
+            for (const auto& triangles : mTriangles) {
+                for (const ScreenTriangle& triangle : triangles) {
+                    RasterizeTriangle(triangle, firstTileRow, endTileRow);
+                }
+            }
+        });
+
+        mStats.renderMs += (Clock::Now() - start) * 1000.0;
+    }
+
+    void CpuOcclusionCuller::ClearTiles() {
+        for (Tile& tile : mTiles) {
+            std::fill_n(tile.mask, kTileHeight, 0u);
+            tile.zMax0 = 1.0f;
+            tile.zMax1 = 0.0f;
+        }
+    }
+
+    void CpuOcclusionCuller::SetupTriangles(const Occluder& occluder, vector<ScreenTriangle>& triangles) const {
+        triangles.clear();
+
+        const Mat4x4 modelViewProjection = mViewProjection * occluder.modelMatrix;
+        const f32 width                  = CAST<f32>(mWidth);
+        const f32 height                 = CAST<f32>(mHeight);
+
+        for (u32 t = 0; t < occluder.triangleCount; t++) {
+            Vec4 clip[3];
+            for (u32 i = 0; i < 3; i++) {
+                clip[i] = modelViewProjection * Vec4(occluder.positions[occluder.indices[t * 3 + i]], 1.0f);
+            }
+            if (OutsideFrustum(clip)) continue;
+
+            // Only the near plane needs clipping, the rest is handled by clamping spans to the buffer
+            Vec4 polygon[4];
+            const u32 vertexCount = ClipNear(clip, polygon);
+            if (vertexCount < 3) continue;
+
+            Vec3 screen[4];
+            bool behindCamera = false;
+            for (u32 i = 0; i < vertexCount; i++) {
+                if (polygon[i].w <= 0) {
+                    behindCamera = true;
+                    break;
+                }
+                const f32 invW = 1.0f / polygon[i].w;
+                screen[i]      = Vec3((polygon[i].x * invW * 0.5f + 0.5f) * width,
+                                 (polygon[i].y * invW * 0.5f + 0.5f) * height,
+                                 polygon[i].z * invW);
+            }
+            if (behindCamera) continue;
+
+            for (u32 i = 1; i + 1 < vertexCount; i++) {
+                ScreenTriangle triangle {{screen[0], screen[i], screen[i + 1]}};
+                Vec3* v = triangle.v;
+
+                // Vulkan's facing rule in framebuffer space (y down): counter-clockwise front faces have a
+                // negative cross product here. Zero area covers nothing.
+                const f32 area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+                if (area >= 0) continue;
+
+                if (v[1].y < v[0].y) { std::swap(v[0], v[1]); }
+                if (v[2].y < v[1].y) { std::swap(v[1], v[2]); }
+                if (v[1].y < v[0].y) { std::swap(v[0], v[1]); }
+                triangles.push_back(triangle);
+            }
+        }
+    }
+
+    void CpuOcclusionCuller::RasterizeTriangle(const ScreenTriangle& triangle, u32 firstTileRow, u32 endTileRow) {
+        const Vec3& v0 = triangle.v[0];
+        const Vec3& v1 = triangle.v[1];
+        const Vec3& v2 = triangle.v[2];
+
+        const f32 width      = CAST<f32>(mWidth);
+        const f32 bandTop    = CAST<f32>(firstTileRow * kTileHeight);
+        const f32 bandBottom = CAST<f32>(NE_MIN(endTileRow * kTileHeight, mHeight));
+        const f32 minX       = NE_MIN(NE_MIN(v0.x, v1.x), v2.x);
+        const f32 maxX       = NE_MAX(NE_MAX(v0.x, v1.x), v2.x);
+        if (v2.y <= bandTop || v0.y >= bandBottom || maxX <= 0 || minX >= width) return;
+
+        const f32 bottom   = NE_MIN(v2.y, bandBottom);  // Rows from here on belong to another band
+        const f32 maxDepth = NE_MAX(NE_MAX(v0.z, v1.z), v2.z);
+
+        // Tiles the triangle's bounding box touches inside the band
+        const u32 tileRowBegin = CAST<u32>(NE_MAX(v0.y, bandTop)) / kTileHeight;
+        const u32 tileRowEnd   = CAST<u32>(std::ceil(bottom) + kTileHeight - 1) / kTileHeight;
+        const u32 tileColBegin = CAST<u32>(NE_MAX(minX, 0.0f)) / kTileWidth;
+        const u32 tileColEnd   = CAST<u32>(std::ceil(NE_MIN(maxX, width)) + kTileWidth - 1) / kTileWidth;
+
+        // Row spans run between the long edge v0-v2 on one side and v0-v1, then v1-v2, on the other
+        const f32 longSlope     = (v2.x - v0.x) / (v2.y - v0.y);
+        const f32 topSlope      = v1.y > v0.y ? (v1.x - v0.x) / (v1.y - v0.y) : 0.0f;
+        const f32 bottomSlope   = v2.y > v1.y ? (v2.x - v1.x) / (v2.y - v1.y) : 0.0f;
+        const bool shortOnRight = v1.x > v0.x + (v1.y - v0.y) * longSlope;
+
+        // Depth is linear in screen space, so its farthest point over a tile is at one of the tile's corners
+        const f32 e1x         = v1.x - v0.x;
+        const f32 e1y         = v1.y - v0.y;
+        const f32 e2x         = v2.x - v0.x;
+        const f32 e2y         = v2.y - v0.y;
+        const f32 determinant = e1x * e2y - e2x * e1y;
+        const f32 dzdx        = ((v1.z - v0.z) * e2y - (v2.z - v0.z) * e1y) / determinant;
+        const f32 dzdy        = ((v2.z - v0.z) * e1x - (v1.z - v0.z) * e2x) / determinant;
+        const f32 cornerX     = dzdx > 0 ? CAST<f32>(kTileWidth) : 0.0f;
+        const f32 cornerY     = dzdy > 0 ? CAST<f32>(kTileHeight) : 0.0f;
+
+#ifdef NE_OCCLUSION_AVX2
+        const __m256 rowOffsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+        const __m256i fullRows  = _mm256_set1_epi32(-1);
+        const __m256i zero      = _mm256_setzero_si256();
+#endif
+
+        for (u32 ty = tileRowBegin; ty < tileRowEnd; ty++) {
+            // First and one past the last pixel of every row whose center is inside, an empty span otherwise
+#ifdef NE_OCCLUSION_AVX2
+            const __m256 y = _mm256_add_ps(_mm256_set1_ps(CAST<f32>(ty * kTileHeight)), rowOffsets);
+
+            const auto edgeX = [&y](f32 x, f32 edgeY, f32 slope) {
+                const __m256 dy = _mm256_sub_ps(y, _mm256_set1_ps(edgeY));
+                return _mm256_add_ps(_mm256_set1_ps(x), _mm256_mul_ps(dy, _mm256_set1_ps(slope)));
+            };
+            const auto toPixel = [width](__m256 x) {
+                x = _mm256_ceil_ps(_mm256_sub_ps(x, _mm256_set1_ps(0.5f)));
+                x = _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()), _mm256_set1_ps(width));
+                return _mm256_cvttps_epi32(x);
+            };
+
+            const __m256 longX  = edgeX(v0.x, v0.y, longSlope);
+            const __m256 above  = _mm256_cmp_ps(y, _mm256_set1_ps(v1.y), _CMP_LT_OQ);
+            const __m256 shortX = _mm256_blendv_ps(edgeX(v1.x, v1.y, bottomSlope), edgeX(v0.x, v0.y, topSlope), above);
+            const __m256 inside = _mm256_and_ps(_mm256_cmp_ps(y, _mm256_set1_ps(v0.y), _CMP_GE_OQ),
+                                                _mm256_cmp_ps(y, _mm256_set1_ps(bottom), _CMP_LT_OQ));
+
+            const __m256i first =
+              _mm256_and_si256(toPixel(shortOnRight ? longX : shortX), _mm256_castps_si256(inside));
+            const __m256i end =
+              _mm256_and_si256(toPixel(shortOnRight ? shortX : longX), _mm256_castps_si256(inside));
+#else
+            i32 first[kTileHeight];
+            i32 end[kTileHeight];
+            for (u32 row = 0; row < kTileHeight; row++) {
+                const f32 y = CAST<f32>(ty * kTileHeight + row) + 0.5f;
+                if (y < v0.y || y >= bottom) {
+                    first[row] = 0;
+                    end[row]   = 0;
+                    continue;
+                }
+
+                const f32 longX  = v0.x + (y - v0.y) * longSlope;
+                const f32 shortX = y < v1.y ? v0.x + (y - v0.y) * topSlope : v1.x + (y - v1.y) * bottomSlope;
+                const f32 left   = shortOnRight ? longX : shortX;
+                const f32 right  = shortOnRight ? shortX : longX;
+                first[row]       = CAST<i32>(NE_MIN(NE_MAX(std::ceil(left - 0.5f), 0.0f), width));
+                end[row]         = CAST<i32>(NE_MIN(NE_MAX(std::ceil(right - 0.5f), 0.0f), width));
+            }
+#endif
+
+            for (u32 tx = tileColBegin; tx < tileColEnd; tx++) {
+                Tile& tile = mTiles[ty * mTilesX + tx];
+
+                // Farthest the triangle gets in the tile. Nothing to gain if the tile already has that.
+                const f32 tileX = CAST<f32>(tx * kTileWidth);
+                const f32 tileY = CAST<f32>(ty * kTileHeight);
+                const f32 depth =
+                  NE_MIN(v0.z + dzdx * (tileX + cornerX - v0.x) + dzdy * (tileY + cornerY - v0.y), maxDepth);
+                if (depth >= tile.zMax0) continue;
+
+#ifdef NE_OCCLUSION_AVX2
+                // A lane per row, bits from the span's first pixel on, minus the bits from its end on
+                const __m256i offset   = _mm256_set1_epi32(CAST<i32>(tx * kTileWidth));
+                const __m256i shiftIn  = _mm256_max_epi32(_mm256_sub_epi32(first, offset), zero);
+                const __m256i shiftOut = _mm256_max_epi32(_mm256_sub_epi32(end, offset), zero);
+                const __m256i coverage =
+                  _mm256_andnot_si256(_mm256_srlv_epi32(fullRows, shiftOut), _mm256_srlv_epi32(fullRows, shiftIn));
+                if (_mm256_testz_si256(coverage, coverage)) continue;
+
+                // Start the working layer over when the triangle covers the tile by itself, or lies further in
+                // front of the layer than the layer lies in front of the tile. Merge into it otherwise.
+                __m256i mask = _mm256_load_si256(RCAST<const __m256i*>(tile.mask));
+                if (_mm256_testc_si256(coverage, fullRows) || tile.zMax1 - depth > tile.zMax0 - tile.zMax1) {
+                    mask       = coverage;
+                    tile.zMax1 = depth;
+                } else {
+                    mask       = _mm256_or_si256(mask, coverage);
+                    tile.zMax1 = NE_MAX(tile.zMax1, depth);
+                }
+
+                // Covers the whole tile, fold it in
+                if (_mm256_testc_si256(mask, fullRows)) {
+                    tile.zMax0 = tile.zMax1;
+                    tile.zMax1 = 0.0f;
+                    mask       = zero;
+                }
+                _mm256_store_si256(RCAST<__m256i*>(tile.mask), mask);
+#else
+                const i32 offset = CAST<i32>(tx * kTileWidth);
+                u32 coverage[kTileHeight];
+                u32 covered      = 0;
+                u32 coveredFully = kFullRow;
+                for (u32 row = 0; row < kTileHeight; row++) {
+                    coverage[row] = RowMask(first[row] - offset, end[row] - offset);
+                    covered |= coverage[row];
+                    coveredFully &= coverage[row];
+                }
+                if (covered == 0) continue;
+
+                // Start the working layer over when the triangle covers the tile by itself, or lies further in
+                // front of the layer than the layer lies in front of the tile. Merge into it otherwise.
+                const bool restart = coveredFully == kFullRow || tile.zMax1 - depth > tile.zMax0 - tile.zMax1;
+                u32 full           = kFullRow;
+                for (u32 row = 0; row < kTileHeight; row++) {
+                    tile.mask[row] = restart ? coverage[row] : tile.mask[row] | coverage[row];
+                    full &= tile.mask[row];
+                }
+                tile.zMax1 = restart ? depth : NE_MAX(tile.zMax1, depth);
+
+                // Covers the whole tile, fold it in
+                if (full == kFullRow) {
+                    tile.zMax0 = tile.zMax1;
+                    tile.zMax1 = 0.0f;
+                    std::fill_n(tile.mask, kTileHeight, 0u);
+                }
+#endif
+            }
+        }
+    }
+
+    bool CpuOcclusionCuller::IsVisible(const OcclusionBounds& bounds) const {
+        if (mTiles.empty()) return true;
+
+        f32 minX    = 1.0f;
+        f32 minY    = 1.0f;
+        f32 maxX    = -1.0f;
+        f32 maxY    = -1.0f;
+        f32 nearest = 1.0f;
+        for (u32 i = 0; i < 8; i++) {
+            const Vec4 corner((i & 1) ? bounds.max.x : bounds.min.x,
+                              (i & 2) ? bounds.max.y : bounds.min.y,
+                              (i & 4) ? bounds.max.z : bounds.min.z,
+                              1.0f);
+            const Vec4 clip = mViewProjection * corner;
+
+            // Reaches past the near plane, nothing can be said about it
+            if (clip.z < 0 || clip.w <= 0) return true;
+
+            const f32 invW = 1.0f / clip.w;
+            minX           = NE_MIN(minX, clip.x * invW);
+            minY           = NE_MIN(minY, clip.y * invW);
+            maxX           = NE_MAX(maxX, clip.x * invW);
+            maxY           = NE_MAX(maxY, clip.y * invW);
+            nearest        = NE_MIN(nearest, clip.z * invW);
+        }
+        if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || nearest > 1.0f) return false;
+
+        // Every pixel the rectangle touches
+        const f32 width   = CAST<f32>(mWidth);
+        const f32 height  = CAST<f32>(mHeight);
+        const i32 xBegin  = CAST<i32>(NE_MAX(std::floor((minX * 0.5f + 0.5f) * width), 0.0f));
+        const i32 yBegin  = CAST<i32>(NE_MAX(std::floor((minY * 0.5f + 0.5f) * height), 0.0f));
+        const i32 xEnd    = CAST<i32>(NE_MIN(std::floor((maxX * 0.5f + 0.5f) * width) + 1.0f, width));
+        const i32 yEnd    = CAST<i32>(NE_MIN(std::floor((maxY * 0.5f + 0.5f) * height) + 1.0f, height));
+        const i32 tileW   = CAST<i32>(kTileWidth);
+        const i32 tileH   = CAST<i32>(kTileHeight);
+
+        for (i32 ty = yBegin / tileH; ty <= (yEnd - 1) / tileH; ty++) {
+            const i32 rowBegin = NE_MAX(yBegin - ty * tileH, 0);
+            const i32 rowEnd   = NE_MIN(yEnd - ty * tileH, tileH);
+
+            for (i32 tx = xBegin / tileW; tx <= (xEnd - 1) / tileW; tx++) {
+                const Tile& tile = mTiles[ty * mTilesX + tx];
+
+                // Behind every pixel of the tile, or in front of something in it
+                if (nearest > tile.zMax0) continue;
+                if (nearest <= tile.zMax1) return true;
+
+                // Between the two, hidden only where the working layer covers the whole rectangle
+                const u32 columns = RowMask(xBegin - tx * tileW, xEnd - tx * tileW);
+#ifdef NE_OCCLUSION_AVX2
+                const __m256i rows  = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+                const __m256i query = _mm256_and_si256(
+                  _mm256_set1_epi32(CAST<i32>(columns)),
+                  _mm256_andnot_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(rowBegin), rows),
+                                      _mm256_cmpgt_epi32(_mm256_set1_epi32(rowEnd), rows)));
+                const __m256i mask = _mm256_load_si256(RCAST<const __m256i*>(tile.mask));
+                if (!_mm256_testc_si256(mask, query)) return true;
+#else
+                for (i32 row = rowBegin; row < rowEnd; row++) {
+                    if ((columns & ~tile.mask[row]) != 0) return true;
+                }
+#endif
+            }
+        }
+
+        return false;
+    }
+
+    void CpuOcclusionCuller::TestBounds(ThreadPool& threadPool,
+                                        const OcclusionBounds* bounds,
+                                        u32 count,
+                                        u8* visible) {
+        const f64 start     = Clock::Now();
+        const u32 taskCount = (count + kBoundsPerTask - 1) / kBoundsPerTask;
+        threadPool.ParallelFor(taskCount, [this, bounds, count, visible](u32 task) {
+            const u32 end = NE_MIN((task + 1) * kBoundsPerTask, count);
+            for (u32 i = task * kBoundsPerTask; i < end; i++) {
+                visible[i] = IsVisible(bounds[i]) ? 1 : 0;
+            }
+        });
+
+        u32 occluded = 0;
+        for (u32 i = 0; i < count; i++) {
+            occluded += visible[i] == 0 ? 1 : 0;
+        }
+        mStats.tested += count;
+        mStats.occluded += occluded;
+        mStats.testMs += (Clock::Now() - start) * 1000.0;
+    }
+}  // namespace North::Graphics
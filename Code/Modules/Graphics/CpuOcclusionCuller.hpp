@@ -0,0 +1,128 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Common/ThreadPool.hpp"
+#include "Math/Constants.hpp"
+
+namespace North::Graphics {
+    /// @brief World space axis-aligned box, what occludees are tested with
+    struct OcclusionBounds {
+        Vec3 min {0, 0, 0};
+        Vec3 max {0, 0, 0};
+    };
+
+    /// @brief Low-poly stand-in for something that hides what's behind it (a wall's box, a building's hull). The
+    /// positions and indices are referenced, not copied, and have to stay alive until RenderOccluders() returns.
+    struct Occluder {
+        const Vec3* positions = nullptr;  // Model space
+        const u32* indices    = nullptr;
+        u32 triangleCount     = 0;
+        Mat4x4 modelMatrix    = Math::Constants::kIdentity4x4;
+    };
+
+    struct CpuOcclusionStats {
+        u32 triangles = 0;  // Rasterized, after clipping and back-face culling
+        u32 tested    = 0;
+        u32 occluded  = 0;
+        f64 renderMs  = 0;
+        f64 testMs    = 0;
+    };
+
+    /**
+     * @brief Masked software occlusion culling, for setups without the GPU-driven cull path
+     *
+     * Occluders are rasterized into a coarse depth buffer of 32x8 pixel tiles. Rather than a depth per pixel,
+     * every tile keeps a farthest depth for the whole tile, plus a working layer: a coverage bit per pixel and the
+     * farthest depth of the pixels it covers. Triangles merge into the working layer, which folds into the tile's
+     * depth once it covers every pixel, and starts over when a triangle lands far in front of it. A
+     * box is hidden when its nearest depth lies beyond the farthest depth of every pixel it covers.
+     *
+     * It's all CPU work, so the next frame can be culled while the GPU is still busy with the current one, before
+     * any DrawCommand is submitted:
+     *
+     *     culler.BeginFrame(viewProjection);
+     *     culler.AddOccluder(wall);
+     *     culler.RenderOccluders(threadPool);
+     *     culler.TestBounds(threadPool, bounds.data(), count, visible.data());
+     *
+     * Both steps are spread across the thread pool, rasterization in horizontal bands of tiles and tests in
+     * chunks of boxes. Built with NE_ENABLE_AVX2, the coverage of a triangle over a tile is one variable shift per
+     * span end across a 256-bit register, a 32 bit lane per pixel row. Otherwise the same masks are built a row at
+     * a time. Both give identical results.
+     *
+     * Depth goes from 0 (near) to 1 (far) like the GPU path. Occluders are sampled at pixel centers, so they never
+     * cover more than they should, and their back faces are skipped (counter-clockwise front faces, like the
+     * mesh pipeline).
+     */
+    class CpuOcclusionCuller {
+    public:
+        static constexpr u32 kTileWidth  = 32;  // A u32 coverage mask per row
+        static constexpr u32 kTileHeight = 8;   // Rows per tile, one per AVX2 lane
+
+        CpuOcclusionCuller() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(CpuOcclusionCuller)
+
+        /// @brief Size the depth buffer in pixels. Far below the screen resolution is fine, it only needs to be
+        /// fine enough for occluders to cover whole tiles.
+        void Resize(u32 width, u32 height);
+
+        /// @brief Clear the depth buffer and the occluder list for a new camera
+        void BeginFrame(const Mat4x4& viewProjection);
+
+        void AddOccluder(const Occluder& occluder);
+
+        /// @brief Rasterize every occluder added since BeginFrame(), returns once they're all in
+        void RenderOccluders(ThreadPool& threadPool);
+
+        /// @brief Bounds outside the view are reported hidden too. Safe from any thread after RenderOccluders().
+        NE_ND bool IsVisible(const OcclusionBounds& bounds) const;
+
+        /// @brief IsVisible() for `count` boxes across the thread pool, `visible[i]` is set to 1 or 0
+        void TestBounds(ThreadPool& threadPool, const OcclusionBounds* bounds, u32 count, u8* visible);
+
+        NE_ND const CpuOcclusionStats& GetStats() const {
+            return mStats;
+        }
+
+        NE_ND u32 GetWidth() const {
+            return mWidth;
+        }
+
+        NE_ND u32 GetHeight() const {
+            return mHeight;
+        }
+
+    private:
+        static constexpr u32 kBoundsPerTask = 256;
+
+        struct alignas(32) Tile {
+            u32 mask[kTileHeight];  // Working layer coverage, bit 31 is the leftmost pixel of the row
+            f32 zMax0;              // Farthest depth of every pixel in the tile
+            f32 zMax1;              // Farthest depth of the working layer's pixels
+        };
+
+        /// Pixel x and y, depth in z, sorted top to bottom
+        struct ScreenTriangle {
+            Vec3 v[3];
+        };
+
+        void ClearTiles();
+        void SetupTriangles(const Occluder& occluder, vector<ScreenTriangle>& triangles) const;
+        void RasterizeTriangle(const ScreenTriangle& triangle, u32 firstTileRow, u32 endTileRow);
+
+        u32 mWidth  = 0;
+        u32 mHeight = 0;
+        u32 mTilesX = 0;
+        u32 mTilesY = 0;
+        Mat4x4 mViewProjection {Math::Constants::kIdentity4x4};
+        vector<Tile> mTiles;
+        vector<Occluder> mOccluders;
+        vector<vector<ScreenTriangle>> mTriangles;  // Per occluder, kept around for their capacity
+        CpuOcclusionStats mStats;
+    };
+}  // namespace North::Graphics
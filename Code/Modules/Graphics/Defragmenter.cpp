@@ -0,0 +1,168 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "Defragmenter.hpp"
+#include "MemoryStats.hpp"
+
+#include <iostream>
+
+namespace North::Graphics {
+    bool Defragmenter::Initialize(VmaAllocator allocator, DeletionQueue& deletionQueue) {
+        mAllocator     = allocator;
+        mDeletionQueue = &deletionQueue;
+        mNextCheck     = kCheckInterval;
+        mStats         = {};
+        return true;
+    }
+
+    void Defragmenter::Shutdown() {
+        if (mContext != VK_NULL_HANDLE) {
+            // The device is idle, the copies of a pending pass have run
+            if (mPassPending) { EndPass(); }
+            if (mContext != VK_NULL_HANDLE) { Finish(); }
+        }
+
+        mAllocator     = VK_NULL_HANDLE;
+        mDeletionQueue = nullptr;
+    }
+
+    void Defragmenter::Start() {
+        if (!Initialized() || mContext != VK_NULL_HANDLE) return;
+
+        // Default pools only. Balanced trades a few more moves than the fast algorithm for much less waste.
+        VmaDefragmentationInfo info {};
+        info.flags                 = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+        info.maxBytesPerPass       = mMaxBytesPerPass;
+        info.maxAllocationsPerPass = mMaxAllocationsPerPass;
+
+        const VkResult result = vmaBeginDefragmentation(mAllocator, &info, &mContext);
+        if (result != VK_SUCCESS) {
+            std::cerr << "Failed to begin defragmentation! VkResult: " << result << std::endl;
+            mContext = VK_NULL_HANDLE;
+            return;
+        }
+        mStats.runs++;
+    }
+
+    void Defragmenter::Update(VkCommandBuffer cmd, u64 frameNumber) {
+        if (!Initialized()) return;
+
+        if (mContext == VK_NULL_HANDLE) {
+            if (mThreshold <= 0 || frameNumber < mNextCheck) return;
+
+            // Walks every block, which is why it's only done every so often
+            mNextCheck           = frameNumber + kCheckInterval;
+            mStats.fragmentation = MemoryReport::Collect(mAllocator).fragmentation;
+            if (mStats.fragmentation < mThreshold) return;
+
+            Start();
+            if (mContext == VK_NULL_HANDLE) return;
+        }
+
+        // The previous pass's frame hasn't completed yet
+        if (mPassPending) return;
+
+        mPass                 = {};
+        const VkResult result = vmaBeginDefragmentationPass(mAllocator, mContext, &mPass);
+        if (result == VK_SUCCESS) {
+            // Nothing left to move
+            Finish();
+            return;
+        }
+        if (result != VK_INCOMPLETE) {
+            std::cerr << "Failed to begin defragmentation pass! VkResult: " << result << std::endl;
+            Finish();
+            return;
+        }
+
+        // Copies read what earlier frames wrote. Images are also transitioned by their own tracking, buffers
+        // have nothing else to order them.
+        VkMemoryBarrier barrier {};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        u32 moved = 0;
+        for (u32 i = 0; i < mPass.moveCount; i++) {
+            VmaDefragmentationMove& move = mPass.pMoves[i];
+
+            VmaAllocationInfo info {};
+            vmaGetAllocationInfo(mAllocator, move.srcAllocation, &info);
+
+            auto* target = CAST<IRelocatable*>(info.pUserData);
+            if (target == nullptr || !target->Relocate(cmd, move.dstTmpAllocation, *mDeletionQueue)) {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                mStats.allocationsSkipped++;
+                continue;
+            }
+
+            moved++;
+            mStats.bytesMoved += info.size;
+        }
+        mStats.allocationsMoved += moved;
+        mStats.passes++;
+
+        // Everything after this in the frame may read the moved resources
+        if (moved > 0) {
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                 0,
+                                 1,
+                                 &barrier,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr);
+        }
+
+        // Ending the pass frees the old places, which the copies read until this frame completes. Queued after
+        // the old handles the owners retired, so those are destroyed first.
+        mPassPending     = true;
+        const u64 passId = ++mPassId;
+        mDeletionQueue->Retire(frameNumber, [this, passId](VkDevice, VmaAllocator) {
+            if (mPassPending && passId == mPassId) { EndPass(); }
+        });
+    }
+
+    DefragmenterStats Defragmenter::GetStats() const {
+        DefragmenterStats stats = mStats;
+        stats.running           = IsRunning();
+        return stats;
+    }
+
+    void Defragmenter::EndPass() {
+        mPassPending = false;
+
+        // VK_INCOMPLETE means there's more to move, the next pass begins on the next Update()
+        const VkResult result = vmaEndDefragmentationPass(mAllocator, mContext, &mPass);
+        if (result == VK_SUCCESS) {
+            Finish();
+        } else if (result != VK_INCOMPLETE) {
+            std::cerr << "Failed to end defragmentation pass! VkResult: " << result << std::endl;
+            Finish();
+        }
+    }
+
+    void Defragmenter::Finish() {
+        VmaDefragmentationStats stats {};
+        vmaEndDefragmentation(mAllocator, mContext, &stats);
+        mContext = VK_NULL_HANDLE;
+
+        mStats.bytesFreed += stats.bytesFreed;
+        mStats.blocksFreed += stats.deviceMemoryBlocksFreed;
+    }
+}  // namespace North::Graphics
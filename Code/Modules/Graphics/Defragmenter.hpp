@@ -0,0 +1,107 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "DeletionQueue.hpp"
+#include "Relocatable.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace North::Graphics {
+    struct DefragmenterStats {
+        u64 runs               = 0;  // Totals since Initialize()
+        u64 passes             = 0;
+        u64 allocationsMoved   = 0;
+        u64 allocationsSkipped = 0;  // Moves VMA proposed for allocations nobody made relocatable
+        u64 bytesMoved         = 0;
+        u64 bytesFreed         = 0;
+        u64 blocksFreed        = 0;
+        f32 fragmentation      = 0;  // As of the last check, see MemoryStats::fragmentation
+        bool running           = false;
+    };
+
+    /**
+     * @brief Compacts VMA's default pools a little every frame
+     *
+     * Built on VMA's incremental defragmentation: a run is split into passes of at most SetPassLimits() bytes
+     * and allocations, and each pass is one frame's worth of GPU copies. For every move VMA proposes, the
+     * allocation's owner (found through its user data, see IRelocatable) creates a new handle at the new place,
+     * records the copy into the frame's command buffer and switches to it on the spot, so the rest of the frame
+     * already uses the moved resource. Old handles go to the deletion queue, and so does the end of the pass:
+     * VMA only releases the old places once the frame that copied out of them has completed. The next pass
+     * starts on the first Update() after that.
+     *
+     * Only allocations whose owner opted in with Buffer::SetRelocatable() / Image::SetRelocatable() are moved,
+     * everything else is left in place. Dedicated allocations (render targets) never are.
+     *
+     * A run starts with Start(), or on its own when a check (every kCheckInterval frames) finds fragmentation
+     * above the threshold.
+     */
+    class Defragmenter {
+    public:
+        static constexpr VkDeviceSize kDefaultBytesPerPass = 16ull << 20;
+        static constexpr u32 kDefaultAllocationsPerPass    = 64;
+        static constexpr f32 kDefaultThreshold             = 0.3f;
+        static constexpr u64 kCheckInterval                = 600;
+
+        Defragmenter() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(Defragmenter)
+
+        bool Initialize(VmaAllocator allocator, DeletionQueue& deletionQueue);
+
+        /// @brief Ends the pass and run in progress. The device has to be idle.
+        void Shutdown();
+
+        /// @brief Start a run now, does nothing while one is in progress
+        void Start();
+
+        /// @brief Run the next pass if the previous one has completed. Once per frame, outside a render pass and
+        /// ahead of anything else the frame records.
+        void Update(VkCommandBuffer cmd, u64 frameNumber);
+
+        /// @brief Bytes and allocations moved per pass (per frame), larger allocations are never moved
+        void SetPassLimits(VkDeviceSize maxBytes, u32 maxAllocations) {
+            mMaxBytesPerPass       = maxBytes;
+            mMaxAllocationsPerPass = maxAllocations;
+        }
+
+        /// @brief Fragmentation that starts a run on its own, 0 turns automatic runs off
+        void SetThreshold(f32 fragmentation) {
+            mThreshold = fragmentation;
+        }
+
+        NE_ND bool IsRunning() const {
+            return mContext != VK_NULL_HANDLE;
+        }
+
+        NE_ND DefragmenterStats GetStats() const;
+
+        NE_ND bool Initialized() const {
+            return mAllocator != VK_NULL_HANDLE;
+        }
+
+    private:
+        void EndPass();
+        void Finish();
+
+        VmaAllocator mAllocator       = VK_NULL_HANDLE;
+        DeletionQueue* mDeletionQueue = nullptr;
+
+        VmaDefragmentationContext mContext = VK_NULL_HANDLE;
+        VmaDefragmentationPassMoveInfo mPass {};  // Owned by VMA until the pass ends
+        bool mPassPending = false;                // Copied, waiting for the frame to complete
+        u64 mPassId       = 0;                    // Lets a pass ended by Shutdown() ignore its queued end
+
+        VkDeviceSize mMaxBytesPerPass = kDefaultBytesPerPass;
+        u32 mMaxAllocationsPerPass    = kDefaultAllocationsPerPass;
+        f32 mThreshold                = kDefaultThreshold;
+        u64 mNextCheck                = kCheckInterval;
+
+        DefragmenterStats mStats;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,72 @@
+// Author: Jake Rieger
+// Created: 11/21/25.
+//
+
+#include "DeletionQueue.hpp"
+
+namespace North::Graphics {
+    DeletionQueue::~DeletionQueue() {
+        FlushAll();
+    }
+
+    void DeletionQueue::Initialize(VkDevice device, VmaAllocator allocator) {
+        mDevice    = device;
+        mAllocator = allocator;
+    }
+
+    void DeletionQueue::SetFrameNumber(u64 frameNumber) {
+        mFrameNumber = frameNumber;
+    }
+
+    void DeletionQueue::Retire(u64 frameNumber, Deleter&& deleter) {
+        mEntries.push_back({frameNumber, std::move(deleter)});
+    }
+
+    void DeletionQueue::Retire(Deleter&& deleter) {
+        Retire(mFrameNumber, std::move(deleter));
+    }
+
+    void DeletionQueue::RetireBuffer(VkBuffer buffer, VmaAllocation allocation) {
+        if (buffer == VK_NULL_HANDLE) return;
+        Retire([buffer, allocation](VkDevice, VmaAllocator allocator) {
+            vmaDestroyBuffer(allocator, buffer, allocation);
+        });
+    }
+
+    void DeletionQueue::RetireImage(VkImage image, VmaAllocation allocation) {
+        if (image == VK_NULL_HANDLE) return;
+        Retire([image, allocation](VkDevice, VmaAllocator allocator) {
+            vmaDestroyImage(allocator, image, allocation);
+        });
+    }
+
+    void DeletionQueue::RetireImageView(VkImageView imageView) {
+        if (imageView == VK_NULL_HANDLE) return;
+        Retire([imageView](VkDevice device, VmaAllocator) { vkDestroyImageView(device, imageView, nullptr); });
+    }
+
+    void DeletionQueue::RetireFramebuffer(VkFramebuffer framebuffer) {
+        if (framebuffer == VK_NULL_HANDLE) return;
+        Retire([framebuffer](VkDevice device, VmaAllocator) { vkDestroyFramebuffer(device, framebuffer, nullptr); });
+    }
+
+    void DeletionQueue::RetirePipeline(VkPipeline pipeline) {
+        if (pipeline == VK_NULL_HANDLE) return;
+        Retire([pipeline](VkDevice device, VmaAllocator) { vkDestroyPipeline(device, pipeline, nullptr); });
+    }
+
+    void DeletionQueue::Flush(u64 completedFrame) {
+        while (!mEntries.empty() && mEntries.front().frameNumber <= completedFrame) {
+            mEntries.front().deleter(mDevice, mAllocator);
+            mEntries.pop_front();
+        }
+    }
+
+    void DeletionQueue::FlushAll() {
+        // Destroy in retirement order, callers retire dependents (views, framebuffers) before what they reference
+        for (auto& entry : mEntries) {
+            entry.deleter(mDevice, mAllocator);
+        }
+        mEntries.clear();
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,76 @@
+// Author: Jake Rieger
+// Created: 11/21/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+#include <deque>
+#include <functional>
+
+namespace North::Graphics {
+    /**
+     * @brief Frame-stamped queue of GPU resources waiting to be destroyed
+     *
+     * Destroying something the GPU may still be reading needs either a device-wide idle or knowing which
+     * frame used it last. Resources retired here are stamped with the frame currently being recorded and
+     * only destroyed once the frame timeline has passed that frame, so freeing never forces a stall.
+     *
+     * Example:
+     *   deletionQueue.RetireFramebuffer(framebuffer);  // safe even if in-flight frames still use it
+     *   ...
+     *   deletionQueue.Flush(renderContext.GetCompletedFrame());
+     */
+    class DeletionQueue {
+    public:
+        /// @brief Destroys one retired resource, gets the device and allocator the queue was initialized with
+        using Deleter = std::function<void(VkDevice, VmaAllocator)>;
+
+        DeletionQueue() = default;
+        ~DeletionQueue();
+
+        NE_CLASS_PREVENT_MOVES_COPIES(DeletionQueue)
+
+        void Initialize(VkDevice device, VmaAllocator allocator);
+
+        /// @brief Frame number new retirements are stamped with (the frame currently being recorded)
+        void SetFrameNumber(u64 frameNumber);
+
+        /// @brief Retire with an explicit stamp, destroyed once `frameNumber` has completed
+        void Retire(u64 frameNumber, Deleter&& deleter);
+        void Retire(Deleter&& deleter);
+
+        void RetireBuffer(VkBuffer buffer, VmaAllocation allocation);
+        void RetireImage(VkImage image, VmaAllocation allocation);
+        void RetireImageView(VkImageView imageView);
+        void RetireFramebuffer(VkFramebuffer framebuffer);
+        void RetirePipeline(VkPipeline pipeline);
+
+        /// @brief Destroy everything stamped with a frame <= completedFrame
+        void Flush(u64 completedFrame);
+
+        /// @brief Destroy everything regardless of stamp, only valid once the device is idle
+        void FlushAll();
+
+        NE_ND size_t GetPendingCount() const {
+            return mEntries.size();
+        }
+
+    private:
+        struct Entry {
+            u64 frameNumber;
+            Deleter deleter;
+        };
+
+        VkDevice mDevice        = VK_NULL_HANDLE;
+        VmaAllocator mAllocator = VK_NULL_HANDLE;
+        u64 mFrameNumber        = 0;
+
+        // Mostly in stamp order, flushed from the front. An entry stamped later than the ones behind it only
+        // delays them, never frees anything early.
+        std::deque<Entry> mEntries;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,196 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "DescriptorAllocator.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        void HashCombine(u64& seed, u64 value) {
+            seed ^= value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+        }
+
+        /// Descriptors per set a pool is sized for, by type. Pools fail over to a new one when any type runs out.
+        struct PoolRatio {
+            VkDescriptorType type;
+            f32 perSet;
+        };
+
+        constexpr PoolRatio kPoolRatios[] = {
+          {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4.0f},
+          {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f},
+          {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f},
+          {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f},
+          {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 2.0f},
+          {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f},
+          {VK_DESCRIPTOR_TYPE_SAMPLER, 1.0f},
+        };
+    }  // namespace
+
+    bool DescriptorAllocator::LayoutKey::operator==(const LayoutKey& other) const {
+        const auto sameBinding = [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) {
+            return a.binding == b.binding && a.descriptorType == b.descriptorType &&
+                   a.descriptorCount == b.descriptorCount && a.stageFlags == b.stageFlags &&
+                   a.pImmutableSamplers == b.pImmutableSamplers;
+        };
+
+        return flags == other.flags &&
+               std::equal(bindings.begin(), bindings.end(), other.bindings.begin(), other.bindings.end(), sameBinding);
+    }
+
+    size_t DescriptorAllocator::LayoutKey::Hasher::operator()(const LayoutKey& key) const {
+        u64 hash = key.flags;
+        for (const auto& binding : key.bindings) {
+            HashCombine(hash, binding.binding);
+            HashCombine(hash, binding.descriptorType);
+            HashCombine(hash, binding.descriptorCount);
+            HashCombine(hash, binding.stageFlags);
+            HashCombine(hash, RCAST<uptr>(binding.pImmutableSamplers));
+        }
+        return CAST<size_t>(hash);
+    }
+
+    bool DescriptorAllocator::Initialize(VkDevice device, u32 frameCount) {
+        mDevice       = device;
+        mCurrentFrame = 0;
+        mSetsPerPool  = kInitialSetsPerPool;
+
+        return Reserve(frameCount);
+    }
+
+    void DescriptorAllocator::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        for (auto& frame : mFrames) {
+            for (const auto pool : frame.usedPools) {
+                vkDestroyDescriptorPool(mDevice, pool, nullptr);
+            }
+            for (const auto pool : frame.freePools) {
+                vkDestroyDescriptorPool(mDevice, pool, nullptr);
+            }
+        }
+        mFrames.clear();
+
+        for (const auto& [key, layout] : mLayouts) {
+            vkDestroyDescriptorSetLayout(mDevice, layout, nullptr);
+        }
+        mLayouts.clear();
+
+        mDevice = VK_NULL_HANDLE;
+    }
+
+    bool DescriptorAllocator::Reserve(u32 frameCount) {
+        // Pools are created on demand, a new slot costs nothing until it allocates
+        if (mFrames.size() < frameCount) { mFrames.resize(frameCount); }
+        return true;
+    }
+
+    void DescriptorAllocator::BeginFrame(u32 frameIndex) {
+        mCurrentFrame   = frameIndex;
+        FrameSlot& slot = mFrames[frameIndex];
+
+        // Every set allocated from these pools goes at once
+        for (const auto pool : slot.usedPools) {
+            vkResetDescriptorPool(mDevice, pool, 0);
+            slot.freePools.push_back(pool);
+        }
+        slot.usedPools.clear();
+        slot.allocatedSets = 0;
+    }
+
+    VkDescriptorSet DescriptorAllocator::Allocate(VkDescriptorSetLayout layout) {
+        FrameSlot& slot = mFrames[mCurrentFrame];
+
+        VkDescriptorSetAllocateInfo allocInfo {};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts        = &layout;
+
+        // At most two tries: the current pool, then a fresh one
+        VkDescriptorPool pool = slot.usedPools.empty() ? AcquirePool(slot) : slot.usedPools.back();
+        for (u32 attempt = 0; attempt < 2 && pool != VK_NULL_HANDLE; attempt++) {
+            allocInfo.descriptorPool = pool;
+
+            VkDescriptorSet set   = VK_NULL_HANDLE;
+            const VkResult result = vkAllocateDescriptorSets(mDevice, &allocInfo, &set);
+            if (result == VK_SUCCESS) {
+                slot.allocatedSets++;
+                return set;
+            }
+            if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) break;
+
+            pool = AcquirePool(slot);
+        }
+
+        std::cerr << "Failed to allocate a transient descriptor set!" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+
+    VkDescriptorSetLayout DescriptorAllocator::GetLayout(const vector<VkDescriptorSetLayoutBinding>& bindings,
+                                                         VkDescriptorSetLayoutCreateFlags flags) {
+        LayoutKey key {bindings, flags};
+        std::sort(key.bindings.begin(), key.bindings.end(), [](const auto& a, const auto& b) {
+            return a.binding < b.binding;
+        });
+
+        if (auto it = mLayouts.find(key); it != mLayouts.end()) return it->second;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.flags        = flags;
+        layoutInfo.bindingCount = CAST<u32>(key.bindings.size());
+        layoutInfo.pBindings    = key.bindings.data();
+
+        VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+        if (vkCreateDescriptorSetLayout(mDevice, &layoutInfo, nullptr, &layout) != VK_SUCCESS) {
+            std::cerr << "Failed to create descriptor set layout!" << std::endl;
+            return VK_NULL_HANDLE;
+        }
+
+        mLayouts.emplace(std::move(key), layout);
+        return layout;
+    }
+
+    DescriptorAllocatorStats DescriptorAllocator::GetStats() const {
+        DescriptorAllocatorStats stats;
+        for (const auto& frame : mFrames) {
+            stats.pools += CAST<u32>(frame.usedPools.size() + frame.freePools.size());
+        }
+        stats.sets    = mFrames.empty() ? 0 : mFrames[mCurrentFrame].allocatedSets;
+        stats.layouts = CAST<u32>(mLayouts.size());
+        return stats;
+    }
+
+    VkDescriptorPool DescriptorAllocator::AcquirePool(FrameSlot& slot) {
+        if (!slot.freePools.empty()) {
+            slot.usedPools.push_back(slot.freePools.back());
+            slot.freePools.pop_back();
+            return slot.usedPools.back();
+        }
+
+        vector<VkDescriptorPoolSize> poolSizes;
+        for (const auto& ratio : kPoolRatios) {
+            poolSizes.push_back({ratio.type, CAST<u32>(ratio.perSet * CAST<f32>(mSetsPerPool))});
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo {};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets       = mSetsPerPool;
+        poolInfo.poolSizeCount = CAST<u32>(poolSizes.size());
+        poolInfo.pPoolSizes    = poolSizes.data();
+
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        if (vkCreateDescriptorPool(mDevice, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            std::cerr << "Failed to create descriptor pool!" << std::endl;
+            return VK_NULL_HANDLE;
+        }
+
+        // Frames that needed more than one pool will likely do so again, make the next one bigger
+        mSetsPerPool = NE_MIN(mSetsPerPool * 2, kMaxSetsPerPool);
+        slot.usedPools.push_back(pool);
+        return pool;
+    }
+}  // namespace North::Graphics
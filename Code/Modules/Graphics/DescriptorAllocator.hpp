@@ -0,0 +1,90 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <unordered_map>
+
+namespace North::Graphics {
+    struct DescriptorAllocatorStats {
+        u32 pools   = 0;  // Across every frame slot, in use or waiting to be reused
+        u32 sets    = 0;  // Allocated by the current frame so far
+        u32 layouts = 0;  // Cached set layouts
+    };
+
+    /**
+     * @brief Transient descriptor sets for the frame being recorded, and a cache of set layouts
+     *
+     * Every frame in flight has its own list of descriptor pools. Sets are allocated from the slot's current pool
+     * and never freed individually; when a pool runs out the next one is taken (or created, each new pool twice
+     * the size of the last up to kMaxSetsPerPool). BeginFrame() resets all of a slot's pools with
+     * vkResetDescriptorPool once the frame that last used it has completed, so after the first few frames
+     * allocating a set is just a pointer bump inside the driver's pool.
+     *
+     * Sets are only valid for the frame they were allocated in; long-lived sets (bindless table, uniform ring) keep
+     * their own pools. Layouts created with UPDATE_AFTER_BIND can't be allocated from here.
+     */
+    class DescriptorAllocator {
+    public:
+        static constexpr u32 kInitialSetsPerPool = 64;
+        static constexpr u32 kMaxSetsPerPool     = 4096;
+
+        DescriptorAllocator() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(DescriptorAllocator)
+
+        bool Initialize(VkDevice device, u32 frameCount);
+
+        /// @brief Destroys every pool and cached layout. The GPU must be idle.
+        void Shutdown();
+
+        /// @brief Grow to at least `frameCount` per-frame slots
+        bool Reserve(u32 frameCount);
+
+        /// @brief Reset the slot's pools for a new frame. The frame that last used it must be complete.
+        void BeginFrame(u32 frameIndex);
+
+        /// @brief Allocate a set for the current frame, valid until its slot begins again
+        /// @return VK_NULL_HANDLE if no pool could be created
+        VkDescriptorSet Allocate(VkDescriptorSetLayout layout);
+
+        /// @brief Layout for a set of bindings, created on first request and owned by the allocator. Equal binding
+        /// lists always return the same layout, so sets and pipeline layouts built from them stay compatible.
+        VkDescriptorSetLayout GetLayout(const vector<VkDescriptorSetLayoutBinding>& bindings,
+                                        VkDescriptorSetLayoutCreateFlags flags = 0);
+
+        NE_ND DescriptorAllocatorStats GetStats() const;
+
+    private:
+        struct FrameSlot {
+            vector<VkDescriptorPool> usedPools;  // Back is the one being allocated from
+            vector<VkDescriptorPool> freePools;  // Reset and ready to be reused
+            u32 allocatedSets = 0;
+        };
+
+        struct LayoutKey {
+            vector<VkDescriptorSetLayoutBinding> bindings;
+            VkDescriptorSetLayoutCreateFlags flags = 0;
+
+            bool operator==(const LayoutKey& other) const;
+
+            struct Hasher {
+                size_t operator()(const LayoutKey& key) const;
+            };
+        };
+
+        VkDescriptorPool AcquirePool(FrameSlot& slot);
+
+        VkDevice mDevice  = VK_NULL_HANDLE;
+        u32 mCurrentFrame = 0;
+        u32 mSetsPerPool  = kInitialSetsPerPool;
+        vector<FrameSlot> mFrames;
+
+        std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKey::Hasher> mLayouts;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,49 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "DrawBatcher.hpp"
+
+namespace North::Graphics {
+    void DrawBatcher::Build(const vector<DrawCommand>& commands) {
+        Clear();
+        mCommandBatch.resize(commands.size(), kInvalidBatch);
+
+        // Counting sort: assign batches and count their instances, then turn the counts into ranges
+        for (u32 i = 0; i < CAST<u32>(commands.size()); i++) {
+            const DrawCommand& command = commands[i];
+            if (!command.mesh || !command.mesh->IsValid()) { continue; }
+
+            auto [it, inserted] = mBatchLookup.try_emplace(command.mesh, CAST<u32>(mBatches.size()));
+            if (inserted) {
+                DrawBatch& batch = mBatches.emplace_back();
+                batch.mesh       = command.mesh;
+            }
+
+            mCommandBatch[i] = it->second;
+            mBatches[it->second].instanceCount++;
+        }
+
+        u32 firstInstance = 0;
+        for (auto& batch : mBatches) {
+            batch.firstInstance = firstInstance;
+            firstInstance += batch.instanceCount;
+            batch.instanceCount = 0;  // Reused as the fill cursor below, ends up back at the count
+        }
+
+        mInstances.resize(firstInstance);
+        for (u32 i = 0; i < CAST<u32>(commands.size()); i++) {
+            if (mCommandBatch[i] == kInvalidBatch) { continue; }
+
+            DrawBatch& batch                                        = mBatches[mCommandBatch[i]];
+            mInstances[batch.firstInstance + batch.instanceCount++] = i;
+        }
+    }
+
+    void DrawBatcher::Clear() {
+        mBatches.clear();
+        mInstances.clear();
+        mCommandBatch.clear();
+        mBatchLookup.clear();
+    }
+}  // namespace North::Graphics
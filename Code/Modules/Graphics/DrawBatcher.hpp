@@ -0,0 +1,58 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "RenderCommand.hpp"
+
+#include <unordered_map>
+
+namespace North::Graphics {
+    /// @brief Every command of a frame that shares one mesh, drawn as one instanced draw
+    struct DrawBatch {
+        const Mesh* mesh  = nullptr;
+        u32 firstInstance = 0;  // Into DrawBatcher::GetInstances()
+        u32 instanceCount = 0;
+    };
+
+    /**
+     * @brief Groups a frame's draw commands into instanced draws
+     *
+     * Commands sharing a mesh become one DrawBatch whose instanceCount/firstInstance describe a contiguous
+     * range of GetInstances(). Each command is one instance. Writing the instances' matrices in that order gives
+     * every batch its own slice of the instance buffer, so a scene full of repeated props costs one draw per mesh
+     * instead of one per prop.
+     *
+     * Materials don't exist yet, once they do they become part of the batch key next to the mesh.
+     */
+    class DrawBatcher {
+    public:
+        DrawBatcher() = default;
+
+        /// @brief Rebuild the batches from this frame's commands. Commands without a valid mesh are skipped,
+        /// batches keep the order their mesh first appeared in, instances keep submission order.
+        void Build(const vector<DrawCommand>& commands);
+
+        void Clear();
+
+        /// @brief One instanced draw per mesh
+        NE_ND const vector<DrawBatch>& GetBatches() const {
+            return mBatches;
+        }
+
+        /// @brief Indices into the commands passed to Build(), ordered so each batch's instances are contiguous
+        NE_ND const vector<u32>& GetInstances() const {
+            return mInstances;
+        }
+
+    private:
+        vector<DrawBatch> mBatches;
+        vector<u32> mInstances;
+        vector<u32> mCommandBatch;  // Batch of every command, kInvalidBatch when skipped
+        std::unordered_map<const Mesh*, u32> mBatchLookup;
+
+        static constexpr u32 kInvalidBatch = ~0u;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,201 @@
+// Author: Jake Rieger
+// Created: 11/21/25.
+//
+
+#include "GeometryPool.hpp"
+#include <iostream>
+
+namespace North::Graphics {
+    GeometryPool::~GeometryPool() {
+        Shutdown();
+    }
+
+    bool GeometryPool::Initialize(VmaAllocator allocator,
+                                  DeletionQueue& deletionQueue,
+                                  u32 vertexStride,
+                                  u32 vertexCapacity,
+                                  u32 indexCapacity) {
+        mAllocator      = allocator;
+        mDeletionQueue  = &deletionQueue;
+        mVertexStride   = vertexStride;
+        mVertexCapacity = vertexCapacity;
+        mIndexCapacity  = indexCapacity;
+
+        mVertexBuffer.Create(mAllocator,
+                             CAST<VkDeviceSize>(vertexCapacity) * vertexStride,
+                             Buffer::Type::Vertex,
+                             Buffer::MemoryUsage::GPU_Only);
+        mIndexBuffer.Create(mAllocator,
+                            CAST<VkDeviceSize>(indexCapacity) * sizeof(Index),
+                            Buffer::Type::Index,
+                            Buffer::MemoryUsage::GPU_Only);
+
+        if (!mVertexBuffer.IsValid() || !mIndexBuffer.IsValid()) {
+            std::cerr << "Failed to create geometry pool buffers!" << std::endl;
+            return false;
+        }
+
+        // Bind() asks for the handles every frame, nothing to fix up when the defragmenter moves them
+        mVertexBuffer.SetRelocatable();
+        mIndexBuffer.SetRelocatable();
+
+        // Virtual blocks don't care about units, counting in vertices/indices makes offsets usable as-is in draws
+        VmaVirtualBlockCreateInfo blockInfo {};
+        blockInfo.flags = VMA_VIRTUAL_BLOCK_CREATE_TLSF_ALGORITHM_BIT;
+
+        blockInfo.size = vertexCapacity;
+        if (vmaCreateVirtualBlock(&blockInfo, &mVertexBlock) != VK_SUCCESS) {
+            std::cerr << "Failed to create geometry pool vertex block!" << std::endl;
+            return false;
+        }
+
+        blockInfo.size = indexCapacity;
+        if (vmaCreateVirtualBlock(&blockInfo, &mIndexBlock) != VK_SUCCESS) {
+            std::cerr << "Failed to create geometry pool index block!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void GeometryPool::Shutdown() {
+        mPendingUploads.clear();
+
+        // VMA asserts on blocks with live allocations, meshes that were never freed are dropped with the pool
+        if (mVertexBlock != VK_NULL_HANDLE) {
+            vmaClearVirtualBlock(mVertexBlock);
+            vmaDestroyVirtualBlock(mVertexBlock);
+            mVertexBlock = VK_NULL_HANDLE;
+        }
+        if (mIndexBlock != VK_NULL_HANDLE) {
+            vmaClearVirtualBlock(mIndexBlock);
+            vmaDestroyVirtualBlock(mIndexBlock);
+            mIndexBlock = VK_NULL_HANDLE;
+        }
+
+        mVertexBuffer.Destroy();
+        mIndexBuffer.Destroy();
+        mDeletionQueue = nullptr;
+    }
+
+    GeometryAllocation GeometryPool::Allocate(u32 vertexCount, u32 indexCount) {
+        GeometryAllocation allocation;
+        if (!Initialized() || vertexCount == 0) { return allocation; }
+
+        VmaVirtualAllocationCreateInfo allocInfo {};
+        VkDeviceSize offset = 0;
+
+        allocInfo.size = vertexCount;
+        if (vmaVirtualAllocate(mVertexBlock, &allocInfo, &allocation.vertexAllocation, &offset) != VK_SUCCESS) {
+            std::cerr << "Geometry pool out of vertex space (" << vertexCount << " vertices requested)" << std::endl;
+            return {};
+        }
+        allocation.vertexOffset = CAST<u32>(offset);
+        allocation.vertexCount  = vertexCount;
+
+        if (indexCount > 0) {
+            allocInfo.size = indexCount;
+            if (vmaVirtualAllocate(mIndexBlock, &allocInfo, &allocation.indexAllocation, &offset) != VK_SUCCESS) {
+                std::cerr << "Geometry pool out of index space (" << indexCount << " indices requested)" << std::endl;
+                vmaVirtualFree(mVertexBlock, allocation.vertexAllocation);
+                return {};
+            }
+            allocation.firstIndex = CAST<u32>(offset);
+            allocation.indexCount = indexCount;
+        }
+
+        return allocation;
+    }
+
+    void GeometryPool::Upload(const GeometryAllocation& allocation, const void* vertices, const u32* indices) {
+        if (!allocation.IsValid()) {
+            std::cerr << "Cannot upload to invalid geometry allocation!" << std::endl;
+            return;
+        }
+
+        PendingUpload upload;
+        upload.vertexOffset = CAST<VkDeviceSize>(allocation.vertexOffset) * mVertexStride;
+        upload.vertexSize   = CAST<VkDeviceSize>(allocation.vertexCount) * mVertexStride;
+        upload.indexOffset  = CAST<VkDeviceSize>(allocation.firstIndex) * sizeof(u32);
+        upload.indexSize    = indices ? CAST<VkDeviceSize>(allocation.indexCount) * sizeof(u32) : 0;
+
+        // One staging buffer per upload holding the vertices followed by the indices
+        upload.staging.Create(
+          mAllocator, upload.vertexSize + upload.indexSize, Buffer::Type::Staging, Buffer::MemoryUsage::CPU_To_GPU);
+        if (!upload.staging.IsValid()) { return; }
+
+        upload.staging.Upload(vertices, upload.vertexSize);
+        if (upload.indexSize > 0) { upload.staging.Upload(indices, upload.indexSize, upload.vertexSize); }
+
+        mPendingUploads.push_back(std::move(upload));
+    }
+
+    void GeometryPool::Free(GeometryAllocation& allocation) {
+        if (!allocation.IsValid()) return;
+
+        // The range stays reserved until the frames that may draw from it are done, so it can't be handed out and
+        // overwritten underneath them
+        mDeletionQueue->Retire([vertexBlock      = mVertexBlock,
+                                indexBlock       = mIndexBlock,
+                                vertexAllocation = allocation.vertexAllocation,
+                                indexAllocation  = allocation.indexAllocation](VkDevice, VmaAllocator) {
+            vmaVirtualFree(vertexBlock, vertexAllocation);
+            if (indexAllocation != VK_NULL_HANDLE) { vmaVirtualFree(indexBlock, indexAllocation); }
+        });
+
+        allocation = {};
+    }
+
+    void GeometryPool::RecordUploads(VkCommandBuffer cmd) {
+        if (mPendingUploads.empty()) return;
+
+        for (auto& upload : mPendingUploads) {
+            mVertexBuffer.CopyFrom(cmd, upload.staging, upload.vertexSize, 0, upload.vertexOffset);
+            if (upload.indexSize > 0) {
+                mIndexBuffer.CopyFrom(cmd, upload.staging, upload.indexSize, upload.vertexSize, upload.indexOffset);
+            }
+
+            // The copy is in this frame's command buffer, the staging memory goes once the frame completes
+            upload.staging.Retire(*mDeletionQueue);
+        }
+        mPendingUploads.clear();
+
+        // One barrier for the whole batch instead of one per mesh
+        VkMemoryBarrier barrier {};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+    }
+
+    void GeometryPool::Bind(VkCommandBuffer cmd) const {
+        const VkBuffer vertexBuffer   = mVertexBuffer.GetHandle();
+        constexpr VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(cmd, 0, 1, &vertexBuffer, &offset);
+        vkCmdBindIndexBuffer(cmd, mIndexBuffer.GetHandle(), 0, VK_INDEX_TYPE_UINT32);
+    }
+
+    u32 GeometryPool::GetUsedVertices() const {
+        if (mVertexBlock == VK_NULL_HANDLE) return 0;
+        VmaStatistics stats {};
+        vmaGetVirtualBlockStatistics(mVertexBlock, &stats);
+        return CAST<u32>(stats.allocationBytes);
+    }
+
+    u32 GeometryPool::GetUsedIndices() const {
+        if (mIndexBlock == VK_NULL_HANDLE) return 0;
+        VmaStatistics stats {};
+        vmaGetVirtualBlockStatistics(mIndexBlock, &stats);
+        return CAST<u32>(stats.allocationBytes);
+    }
+}  // namespace North::Graphics
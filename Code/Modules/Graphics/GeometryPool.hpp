@@ -0,0 +1,137 @@
+// Author: Jake Rieger
+// Created: 11/21/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+#include "DeletionQueue.hpp"
+#include "Vertex.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace North::Graphics {
+    /// @brief A mesh's slice of the geometry pool, offsets are in vertices and indices (not bytes)
+    struct GeometryAllocation {
+        u32 vertexOffset = 0;  // vertexOffset of vkCmdDrawIndexed
+        u32 vertexCount  = 0;
+        u32 firstIndex   = 0;  // firstIndex of vkCmdDrawIndexed
+        u32 indexCount   = 0;
+
+        VmaVirtualAllocation vertexAllocation = VK_NULL_HANDLE;
+        VmaVirtualAllocation indexAllocation  = VK_NULL_HANDLE;
+
+        NE_ND bool IsValid() const {
+            return vertexAllocation != VK_NULL_HANDLE;
+        }
+    };
+
+    /**
+     * @brief Sub-allocates mesh data out of one large vertex buffer and one large index buffer
+     *
+     * Giving every mesh its own VkBuffer means one allocation per mesh and a vertex/index buffer rebind per
+     * draw. Here all geometry lives in two GPU_Only buffers, ranges are handed out by VMA virtual blocks
+     * (TLSF), and every draw only differs in firstIndex/vertexOffset, so the buffers are bound once per
+     * frame and draws can be batched or issued indirectly.
+     *
+     * Uploads are staged and recorded into the next frame's command buffer by RecordUploads(). Freed ranges
+     * go through the deletion queue so they are only reused once no in-flight frame can still read them.
+     *
+     * Example:
+     *   auto mesh = pool.Allocate(vertices.size(), indices.size());
+     *   pool.Upload(mesh, vertices.data(), indices.data());
+     *   ...
+     *   pool.Bind(cmd);
+     *   vkCmdDrawIndexed(cmd, mesh.indexCount, 1, mesh.firstIndex, mesh.vertexOffset, 0);
+     */
+    class GeometryPool {
+    public:
+        GeometryPool() = default;
+        ~GeometryPool();
+
+        NE_CLASS_PREVENT_MOVES_COPIES(GeometryPool)
+
+        /**
+         * @param allocator VMA allocator the two backing buffers come from
+         * @param deletionQueue Staging buffers and freed ranges are retired here
+         * @param vertexStride Size of one vertex in bytes
+         * @param vertexCapacity Maximum number of vertices the pool can hold
+         * @param indexCapacity Maximum number of (32-bit) indices the pool can hold
+         */
+        bool Initialize(VmaAllocator allocator,
+                        DeletionQueue& deletionQueue,
+                        u32 vertexStride,
+                        u32 vertexCapacity,
+                        u32 indexCapacity);
+
+        /// @brief Only valid once the device is idle and the deletion queue has been flushed
+        void Shutdown();
+
+        /// @brief Reserve space for a mesh. Returns an invalid allocation when the pool is out of space.
+        NE_ND GeometryAllocation Allocate(u32 vertexCount, u32 indexCount);
+
+        /// @brief Queue mesh data to be copied in at the start of the next frame
+        /// @param vertices vertexCount * vertexStride bytes
+        /// @param indices indexCount 32-bit indices, relative to the mesh's first vertex
+        void Upload(const GeometryAllocation& allocation, const void* vertices, const u32* indices);
+
+        /// @brief Give the range back once every frame that may still draw from it has completed
+        void Free(GeometryAllocation& allocation);
+
+        /// @brief Record all queued uploads, must be outside a render pass
+        void RecordUploads(VkCommandBuffer cmd);
+
+        /// @brief Bind the pool's vertex buffer (binding 0) and index buffer
+        void Bind(VkCommandBuffer cmd) const;
+
+        NE_ND const Buffer& GetVertexBuffer() const {
+            return mVertexBuffer;
+        }
+
+        NE_ND const Buffer& GetIndexBuffer() const {
+            return mIndexBuffer;
+        }
+
+        NE_ND u32 GetVertexStride() const {
+            return mVertexStride;
+        }
+
+        NE_ND u32 GetVertexCapacity() const {
+            return mVertexCapacity;
+        }
+
+        NE_ND u32 GetIndexCapacity() const {
+            return mIndexCapacity;
+        }
+
+        /// @brief Vertices currently reserved, including freed ranges still waiting on the GPU
+        NE_ND u32 GetUsedVertices() const;
+        NE_ND u32 GetUsedIndices() const;
+
+        NE_ND bool Initialized() const {
+            return mVertexBlock != VK_NULL_HANDLE;
+        }
+
+    private:
+        struct PendingUpload {
+            Buffer staging;
+            VkDeviceSize vertexOffset = 0;  // Byte offsets into the pool's buffers
+            VkDeviceSize vertexSize   = 0;
+            VkDeviceSize indexOffset  = 0;
+            VkDeviceSize indexSize    = 0;
+        };
+
+        VmaAllocator mAllocator       = VK_NULL_HANDLE;
+        DeletionQueue* mDeletionQueue = nullptr;
+        u32 mVertexStride             = 0;
+        u32 mVertexCapacity           = 0;
+        u32 mIndexCapacity            = 0;
+        VmaVirtualBlock mVertexBlock  = VK_NULL_HANDLE;
+        VmaVirtualBlock mIndexBlock   = VK_NULL_HANDLE;
+        Buffer mVertexBuffer;
+        Buffer mIndexBuffer;
+        vector<PendingUpload> mPendingUploads;
+    };
+}  // namespace North::Graphics
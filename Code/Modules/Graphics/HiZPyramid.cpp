@@ -0,0 +1,200 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "HiZPyramid.hpp"
+#include "Shader.hpp"
+#include "ShaderReflection.hpp"
+
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        constexpr const char* kShaderName = "HiZ.comp";
+
+        u32 PreviousPowerOfTwo(u32 value) {
+            u32 result = 1;
+            while (result * 2 <= value) {
+                result *= 2;
+            }
+            return result;
+        }
+    }  // namespace
+
+    bool HiZPyramid::Initialize(VkDevice device,
+                                VmaAllocator allocator,
+                                DeletionQueue& deletionQueue,
+                                DescriptorAllocator& descriptorAllocator,
+                                VkPipelineCache pipelineCache) {
+        mDevice              = device;
+        mAllocator           = allocator;
+        mDeletionQueue       = &deletionQueue;
+        mDescriptorAllocator = &descriptorAllocator;
+        mValid               = false;
+
+        // Needed to bind the pyramid at all, so it's created even if the pipeline can't be
+        VkSamplerCreateInfo samplerInfo {};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_NEAREST;
+        samplerInfo.minFilter    = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+
+        if (vkCreateSampler(mDevice, &samplerInfo, nullptr, &mSampler) != VK_SUCCESS) {
+            std::cerr << "Failed to create Hi-Z sampler!" << std::endl;
+            return false;
+        }
+
+        ShaderReflection reflection;
+        if (!ShaderReflection::Load(ShaderReflection::GetPath(kShaderName), reflection)) return false;
+
+        mDescriptorSetLayout = mDescriptorAllocator->GetLayout(reflection.GetSetBindings(0));
+        if (mDescriptorSetLayout == VK_NULL_HANDLE) return false;
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts    = &mDescriptorSetLayout;
+
+        if (vkCreatePipelineLayout(mDevice, &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            std::cerr << "Failed to create Hi-Z pipeline layout!" << std::endl;
+            return false;
+        }
+
+        VkShaderModule module = Shader::CreateModule(mDevice, kShaderName);
+        if (module == VK_NULL_HANDLE) return false;
+
+        VkComputePipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = module;
+        pipelineInfo.stage.pName  = "main";
+        pipelineInfo.layout       = mPipelineLayout;
+
+        const VkResult result = vkCreateComputePipelines(mDevice, pipelineCache, 1, &pipelineInfo, nullptr, &mPipeline);
+        vkDestroyShaderModule(mDevice, module, nullptr);
+
+        if (result != VK_SUCCESS) {
+            std::cerr << "Failed to create Hi-Z pipeline!" << std::endl;
+            mPipeline = VK_NULL_HANDLE;
+            return false;
+        }
+
+        return true;
+    }
+
+    void HiZPyramid::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        mImage.Destroy();
+        vkDestroyPipeline(mDevice, mPipeline, nullptr);
+        vkDestroyPipelineLayout(mDevice, mPipelineLayout, nullptr);
+        vkDestroySampler(mDevice, mSampler, nullptr);
+
+        mPipeline            = VK_NULL_HANDLE;
+        mPipelineLayout      = VK_NULL_HANDLE;
+        mSampler             = VK_NULL_HANDLE;
+        mDescriptorSetLayout = VK_NULL_HANDLE;
+        mDevice              = VK_NULL_HANDLE;
+        mValid               = false;
+    }
+
+    bool HiZPyramid::Resize(VkExtent2D depthExtent) {
+        if (mDevice == VK_NULL_HANDLE) return false;
+
+        // Frames in flight may still be culling against the old one
+        if (mImage.IsValid()) { mImage.Retire(*mDeletionQueue); }
+        mValid = false;
+
+        ImageDesc desc;
+        desc.extent    = {PreviousPowerOfTwo(depthExtent.width), PreviousPowerOfTwo(depthExtent.height), 1};
+        desc.format    = kFormat;
+        desc.usage     = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        desc.mipLevels = 0;
+
+        if (!mImage.Create(mDevice, mAllocator, desc)) {
+            std::cerr << "Failed to create Hi-Z pyramid!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void HiZPyramid::Build(VkCommandBuffer cmd, Image& depth, const Mat4x4& viewProjection) {
+        if (!Initialized() || !mImage.IsValid()) return;
+
+        depth.Transition(cmd,
+                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_SHADER_READ_BIT);
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
+
+        // One dispatch per level, each reading the one before. The image's tracking puts the barriers in between.
+        for (u32 level = 0; level < mImage.GetMipLevels(); level++) {
+            VkDescriptorSet set = mDescriptorAllocator->Allocate(mDescriptorSetLayout);
+            if (set == VK_NULL_HANDLE) return;
+
+            VkDescriptorImageInfo sourceInfo {};
+            sourceInfo.sampler = mSampler;
+            if (level == 0) {
+                sourceInfo.imageView   = depth.GetView();
+                sourceInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            } else {
+                mImage.Transition(cmd,
+                                  VK_IMAGE_LAYOUT_GENERAL,
+                                  VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                  VK_ACCESS_SHADER_READ_BIT,
+                                  level - 1,
+                                  1);
+                sourceInfo.imageView   = mImage.GetView(level - 1, 1);
+                sourceInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            }
+
+            mImage.Transition(
+              cmd, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT, level, 1);
+
+            VkDescriptorImageInfo destinationInfo {};
+            destinationInfo.imageView   = mImage.GetView(level, 1);
+            destinationInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+            VkWriteDescriptorSet writes[2] {};
+            writes[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[0].dstSet          = set;
+            writes[0].dstBinding      = 0;
+            writes[0].descriptorCount = 1;
+            writes[0].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[0].pImageInfo      = &sourceInfo;
+            writes[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[1].dstSet          = set;
+            writes[1].dstBinding      = 1;
+            writes[1].descriptorCount = 1;
+            writes[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[1].pImageInfo      = &destinationInfo;
+            vkUpdateDescriptorSets(mDevice, 2, writes, 0, nullptr);
+
+            const VkExtent3D extent = mImage.GetExtent(level);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, 1, &set, 0, nullptr);
+            vkCmdDispatch(cmd,
+                          (extent.width + kWorkgroupSize - 1) / kWorkgroupSize,
+                          (extent.height + kWorkgroupSize - 1) / kWorkgroupSize,
+                          1);
+        }
+
+        PrepareForRead(cmd);
+        mViewProjection = viewProjection;
+        mValid          = true;
+    }
+
+    void HiZPyramid::PrepareForRead(VkCommandBuffer cmd) {
+        if (!mImage.IsValid()) return;
+
+        mImage.Transition(cmd,
+                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                          VK_ACCESS_SHADER_READ_BIT);
+    }
+}  // namespace North::Graphics
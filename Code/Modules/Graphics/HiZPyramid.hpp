@@ -0,0 +1,104 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "DeletionQueue.hpp"
+#include "DescriptorAllocator.hpp"
+#include "Image.hpp"
+#include "Math/Constants.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace North::Graphics {
+    /**
+     * @brief Hierarchical-Z pyramid for occlusion culling
+     *
+     * An R32_SFLOAT mip chain where every texel holds the farthest depth of the depth buffer pixels under it,
+     * built with one small compute dispatch per level (HiZ.comp). Level 0 is the previous power of two of the
+     * depth buffer in each dimension, so every level after it halves exactly and a screen-space rectangle maps to
+     * the same texels at every level. An object whose nearest depth lies beyond the farthest depth of the texels
+     * covering its rectangle is hidden.
+     *
+     * Depth is expected in the 0 (near) to 1 (far) range with a LESS style comparison.
+     *
+     * The image exists as soon as Resize() was called, whether or not the compute pipeline could be built, so
+     * descriptor sets can always point at it. IsValid() tells whether its contents mean anything.
+     */
+    class HiZPyramid {
+    public:
+        static constexpr VkFormat kFormat = VK_FORMAT_R32_SFLOAT;
+
+        HiZPyramid() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(HiZPyramid)
+
+        /// @param pipelineCache Cache the pipeline is built through, may be VK_NULL_HANDLE
+        /// @return false if the shader couldn't be loaded. The pyramid can still be resized and bound then, but
+        /// Build() does nothing and it never becomes valid.
+        bool Initialize(VkDevice device,
+                        VmaAllocator allocator,
+                        DeletionQueue& deletionQueue,
+                        DescriptorAllocator& descriptorAllocator,
+                        VkPipelineCache pipelineCache);
+        void Shutdown();
+
+        /// @brief Size the pyramid for a depth buffer, retiring the old one. Invalid until the next Build().
+        bool Resize(VkExtent2D depthExtent);
+
+        /**
+         * @brief Reduce a depth buffer into every level
+         *
+         * `depth` is sampled, so it needs SAMPLED usage. Descriptor sets come from the current frame's
+         * DescriptorAllocator slot. The pyramid is left ready to be read by compute shaders.
+         *
+         * @param viewProjection Camera the depth buffer was rendered with, what bounds are projected with when
+         * they're tested against the pyramid
+         */
+        void Build(VkCommandBuffer cmd, Image& depth, const Mat4x4& viewProjection);
+
+        /// @brief Get the pyramid ready for compute shaders to read through GetView(), whether or not it's valid
+        void PrepareForRead(VkCommandBuffer cmd);
+
+        /// @brief Every level, what the cull shader samples with GetSampler() in SHADER_READ_ONLY_OPTIMAL
+        NE_ND VkImageView GetView() {
+            return mImage.GetView();
+        }
+
+        NE_ND VkSampler GetSampler() const {
+            return mSampler;
+        }
+
+        NE_ND const Mat4x4& GetViewProjection() const {
+            return mViewProjection;
+        }
+
+        /// @brief Built from a depth buffer since the last resize
+        NE_ND bool IsValid() const {
+            return mValid;
+        }
+
+        NE_ND bool Initialized() const {
+            return mPipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        static constexpr u32 kWorkgroupSize = 8;  // local_size_x and local_size_y in HiZ.comp
+
+        VkDevice mDevice                           = VK_NULL_HANDLE;
+        VmaAllocator mAllocator                    = VK_NULL_HANDLE;
+        DeletionQueue* mDeletionQueue              = nullptr;
+        DescriptorAllocator* mDescriptorAllocator  = nullptr;
+        VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;  // Owned by the descriptor allocator
+        VkPipelineLayout mPipelineLayout           = VK_NULL_HANDLE;
+        VkPipeline mPipeline                       = VK_NULL_HANDLE;
+        VkSampler mSampler                         = VK_NULL_HANDLE;  // Nearest, texels are only fetched
+
+        Image mImage;
+        Mat4x4 mViewProjection {Math::Constants::kIdentity4x4};
+        bool mValid = false;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,627 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "Image.hpp"
+
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        /// Accesses that make a following access (read or write) need a barrier
+        constexpr VkAccessFlags kWriteAccess =
+          VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+          VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT |
+          VK_ACCESS_MEMORY_WRITE_BIT;
+    }  // namespace
+
+    bool Image::ViewKey::operator==(const ViewKey& other) const {
+        return type == other.type && aspect == other.aspect && baseMip == other.baseMip &&
+               mipCount == other.mipCount && baseLayer == other.baseLayer && layerCount == other.layerCount;
+    }
+
+    Image::~Image() {
+        Destroy();
+    }
+
+    Image::Image(Image&& other) noexcept
+        : mDevice(other.mDevice), mAllocator(other.mAllocator), mImage(other.mImage), mAllocation(other.mAllocation),
+          mDesc(other.mDesc), mMemorySize(other.mMemorySize), mStates(std::move(other.mStates)),
+          mViews(std::move(other.mViews)), mOnRelocated(std::move(other.mOnRelocated)) {
+        // Reset the source object so it doesn't destroy our resources
+        other.mImage      = VK_NULL_HANDLE;
+        other.mAllocation = VK_NULL_HANDLE;
+        other.mViews.clear();
+
+        // The allocation's user data still points at the moved-from object
+        if (other.mRelocatable) {
+            other.mRelocatable = false;
+            UpdateRelocationTarget(true);
+        }
+    }
+
+    Image& Image::operator=(Image&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+
+            mDevice      = other.mDevice;
+            mAllocator   = other.mAllocator;
+            mImage       = other.mImage;
+            mAllocation  = other.mAllocation;
+            mDesc        = other.mDesc;
+            mMemorySize  = other.mMemorySize;
+            mStates      = std::move(other.mStates);
+            mViews       = std::move(other.mViews);
+            mOnRelocated = std::move(other.mOnRelocated);
+
+            other.mImage      = VK_NULL_HANDLE;
+            other.mAllocation = VK_NULL_HANDLE;
+            other.mViews.clear();
+
+            if (other.mRelocatable) {
+                other.mRelocatable = false;
+                UpdateRelocationTarget(true);
+            }
+        }
+        return *this;
+    }
+
+    bool Image::Create(VkDevice device, VmaAllocator allocator, const ImageDesc& desc) {
+        // Clean up any existing image
+        Destroy();
+
+        mDevice    = device;
+        mAllocator = allocator;
+        mDesc      = desc;
+        if (mDesc.mipLevels == 0) { mDesc.mipLevels = GetMipCount(mDesc.extent); }
+
+        const VkImageCreateInfo imageInfo = GetCreateInfo();
+
+        VmaAllocationCreateInfo allocInfo {};
+        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+        // Render targets are recreated on resize, give them their own memory so they don't fragment the
+        // blocks textures live in
+        if (mDesc.usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) {
+            allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+        }
+
+        VmaAllocationInfo allocationInfo {};
+        const VkResult result =
+          vmaCreateImage(mAllocator, &imageInfo, &allocInfo, &mImage, &mAllocation, &allocationInfo);
+        if (result != VK_SUCCESS) {
+            std::cerr << "Failed to create image! VkResult: " << result << std::endl;
+            mImage      = VK_NULL_HANDLE;
+            mAllocation = VK_NULL_HANDLE;
+            return false;
+        }
+
+        const bool renderTarget = allocInfo.flags & VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+        vmaSetAllocationName(mAllocator, mAllocation, renderTarget ? "Render target" : "Image");
+        mMemorySize = allocationInfo.size;
+        sLiveCount++;
+        sLiveBytes += mMemorySize;
+
+        mStates.assign(CAST<size_t>(mDesc.mipLevels) * mDesc.arrayLayers, {});
+        return true;
+    }
+
+    void Image::Destroy() {
+        for (const auto& cached : mViews) {
+            vkDestroyImageView(mDevice, cached.view, nullptr);
+        }
+        mViews.clear();
+
+        if (mImage != VK_NULL_HANDLE && mAllocator != nullptr) {
+            vmaDestroyImage(mAllocator, mImage, mAllocation);
+            ReleaseLiveStats();
+
+            mImage      = VK_NULL_HANDLE;
+            mAllocation = VK_NULL_HANDLE;
+        }
+        mStates.clear();
+        mRelocatable = false;
+        mOnRelocated = nullptr;
+    }
+
+    void Image::Retire(DeletionQueue& deletionQueue) {
+        if (mImage == VK_NULL_HANDLE) return;
+
+        // Nothing should move the allocation while it waits to be freed
+        if (mRelocatable) { UpdateRelocationTarget(false); }
+        mOnRelocated = nullptr;
+
+        for (const auto& cached : mViews) {
+            deletionQueue.RetireImageView(cached.view);
+        }
+        deletionQueue.RetireImage(mImage, mAllocation);
+        ReleaseLiveStats();
+
+        mViews.clear();
+        mStates.clear();
+        mImage      = VK_NULL_HANDLE;
+        mAllocation = VK_NULL_HANDLE;
+    }
+
+    void Image::Retire(DeletionQueue& deletionQueue, u64 frameNumber) {
+        if (mImage == VK_NULL_HANDLE) return;
+
+        if (mRelocatable) { UpdateRelocationTarget(false); }
+        mOnRelocated = nullptr;
+
+        vector<VkImageView> views;
+        for (const auto& cached : mViews) {
+            views.push_back(cached.view);
+        }
+
+        deletionQueue.Retire(frameNumber,
+                             [views = std::move(views), image = mImage, allocation = mAllocation](
+                               VkDevice device, VmaAllocator allocator) {
+                                 for (const auto view : views) {
+                                     vkDestroyImageView(device, view, nullptr);
+                                 }
+                                 vmaDestroyImage(allocator, image, allocation);
+                             });
+        ReleaseLiveStats();
+
+        mViews.clear();
+        mStates.clear();
+        mImage      = VK_NULL_HANDLE;
+        mAllocation = VK_NULL_HANDLE;
+    }
+
+    void Image::SetRelocatable(std::function<void()> onRelocated) {
+        if (!IsValid()) return;
+
+        constexpr VkImageUsageFlags transfer = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        if ((mDesc.usage & transfer) != transfer) {
+            std::cerr << "Only images with transfer usage can be relocated!" << std::endl;
+            return;
+        }
+
+        mOnRelocated = std::move(onRelocated);
+        UpdateRelocationTarget(true);
+    }
+
+    bool Image::Relocate(VkCommandBuffer cmd, VmaAllocation allocation, DeletionQueue& deletionQueue) {
+        if (!IsValid() || !mRelocatable) return false;
+
+        const VkImageCreateInfo imageInfo = GetCreateInfo();
+        VkImage image                     = VK_NULL_HANDLE;
+        if (vkCreateImage(mDevice, &imageInfo, nullptr, &image) != VK_SUCCESS) return false;
+        if (vmaBindImageMemory(mAllocator, allocation, image) != VK_SUCCESS) {
+            vkDestroyImage(mDevice, image, nullptr);
+            return false;
+        }
+
+        const vector<SubresourceState> states = mStates;
+        const VkImageAspectFlags aspect       = GetAspectMask(mDesc.format);
+
+        Transition(
+          cmd, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+
+        // The new image's memory was free until now, there's nothing to wait on
+        VkImageMemoryBarrier barrier {};
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask                   = 0;
+        barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = image;
+        barrier.subresourceRange.aspectMask     = aspect;
+        barrier.subresourceRange.baseMipLevel   = 0;
+        barrier.subresourceRange.levelCount     = mDesc.mipLevels;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount     = mDesc.arrayLayers;
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+
+        vector<VkImageCopy> regions(mDesc.mipLevels);
+        for (u32 mip = 0; mip < mDesc.mipLevels; mip++) {
+            VkImageCopy& region                  = regions[mip];
+            region.srcSubresource.aspectMask     = aspect;
+            region.srcSubresource.mipLevel       = mip;
+            region.srcSubresource.baseArrayLayer = 0;
+            region.srcSubresource.layerCount     = mDesc.arrayLayers;
+            region.srcOffset                     = {0, 0, 0};
+            region.dstSubresource                = region.srcSubresource;
+            region.dstOffset                     = {0, 0, 0};
+            region.extent                        = GetExtent(mip);
+        }
+        vkCmdCopyImage(cmd,
+                       mImage,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       CAST<u32>(regions.size()),
+                       regions.data());
+
+        // Only the handles go, the memory under them belongs to the allocation VMA is moving
+        for (const auto& cached : mViews) {
+            deletionQueue.RetireImageView(cached.view);
+        }
+        mViews.clear();
+        deletionQueue.Retire([oldImage = mImage](VkDevice device, VmaAllocator) {
+            vkDestroyImage(device, oldImage, nullptr);
+        });
+        mImage = image;
+
+        // Put every subresource back the way it was used last. Ones that were never written stay as they are.
+        SetState(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+        for (u32 mip = 0; mip < mDesc.mipLevels; mip++) {
+            for (u32 layer = 0; layer < mDesc.arrayLayers; layer++) {
+                const SubresourceState& state = states[mip * mDesc.arrayLayers + layer];
+                if (state.layout == VK_IMAGE_LAYOUT_UNDEFINED) continue;
+
+                // Last written and not read since, or read by everything the write was made visible to
+                const bool written         = state.readStage == 0;
+                VkPipelineStageFlags stage = written ? state.writeStage : state.readStage;
+                if (stage == 0) { stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT; }
+                Transition(cmd, state.layout, stage, written ? state.writeAccess : state.readAccess, mip, 1, layer, 1);
+            }
+        }
+
+        if (mOnRelocated) { mOnRelocated(); }
+        return true;
+    }
+
+    VkImageView Image::GetView(u32 baseMip,
+                               u32 mipCount,
+                               u32 baseLayer,
+                               u32 layerCount,
+                               VkImageViewType viewType,
+                               VkImageAspectFlags aspect) {
+        if (!IsValid()) return VK_NULL_HANDLE;
+
+        ResolveRange(baseMip, mipCount, baseLayer, layerCount);
+        if (aspect == 0) { aspect = GetAspectMask(mDesc.format); }
+        if (viewType == VK_IMAGE_VIEW_TYPE_MAX_ENUM) {
+            switch (mDesc.type) {
+                case VK_IMAGE_TYPE_1D:
+                    viewType = layerCount > 1 ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : VK_IMAGE_VIEW_TYPE_1D;
+                    break;
+                case VK_IMAGE_TYPE_3D:
+                    viewType = VK_IMAGE_VIEW_TYPE_3D;
+                    break;
+                default:
+                    viewType = layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+                    break;
+            }
+        }
+
+        const ViewKey key {viewType, aspect, baseMip, mipCount, baseLayer, layerCount};
+        for (const auto& cached : mViews) {
+            if (cached.key == key) return cached.view;
+        }
+
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image                           = mImage;
+        viewInfo.viewType                        = viewType;
+        viewInfo.format                          = mDesc.format;
+        viewInfo.subresourceRange.aspectMask     = aspect;
+        viewInfo.subresourceRange.baseMipLevel   = baseMip;
+        viewInfo.subresourceRange.levelCount     = mipCount;
+        viewInfo.subresourceRange.baseArrayLayer = baseLayer;
+        viewInfo.subresourceRange.layerCount     = layerCount;
+
+        VkImageView view = VK_NULL_HANDLE;
+        if (vkCreateImageView(mDevice, &viewInfo, nullptr, &view) != VK_SUCCESS) {
+            std::cerr << "Failed to create image view!" << std::endl;
+            return VK_NULL_HANDLE;
+        }
+
+        mViews.push_back({key, view});
+        return view;
+    }
+
+    bool Image::Transition(VkCommandBuffer cmd,
+                           VkImageLayout layout,
+                           VkPipelineStageFlags stage,
+                           VkAccessFlags access,
+                           u32 baseMip,
+                           u32 mipCount,
+                           u32 baseLayer,
+                           u32 layerCount) {
+        if (!IsValid()) return false;
+        ResolveRange(baseMip, mipCount, baseLayer, layerCount);
+
+        const VkImageAspectFlags aspect = GetAspectMask(mDesc.format);
+        vector<VkImageMemoryBarrier> barriers;
+        VkPipelineStageFlags srcStage = 0;
+
+        for (u32 mip = baseMip; mip < baseMip + mipCount; mip++) {
+            const size_t mipStart = barriers.size();
+
+            for (u32 layer = baseLayer; layer < baseLayer + layerCount; layer++) {
+                SubresourceState& state = GetState(mip, layer);
+
+                // A read in the same layout only needs a barrier when the last write isn't visible to its stage or
+                // access yet. Either way later writes have to wait on it.
+                const bool read = state.layout == layout && (access & kWriteAccess) == 0;
+                if (read) {
+                    const bool visible = (stage & ~state.readStage) == 0 && (access & ~state.readAccess) == 0;
+                    if (visible || state.writeStage == 0) {
+                        state.readStage |= stage;
+                        state.readAccess |= access;
+                        continue;
+                    }
+                }
+
+                // Only writes need to be made available, ordering against reads is done by the stage masks alone.
+                // A new reader waits on the write, anything else also on the reads since.
+                const VkAccessFlags srcAccess = state.writeAccess;
+                srcStage |= read ? state.writeStage : state.writeStage | state.readStage;
+
+                // Continue the previous layer's barrier when it started from the same state
+                bool extended = false;
+                if (barriers.size() > mipStart) {
+                    auto& last = barriers.back();
+                    if (last.oldLayout == state.layout && last.srcAccessMask == srcAccess &&
+                        last.subresourceRange.baseArrayLayer + last.subresourceRange.layerCount == layer) {
+                        last.subresourceRange.layerCount++;
+                        extended = true;
+                    }
+                }
+
+                if (!extended) {
+                    VkImageMemoryBarrier barrier {};
+                    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                    barrier.srcAccessMask                   = srcAccess;
+                    barrier.dstAccessMask                   = access;
+                    barrier.oldLayout                       = state.layout;
+                    barrier.newLayout                       = layout;
+                    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.image                           = mImage;
+                    barrier.subresourceRange.aspectMask     = aspect;
+                    barrier.subresourceRange.baseMipLevel   = mip;
+                    barrier.subresourceRange.levelCount     = 1;
+                    barrier.subresourceRange.baseArrayLayer = layer;
+                    barrier.subresourceRange.layerCount     = 1;
+                    barriers.push_back(barrier);
+                }
+
+                if (read) {
+                    state.readStage |= stage;
+                    state.readAccess |= access;
+                } else {
+                    state = MakeState(layout, stage, access);
+                }
+            }
+
+            // Layer runs repeating one of the previous mip's become a single barrier over both levels
+            for (size_t i = mipStart; i < barriers.size();) {
+                const auto& range = barriers[i].subresourceRange;
+                bool merged       = false;
+                for (size_t j = 0; j < mipStart && !merged; j++) {
+                    auto& previous = barriers[j];
+                    if (previous.subresourceRange.baseMipLevel + previous.subresourceRange.levelCount == mip &&
+                        previous.subresourceRange.baseArrayLayer == range.baseArrayLayer &&
+                        previous.subresourceRange.layerCount == range.layerCount &&
+                        previous.oldLayout == barriers[i].oldLayout &&
+                        previous.srcAccessMask == barriers[i].srcAccessMask) {
+                        previous.subresourceRange.levelCount++;
+                        merged = true;
+                    }
+                }
+
+                if (merged) {
+                    barriers.erase(barriers.begin() + CAST<std::ptrdiff_t>(i));
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        if (barriers.empty()) return false;
+
+        // Nothing to wait on for subresources that were never used (UNDEFINED, stage 0)
+        if (srcStage == 0) { srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT; }
+
+        vkCmdPipelineBarrier(cmd,
+                             srcStage,
+                             stage,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             CAST<u32>(barriers.size()),
+                             barriers.data());
+        return true;
+    }
+
+    void Image::SetState(VkImageLayout layout,
+                         VkPipelineStageFlags stage,
+                         VkAccessFlags access,
+                         u32 baseMip,
+                         u32 mipCount,
+                         u32 baseLayer,
+                         u32 layerCount) {
+        if (!IsValid()) return;
+        ResolveRange(baseMip, mipCount, baseLayer, layerCount);
+
+        for (u32 mip = baseMip; mip < baseMip + mipCount; mip++) {
+            for (u32 layer = baseLayer; layer < baseLayer + layerCount; layer++) {
+                GetState(mip, layer) = MakeState(layout, stage, access);
+            }
+        }
+    }
+
+    Image::SubresourceState Image::MakeState(VkImageLayout layout,
+                                             VkPipelineStageFlags stage,
+                                             VkAccessFlags access) {
+        // A layout transition counts as a write that's already visible to the stage and access it was made for
+        const VkAccessFlags writeAccess = access & kWriteAccess;
+        if (writeAccess != 0) { return {layout, stage, writeAccess, 0, 0}; }
+        return {layout, stage, 0, stage, access};
+    }
+
+    void Image::CopyFrom(VkCommandBuffer cmd,
+                         const Buffer& srcBuffer,
+                         u32 mipLevel,
+                         u32 baseLayer,
+                         u32 layerCount,
+                         VkDeviceSize srcOffset) {
+        if (!IsValid() || !srcBuffer.IsValid()) {
+            std::cerr << "Cannot copy into invalid image!" << std::endl;
+            return;
+        }
+
+        Transition(cmd,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   VK_PIPELINE_STAGE_TRANSFER_BIT,
+                   VK_ACCESS_TRANSFER_WRITE_BIT,
+                   mipLevel,
+                   1,
+                   baseLayer,
+                   layerCount);
+
+        VkBufferImageCopy region {};
+        region.bufferOffset                    = srcOffset;
+        region.bufferRowLength                 = 0;  // Tightly packed
+        region.bufferImageHeight               = 0;
+        region.imageSubresource.aspectMask     = GetAspectMask(mDesc.format);
+        region.imageSubresource.mipLevel       = mipLevel;
+        region.imageSubresource.baseArrayLayer = baseLayer;
+        region.imageSubresource.layerCount     = layerCount;
+        region.imageOffset                     = {0, 0, 0};
+        region.imageExtent                     = GetExtent(mipLevel);
+
+        vkCmdCopyBufferToImage(
+          cmd, srcBuffer.GetHandle(), mImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    }
+
+    void Image::CopyFrom(VkCommandBuffer cmd, Image& srcImage, u32 srcMipLevel, u32 dstMipLevel) {
+        if (!IsValid() || !srcImage.IsValid()) {
+            std::cerr << "Cannot copy between invalid images!" << std::endl;
+            return;
+        }
+
+        srcImage.Transition(cmd,
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT,
+                            VK_ACCESS_TRANSFER_READ_BIT,
+                            srcMipLevel,
+                            1);
+        Transition(cmd,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   VK_PIPELINE_STAGE_TRANSFER_BIT,
+                   VK_ACCESS_TRANSFER_WRITE_BIT,
+                   dstMipLevel,
+                   1);
+
+        VkImageCopy region {};
+        region.srcSubresource.aspectMask     = GetAspectMask(srcImage.mDesc.format);
+        region.srcSubresource.mipLevel       = srcMipLevel;
+        region.srcSubresource.baseArrayLayer = 0;
+        region.srcSubresource.layerCount     = srcImage.mDesc.arrayLayers;
+        region.dstSubresource                = region.srcSubresource;
+        region.dstSubresource.mipLevel       = dstMipLevel;
+        region.extent                        = GetExtent(dstMipLevel);
+
+        vkCmdCopyImage(cmd,
+                       srcImage.mImage,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       mImage,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       1,
+                       &region);
+    }
+
+    VkImageLayout Image::GetLayout(u32 mipLevel, u32 layer) const {
+        if (mStates.empty()) return VK_IMAGE_LAYOUT_UNDEFINED;
+        return mStates[mipLevel * mDesc.arrayLayers + layer].layout;
+    }
+
+    VkExtent3D Image::GetExtent(u32 mipLevel) const {
+        return {NE_MAX(mDesc.extent.width >> mipLevel, 1u),
+                NE_MAX(mDesc.extent.height >> mipLevel, 1u),
+                NE_MAX(mDesc.extent.depth >> mipLevel, 1u)};
+    }
+
+    VkDeviceSize Image::GetMemorySize() const {
+        return mAllocation != VK_NULL_HANDLE ? mMemorySize : 0;
+    }
+
+    Buffer::LiveStats Image::GetLiveStats() {
+        Buffer::LiveStats stats;
+        stats.count = sLiveCount;
+        stats.bytes = sLiveBytes;
+        return stats;
+    }
+
+    void Image::ReleaseLiveStats() {
+        sLiveCount--;
+        sLiveBytes -= mMemorySize;
+        mMemorySize = 0;
+    }
+
+    u32 Image::GetMipCount(VkExtent3D extent) {
+        u32 largest = NE_MAX(NE_MAX(extent.width, extent.height), extent.depth);
+        u32 count   = 1;
+        while (largest > 1) {
+            largest >>= 1;
+            count++;
+        }
+        return count;
+    }
+
+    VkImageAspectFlags Image::GetAspectMask(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_D16_UNORM:
+            case VK_FORMAT_X8_D24_UNORM_PACK32:
+            case VK_FORMAT_D32_SFLOAT:
+                return VK_IMAGE_ASPECT_DEPTH_BIT;
+            case VK_FORMAT_S8_UINT:
+                return VK_IMAGE_ASPECT_STENCIL_BIT;
+            case VK_FORMAT_D16_UNORM_S8_UINT:
+            case VK_FORMAT_D24_UNORM_S8_UINT:
+            case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            default:
+                return VK_IMAGE_ASPECT_COLOR_BIT;
+        }
+    }
+
+    void Image::UpdateRelocationTarget(bool relocatable) {
+        mRelocatable = relocatable;
+        if (mAllocation == VK_NULL_HANDLE) return;
+
+        IRelocatable* target = relocatable ? this : nullptr;
+        vmaSetAllocationUserData(mAllocator, mAllocation, target);
+    }
+
+    VkImageCreateInfo Image::GetCreateInfo() const {
+        VkImageCreateInfo imageInfo {};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.flags         = mDesc.flags;
+        imageInfo.imageType     = mDesc.type;
+        imageInfo.format        = mDesc.format;
+        imageInfo.extent        = mDesc.extent;
+        imageInfo.mipLevels     = mDesc.mipLevels;
+        imageInfo.arrayLayers   = mDesc.arrayLayers;
+        imageInfo.samples       = mDesc.samples;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = mDesc.usage;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        return imageInfo;
+    }
+
+    void Image::ResolveRange(u32 baseMip, u32& mipCount, u32 baseLayer, u32& layerCount) const {
+        if (mipCount == VK_REMAINING_MIP_LEVELS) { mipCount = mDesc.mipLevels - baseMip; }
+        if (layerCount == VK_REMAINING_ARRAY_LAYERS) { layerCount = mDesc.arrayLayers - baseLayer; }
+    }
+}  // namespace North::Graphics
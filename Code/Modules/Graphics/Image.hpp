@@ -0,0 +1,258 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+#include "DeletionQueue.hpp"
+#include "Relocatable.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+#include <atomic>
+#include <functional>
+
+namespace North::Graphics {
+    /**
+     * @brief Everything needed to create an Image
+     *
+     * mipLevels = 0 asks for the full chain down to 1x1. Cube maps are 2D images with 6 layers (times the
+     * number of cubes) and VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT.
+     */
+    struct ImageDesc {
+        VkExtent3D extent             = {1, 1, 1};
+        VkFormat format               = VK_FORMAT_R8G8B8A8_UNORM;
+        VkImageUsageFlags usage       = VK_IMAGE_USAGE_SAMPLED_BIT;
+        VkImageType type              = VK_IMAGE_TYPE_2D;
+        VkImageCreateFlags flags      = 0;
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+        u32 mipLevels                 = 1;
+        u32 arrayLayers               = 1;
+    };
+
+    /**
+     * @brief Wrapper around VkImage that handles memory allocation via VMA, the image's views and its layout
+     *
+     * The image counterpart of Buffer, for textures and render targets.
+     *
+     * Views are created the first time a subresource range is asked for and kept until the image is destroyed,
+     * so callers never own a VkImageView.
+     *
+     * Every subresource (mip level x array layer) tracks its layout, its last write (or layout transition) and
+     * the stages and accesses that write has been made visible to since. Transition() compares them with the next
+     * use and only records a barrier when one is actually needed: a layout change, a write, or a read from a
+     * stage or with an access the last write isn't visible to yet. Reads that need nothing are merged into the
+     * tracked state, so later writes still wait on all of them.
+     *
+     * Tracking is per image, not per command buffer: command buffers have to be submitted in the order they
+     * were recorded, which is always the case for the frame loop. When something changes the layout behind
+     * the tracker's back (a render pass's final layout), report it with SetState().
+     *
+     * Example:
+     *   Image texture;
+     *   texture.Create(device, allocator, desc);
+     *   texture.CopyFrom(cmd, staging, 0);  // Moves mip 0 to TRANSFER_DST_OPTIMAL first
+     *   texture.Transition(cmd,
+     *                      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+     *                      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+     *                      VK_ACCESS_SHADER_READ_BIT);
+     *   bindlessTable.RegisterImage(texture.GetView());
+     */
+    class Image final : public IRelocatable {
+    public:
+        Image() = default;
+        ~Image() override;
+
+        // Prevent copying (images own GPU memory)
+        NE_CLASS_PREVENT_COPIES(Image)
+
+        // Allow moving
+        Image(Image&& other) noexcept;
+        Image& operator=(Image&& other) noexcept;
+
+        /// @brief Create the image and allocate its memory. Every subresource starts out UNDEFINED.
+        /// @return false if the image couldn't be created, the Image is left empty
+        bool Create(VkDevice device, VmaAllocator allocator, const ImageDesc& desc);
+
+        /// @brief Destroy the image, its views and its memory right away. The GPU must be done with them.
+        void Destroy();
+
+        /**
+         * @brief Destroy the image and its views once the GPU is done with them
+         *
+         * Same as Buffer::Retire(). The Image object is left empty and can be Create()d again right away.
+         */
+        void Retire(DeletionQueue& deletionQueue);
+
+        /// @brief Retire with an explicit stamp, destroyed once `frameNumber` has completed
+        void Retire(DeletionQueue& deletionQueue, u64 frameNumber);
+
+        /**
+         * @brief Let the Defragmenter move the image to another place in memory
+         *
+         * Same as Buffer::SetRelocatable(). Views are recreated on the new handle, so anything holding on to
+         * a view (a bindless slot) is updated in `onRelocated`. Needs TRANSFER_SRC and TRANSFER_DST usage.
+         */
+        void SetRelocatable(std::function<void()> onRelocated = nullptr);
+
+        /// @brief Copies every subresource to the new image and leaves each one in the layout it was in
+        bool Relocate(VkCommandBuffer cmd, VmaAllocation allocation, DeletionQueue& deletionQueue) override;
+
+        /**
+         * @brief View of a subresource range, created on first use and owned by the image
+         *
+         * @param viewType VK_IMAGE_VIEW_TYPE_MAX_ENUM picks one from the image type and the layer count
+         * @return VK_NULL_HANDLE if the view couldn't be created
+         */
+        VkImageView GetView(u32 baseMip                = 0,
+                            u32 mipCount               = VK_REMAINING_MIP_LEVELS,
+                            u32 baseLayer              = 0,
+                            u32 layerCount             = VK_REMAINING_ARRAY_LAYERS,
+                            VkImageViewType viewType   = VK_IMAGE_VIEW_TYPE_MAX_ENUM,
+                            VkImageAspectFlags aspect  = 0);
+
+        /**
+         * @brief Get a subresource range ready for its next use, recording a barrier only if needed
+         *
+         * @param layout Layout the next use expects
+         * @param stage Pipeline stages of the next use
+         * @param access Accesses of the next use
+         * @return true if a barrier was recorded
+         */
+        bool Transition(VkCommandBuffer cmd,
+                        VkImageLayout layout,
+                        VkPipelineStageFlags stage,
+                        VkAccessFlags access,
+                        u32 baseMip    = 0,
+                        u32 mipCount   = VK_REMAINING_MIP_LEVELS,
+                        u32 baseLayer  = 0,
+                        u32 layerCount = VK_REMAINING_ARRAY_LAYERS);
+
+        /// @brief Record a use the tracker didn't see, e.g. a render pass leaving the image in its final layout
+        void SetState(VkImageLayout layout,
+                      VkPipelineStageFlags stage,
+                      VkAccessFlags access,
+                      u32 baseMip    = 0,
+                      u32 mipCount   = VK_REMAINING_MIP_LEVELS,
+                      u32 baseLayer  = 0,
+                      u32 layerCount = VK_REMAINING_ARRAY_LAYERS);
+
+        /**
+         * @brief Copy tightly packed texels from a buffer into one mip level (GPU-side copy)
+         *
+         * Transitions the level to TRANSFER_DST_OPTIMAL first. The data for every layer follows the previous
+         * one in the buffer.
+         */
+        void CopyFrom(VkCommandBuffer cmd,
+                      const Buffer& srcBuffer,
+                      u32 mipLevel,
+                      u32 baseLayer          = 0,
+                      u32 layerCount         = 1,
+                      VkDeviceSize srcOffset = 0);
+
+        /// @brief Copy one mip level (every layer) out of another image of the same format and level size
+        ///
+        /// Both levels are transitioned for the transfer first, `srcImage` to TRANSFER_SRC_OPTIMAL.
+        void CopyFrom(VkCommandBuffer cmd, Image& srcImage, u32 srcMipLevel, u32 dstMipLevel);
+
+        /// @brief Layout a subresource was last left in
+        NE_ND VkImageLayout GetLayout(u32 mipLevel = 0, u32 layer = 0) const;
+
+        /// @brief Size of a mip level, never smaller than 1 in any dimension
+        NE_ND VkExtent3D GetExtent(u32 mipLevel = 0) const;
+
+        /// @brief Bytes of device memory backing the image, 0 when it isn't created
+        NE_ND VkDeviceSize GetMemorySize() const;
+
+        /// @brief Images that were created and not destroyed or retired yet, across the process
+        static Buffer::LiveStats GetLiveStats();
+
+        /// @brief Number of levels in a full mip chain for this size
+        static u32 GetMipCount(VkExtent3D extent);
+
+        /// @brief Aspects a format has, depth and/or stencil for depth formats, color for everything else
+        static VkImageAspectFlags GetAspectMask(VkFormat format);
+
+        // Getters
+        NE_ND VkImage GetHandle() const {
+            return mImage;
+        }
+        NE_ND VkFormat GetFormat() const {
+            return mDesc.format;
+        }
+        NE_ND u32 GetMipLevels() const {
+            return mDesc.mipLevels;
+        }
+        NE_ND u32 GetArrayLayers() const {
+            return mDesc.arrayLayers;
+        }
+        NE_ND const ImageDesc& GetDesc() const {
+            return mDesc;
+        }
+        NE_ND bool IsValid() const {
+            return mImage != VK_NULL_HANDLE;
+        }
+
+    private:
+        struct SubresourceState {
+            VkImageLayout layout            = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkPipelineStageFlags writeStage = 0;  // Last write or layout transition, what new readers wait on
+            VkAccessFlags writeAccess       = 0;  // 0 when the last thing was a layout transition alone
+            VkPipelineStageFlags readStage  = 0;  // Stages the write is visible to, later writes wait on them
+            VkAccessFlags readAccess        = 0;  // Accesses the write is visible to
+        };
+
+        /// State right after a use, as a write when `access` has write bits and as a visible read otherwise
+        static SubresourceState MakeState(VkImageLayout layout, VkPipelineStageFlags stage, VkAccessFlags access);
+
+        struct ViewKey {
+            VkImageViewType type;
+            VkImageAspectFlags aspect;
+            u32 baseMip;
+            u32 mipCount;
+            u32 baseLayer;
+            u32 layerCount;
+
+            bool operator==(const ViewKey& other) const;
+        };
+
+        struct CachedView {
+            ViewKey key;
+            VkImageView view;
+        };
+
+        NE_ND SubresourceState& GetState(u32 mipLevel, u32 layer) {
+            return mStates[mipLevel * mDesc.arrayLayers + layer];
+        }
+
+        static inline std::atomic<u32> sLiveCount {0};
+        static inline std::atomic<u64> sLiveBytes {0};
+
+        // Take this image out of the live totals, its allocation is about to be freed or handed off
+        void ReleaseLiveStats();
+
+        // Point the allocation's user data back at this object (or at nothing), for the defragmenter
+        void UpdateRelocationTarget(bool relocatable);
+
+        NE_ND VkImageCreateInfo GetCreateInfo() const;
+
+        // Clamp VK_REMAINING_* counts to the image
+        void ResolveRange(u32 baseMip, u32& mipCount, u32 baseLayer, u32& layerCount) const;
+
+        VkDevice mDevice          = VK_NULL_HANDLE;
+        VmaAllocator mAllocator   = nullptr;
+        VkImage mImage            = VK_NULL_HANDLE;
+        VmaAllocation mAllocation = VK_NULL_HANDLE;
+        ImageDesc mDesc;
+        VkDeviceSize mMemorySize = 0;
+
+        vector<SubresourceState> mStates;  // Mip major, one per mip level x array layer
+        vector<CachedView> mViews;         // Images rarely have more than a handful, a linear search is enough
+
+        bool mRelocatable = false;
+        std::function<void()> mOnRelocated;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,573 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#include "IndirectDrawPass.hpp"
+#include "Shader.hpp"
+#include "ShaderReflection.hpp"
+#include "Vertex.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        /// Gribb-Hartmann plane extraction for Vulkan clip space (0 <= z <= w), planes point inwards
+        void ExtractFrustumPlanes(const Mat4x4& m, Vec4 (&planes)[6]) {
+            const Vec4 row0 = {m[0][0], m[1][0], m[2][0], m[3][0]};
+            const Vec4 row1 = {m[0][1], m[1][1], m[2][1], m[3][1]};
+            const Vec4 row2 = {m[0][2], m[1][2], m[2][2], m[3][2]};
+            const Vec4 row3 = {m[0][3], m[1][3], m[2][3], m[3][3]};
+
+            planes[0] = row3 + row0;  // Left
+            planes[1] = row3 - row0;  // Right
+            planes[2] = row3 + row1;  // Bottom
+            planes[3] = row3 - row1;  // Top
+            planes[4] = row2;         // Near
+            planes[5] = row3 - row2;  // Far
+
+            for (auto& plane : planes) {
+                const f32 length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+                if (length > 0) { plane = plane * (1.0f / length); }
+            }
+        }
+    }  // namespace
+
+    bool IndirectDrawPass::Initialize(VkDevice device,
+                                      VmaAllocator allocator,
+                                      DeletionQueue& deletionQueue,
+                                      DescriptorAllocator& descriptorAllocator,
+                                      HiZPyramid& hiZPyramid,
+                                      VkRenderPass renderPass,
+                                      VkRenderPass depthPrepass,
+                                      VkFormat colorFormat,
+                                      VkFormat depthFormat,
+                                      VkDescriptorSetLayout globalLayout,
+                                      VkPipelineCache pipelineCache,
+                                      u32 frameCount) {
+        mDevice              = device;
+        mAllocator           = allocator;
+        mDeletionQueue       = &deletionQueue;
+        mDescriptorAllocator = &descriptorAllocator;
+        mHiZPyramid          = &hiZPyramid;
+        mPipelineCache       = pipelineCache;
+
+        if (!CreateDescriptorSetLayout()) return false;
+        if (!CreateCullPipeline()) return false;
+        if (!CreateMeshPipelines(renderPass, depthPrepass, colorFormat, depthFormat, globalLayout)) return false;
+
+        return Reserve(frameCount);
+    }
+
+    void IndirectDrawPass::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        mFrames.clear();
+
+        vkDestroyPipeline(mDevice, mDepthPrepassPipeline, nullptr);
+        vkDestroyPipeline(mDevice, mMeshPipeline, nullptr);
+        vkDestroyPipelineLayout(mDevice, mMeshPipelineLayout, nullptr);
+        vkDestroyPipeline(mDevice, mCullPipeline, nullptr);
+        vkDestroyPipelineLayout(mDevice, mCullPipelineLayout, nullptr);
+
+        mDepthPrepassPipeline = VK_NULL_HANDLE;
+        mMeshPipeline         = VK_NULL_HANDLE;
+        mMeshPipelineLayout   = VK_NULL_HANDLE;
+        mCullPipeline         = VK_NULL_HANDLE;
+        mCullPipelineLayout   = VK_NULL_HANDLE;
+        mDescriptorSetLayout  = VK_NULL_HANDLE;
+        mHiZPyramid           = nullptr;
+        mDevice               = VK_NULL_HANDLE;
+    }
+
+    bool IndirectDrawPass::Reserve(u32 frameCount) {
+        while (mFrames.size() < frameCount) {
+            mFrames.emplace_back();
+            if (!GrowFrameResources(mFrames.back(), kInitialCapacity)) {
+                std::cerr << "Failed to create indirect draw frame resources!" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void IndirectDrawPass::Prepare(u32 frameIndex, const vector<DrawCommand>& drawCommands) {
+        FrameResources& frame = mFrames[frameIndex];
+        frame.descriptorSet   = VK_NULL_HANDLE;  // Last frame's set went with the slot's pool reset
+        frame.objectCount     = 0;
+        frame.batchCount      = 0;
+        frame.occluderCount   = 0;
+
+        mBatcher.Build(drawCommands);
+        const vector<DrawBatch>& batches = mBatcher.GetBatches();
+        const vector<u32>& instances     = mBatcher.GetInstances();
+        if (instances.empty()) return;
+
+        // Bound whether or not occlusion culling is on, nothing can be drawn without it
+        const VkImageView hiZView = mHiZPyramid->GetView();
+        if (hiZView == VK_NULL_HANDLE) return;
+
+        if (instances.size() > frame.capacity && !GrowFrameResources(frame, CAST<u32>(instances.size()))) { return; }
+
+        // Written straight into mapped memory, flushed below in case it isn't host coherent
+        auto* objects = CAST<GpuObject*>(frame.objects.Map());
+        auto* draws   = CAST<VkDrawIndexedIndirectCommand*>(frame.batches.Map());
+        u32 occluders = 0;
+        for (u32 batchIndex = 0; batchIndex < CAST<u32>(batches.size()); batchIndex++) {
+            const DrawBatch& batch = batches[batchIndex];
+            const Mesh& mesh       = *batch.mesh;
+
+            VkDrawIndexedIndirectCommand& draw = draws[batchIndex];
+            draw.indexCount                    = mesh.geometry.indexCount;
+            draw.instanceCount                 = 0;  // Counted up by the cull shader
+            draw.firstIndex                    = mesh.geometry.firstIndex;
+            draw.vertexOffset                  = CAST<i32>(mesh.geometry.vertexOffset);
+            draw.firstInstance                 = batch.firstInstance;
+
+            for (u32 i = batch.firstInstance; i < batch.firstInstance + batch.instanceCount; i++) {
+                const DrawCommand& command = drawCommands[instances[i]];
+                GpuObject& object          = objects[i];
+                object.model               = command.modelMatrix;
+                object.boundingSphere      = Vec4(mesh.boundsCenter, mesh.boundsRadius);
+                object.batchIndex          = batchIndex;
+                object.flags               = command.occluder ? GpuObject::kOccluder : 0;
+                occluders += command.occluder ? 1 : 0;
+            }
+        }
+        frame.objects.Flush(0, instances.size() * sizeof(GpuObject));
+        frame.batches.Flush(0, batches.size() * sizeof(VkDrawIndexedIndirectCommand));
+
+        // A transient set per frame, so growing the buffers never has to touch a set the GPU may still be using
+        frame.descriptorSet = mDescriptorAllocator->Allocate(mDescriptorSetLayout);
+        if (frame.descriptorSet == VK_NULL_HANDLE) return;
+        WriteDescriptorSet(frame, hiZView);
+
+        frame.objectCount   = CAST<u32>(instances.size());
+        frame.batchCount    = CAST<u32>(batches.size());
+        frame.occluderCount = occluders;
+    }
+
+    void IndirectDrawPass::RecordCull(VkCommandBuffer cmd,
+                                      u32 frameIndex,
+                                      const Mat4x4& viewProjection,
+                                      CullPhase phase,
+                                      bool occlusion) {
+        FrameResources& frame = mFrames[frameIndex];
+        if (frame.objectCount == 0) return;
+
+        // Occluders get their own copy of the draws, right after the main ones
+        const bool occluders = phase == CullPhase::Occluders;
+        const u32 drawOffset = occluders ? frame.batchCount : 0;
+        occlusion            = occlusion && !occluders && mHiZPyramid->IsValid();
+
+        // Start from the batches with zero instances, the shader counts visible instances up with atomics
+        frame.drawCommands.CopyFrom(cmd,
+                                    frame.batches,
+                                    frame.batchCount * sizeof(VkDrawIndexedIndirectCommand),
+                                    0,
+                                    drawOffset * sizeof(VkDrawIndexedIndirectCommand));
+
+        if (occlusion) {
+            auto* data           = CAST<OcclusionData*>(frame.occlusion.Map());
+            data->viewProjection = mHiZPyramid->GetViewProjection();
+            frame.occlusion.Flush(0, sizeof(OcclusionData));
+        }
+
+        // The pyramid is bound either way, so it has to be in the layout the descriptor says
+        mHiZPyramid->PrepareForRead(cmd);
+
+        // Also waits for a depth prepass still reading the visible instances this dispatch overwrites
+        VkMemoryBarrier barrier {};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        CullParams params {};
+        ExtractFrustumPlanes(viewProjection, params.frustumPlanes);
+        params.objectCount = frame.objectCount;
+        params.drawOffset  = drawOffset;
+        params.flags       = (occluders ? kCullOccludersOnly : 0) | (occlusion ? kCullOcclusion : 0);
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mCullPipeline);
+        vkCmdBindDescriptorSets(
+          cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mCullPipelineLayout, 0, 1, &frame.descriptorSet, 0, nullptr);
+        vkCmdPushConstants(cmd, mCullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullParams), &params);
+        vkCmdDispatch(cmd, (frame.objectCount + kWorkgroupSize - 1) / kWorkgroupSize, 1, 1);
+
+        // Draw commands are consumed as indirect arguments, visible instances by the vertex shader
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+    }
+
+    void IndirectDrawPass::RecordDraw(VkCommandBuffer cmd,
+                                      u32 frameIndex,
+                                      const GeometryPool& geometryPool,
+                                      VkDescriptorSet globalSet,
+                                      u32 frameConstantsOffset,
+                                      VkExtent2D extent) {
+        RecordIndirectDraw(
+          cmd, mFrames[frameIndex], mMeshPipeline, 0, geometryPool, globalSet, frameConstantsOffset, extent);
+    }
+
+    void IndirectDrawPass::RecordDepthPrepass(VkCommandBuffer cmd,
+                                              u32 frameIndex,
+                                              const GeometryPool& geometryPool,
+                                              VkDescriptorSet globalSet,
+                                              u32 frameConstantsOffset,
+                                              VkExtent2D extent) {
+        const FrameResources& frame = mFrames[frameIndex];
+        if (frame.occluderCount == 0) return;
+
+        RecordIndirectDraw(cmd,
+                           frame,
+                           mDepthPrepassPipeline,
+                           frame.batchCount,
+                           geometryPool,
+                           globalSet,
+                           frameConstantsOffset,
+                           extent);
+    }
+
+    void IndirectDrawPass::RecordIndirectDraw(VkCommandBuffer cmd,
+                                              const FrameResources& frame,
+                                              VkPipeline pipeline,
+                                              u32 drawOffset,
+                                              const GeometryPool& geometryPool,
+                                              VkDescriptorSet globalSet,
+                                              u32 frameConstantsOffset,
+                                              VkExtent2D extent) const {
+        if (frame.objectCount == 0) return;
+
+        VkViewport viewport {};
+        viewport.x        = 0.0f;
+        viewport.y        = 0.0f;
+        viewport.width    = CAST<f32>(extent.width);
+        viewport.height   = CAST<f32>(extent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+
+        VkRect2D scissor {};
+        scissor.offset = {0, 0};
+        scissor.extent = extent;
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        vkCmdSetViewport(cmd, 0, 1, &viewport);
+        vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+        // Per-object data comes from the storage buffers, so the per-draw uniform binding stays at 0
+        const VkDescriptorSet sets[] = {frame.descriptorSet, globalSet};
+        const u32 dynamicOffsets[]   = {frameConstantsOffset, 0};
+        vkCmdBindDescriptorSets(
+          cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, mMeshPipelineLayout, 0, 2, sets, 2, dynamicOffsets);
+        geometryPool.Bind(cmd);
+
+        // One instanced draw per batch, the GPU decided how many instances each one has
+        vkCmdDrawIndexedIndirect(cmd,
+                                 frame.drawCommands.GetHandle(),
+                                 drawOffset * sizeof(VkDrawIndexedIndirectCommand),
+                                 frame.batchCount,
+                                 sizeof(VkDrawIndexedIndirectCommand));
+    }
+
+    bool IndirectDrawPass::CreateDescriptorSetLayout() {
+        // Set 0 is shared by both pipelines: objects and visible instances are also read by the mesh vertex shader,
+        // so each binding's stages are the union of what the two shaders declare
+        ShaderReflection reflection;
+        ShaderReflection meshReflection;
+        if (!ShaderReflection::Load(ShaderReflection::GetPath("Cull.comp"), reflection) ||
+            !ShaderReflection::Load(ShaderReflection::GetPath("Mesh.vert"), meshReflection)) {
+            return false;
+        }
+        reflection.Merge(meshReflection);
+
+        mDescriptorSetLayout = mDescriptorAllocator->GetLayout(reflection.GetSetBindings(0));
+        if (mDescriptorSetLayout == VK_NULL_HANDLE) {
+            std::cerr << "Failed to create indirect draw descriptor set layout!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool IndirectDrawPass::CreateCullPipeline() {
+        VkPushConstantRange pushConstantRange {};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset     = 0;
+        pushConstantRange.size       = sizeof(CullParams);
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount         = 1;
+        layoutInfo.pSetLayouts            = &mDescriptorSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(mDevice, &layoutInfo, nullptr, &mCullPipelineLayout) != VK_SUCCESS) {
+            std::cerr << "Failed to create cull pipeline layout!" << std::endl;
+            return false;
+        }
+
+        VkShaderModule module = Shader::CreateModule(mDevice, "Cull.comp");
+        if (module == VK_NULL_HANDLE) return false;
+
+        VkComputePipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = module;
+        pipelineInfo.stage.pName  = "main";
+        pipelineInfo.layout       = mCullPipelineLayout;
+
+        const VkResult result =
+          vkCreateComputePipelines(mDevice, mPipelineCache, 1, &pipelineInfo, nullptr, &mCullPipeline);
+        vkDestroyShaderModule(mDevice, module, nullptr);
+
+        if (result != VK_SUCCESS) {
+            std::cerr << "Failed to create cull pipeline!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool IndirectDrawPass::CreateMeshPipelines(VkRenderPass renderPass,
+                                               VkRenderPass depthPrepass,
+                                               VkFormat colorFormat,
+                                               VkFormat depthFormat,
+                                               VkDescriptorSetLayout globalLayout) {
+        const VkDescriptorSetLayout setLayouts[] = {mDescriptorSetLayout, globalLayout};
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 2;
+        layoutInfo.pSetLayouts    = setLayouts;
+
+        if (vkCreatePipelineLayout(mDevice, &layoutInfo, nullptr, &mMeshPipelineLayout) != VK_SUCCESS) {
+            std::cerr << "Failed to create mesh pipeline layout!" << std::endl;
+            return false;
+        }
+
+        VkShaderModule vertexModule   = Shader::CreateModule(mDevice, "Mesh.vert");
+        VkShaderModule fragmentModule = Shader::CreateModule(mDevice, "Mesh.frag");
+        if (vertexModule == VK_NULL_HANDLE || fragmentModule == VK_NULL_HANDLE) {
+            vkDestroyShaderModule(mDevice, vertexModule, nullptr);
+            vkDestroyShaderModule(mDevice, fragmentModule, nullptr);
+            return false;
+        }
+
+        VkPipelineShaderStageCreateInfo stages[2] {};
+        stages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+        stages[0].module = vertexModule;
+        stages[0].pName  = "main";
+        stages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+        stages[1].module = fragmentModule;
+        stages[1].pName  = "main";
+
+        VkVertexInputBindingDescription binding {};
+        binding.binding   = 0;
+        binding.stride    = sizeof(Vertex);
+        binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+        VkVertexInputAttributeDescription attributes[3] {};
+        attributes[0] = {0, 0, VK_FORMAT_R32G32B32_SFLOAT, CAST<u32>(offsetof(Vertex, position))};
+        attributes[1] = {1, 0, VK_FORMAT_R32G32B32_SFLOAT, CAST<u32>(offsetof(Vertex, normal))};
+        attributes[2] = {2, 0, VK_FORMAT_R32G32_SFLOAT, CAST<u32>(offsetof(Vertex, uv))};
+
+        VkPipelineVertexInputStateCreateInfo vertexInput {};
+        vertexInput.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount   = 1;
+        vertexInput.pVertexBindingDescriptions      = &binding;
+        vertexInput.vertexAttributeDescriptionCount = 3;
+        vertexInput.pVertexAttributeDescriptions    = attributes;
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
+        inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // Viewport and scissor are dynamic so the pipeline survives swapchain resizes
+        VkPipelineViewportStateCreateInfo viewportState {};
+        viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount  = 1;
+
+        VkPipelineRasterizationStateCreateInfo rasterizer {};
+        rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizer.cullMode    = VK_CULL_MODE_BACK_BIT;
+        rasterizer.frontFace   = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterizer.lineWidth   = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisampling {};
+        multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        // LESS_OR_EQUAL so occluders drawn again on top of their own prepass depth still pass
+        VkPipelineDepthStencilStateCreateInfo depthStencil {};
+        depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable  = VK_TRUE;
+        depthStencil.depthWriteEnable = VK_TRUE;
+        depthStencil.depthCompareOp   = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+        VkPipelineColorBlendAttachmentState blendAttachment {};
+        blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                         VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+        VkPipelineColorBlendStateCreateInfo colorBlend {};
+        colorBlend.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlend.attachmentCount = 1;
+        colorBlend.pAttachments    = &blendAttachment;
+
+        const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        VkPipelineDynamicStateCreateInfo dynamicState {};
+        dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates    = dynamicStates;
+
+        // Without a render pass the attachment formats are all the pipeline needs to know
+        VkPipelineRenderingCreateInfo renderingInfo {};
+        renderingInfo.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        renderingInfo.colorAttachmentCount    = 1;
+        renderingInfo.pColorAttachmentFormats = &colorFormat;
+        renderingInfo.depthAttachmentFormat   = depthFormat;
+
+        VkGraphicsPipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.pNext               = renderPass == VK_NULL_HANDLE ? &renderingInfo : nullptr;
+        pipelineInfo.stageCount          = 2;
+        pipelineInfo.pStages             = stages;
+        pipelineInfo.pVertexInputState   = &vertexInput;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState      = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState   = &multisampling;
+        pipelineInfo.pDepthStencilState  = &depthStencil;
+        pipelineInfo.pColorBlendState    = &colorBlend;
+        pipelineInfo.pDynamicState       = &dynamicState;
+        pipelineInfo.layout              = mMeshPipelineLayout;
+        pipelineInfo.renderPass          = renderPass;
+        pipelineInfo.subpass             = 0;
+
+        VkResult result = vkCreateGraphicsPipelines(mDevice, mPipelineCache, 1, &pipelineInfo, nullptr, &mMeshPipeline);
+
+        // The depth prepass only needs the vertex shader and depth writes, with nothing equal to test against yet
+        if (result == VK_SUCCESS) {
+            colorBlend.attachmentCount         = 0;
+            depthStencil.depthCompareOp        = VK_COMPARE_OP_LESS;
+            renderingInfo.colorAttachmentCount = 0;
+            pipelineInfo.stageCount            = 1;
+            pipelineInfo.pNext                 = depthPrepass == VK_NULL_HANDLE ? &renderingInfo : nullptr;
+            pipelineInfo.renderPass            = depthPrepass;
+
+            result =
+              vkCreateGraphicsPipelines(mDevice, mPipelineCache, 1, &pipelineInfo, nullptr, &mDepthPrepassPipeline);
+        }
+
+        vkDestroyShaderModule(mDevice, vertexModule, nullptr);
+        vkDestroyShaderModule(mDevice, fragmentModule, nullptr);
+
+        if (result != VK_SUCCESS) {
+            std::cerr << "Failed to create mesh pipelines!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool IndirectDrawPass::GrowFrameResources(FrameResources& frame, u32 objectCount) {
+        const u32 capacity = NE_MAX(objectCount, frame.capacity * 2);
+
+        // Only called once the slot's last frame has completed, but retiring keeps that an optimization
+        // rather than a requirement
+        frame.objects.Retire(*mDeletionQueue);
+        frame.batches.Retire(*mDeletionQueue);
+        frame.drawCommands.Retire(*mDeletionQueue);
+        frame.visibleInstances.Retire(*mDeletionQueue);
+
+        // Doesn't depend on the capacity, only created once
+        if (!frame.occlusion.IsValid()) {
+            frame.occlusion.Create(
+              mAllocator, sizeof(OcclusionData), Buffer::Type::Uniform, Buffer::MemoryUsage::CPU_To_GPU);
+        }
+
+        // There are never more batches than objects
+        const VkDeviceSize drawsSize = CAST<VkDeviceSize>(capacity) * sizeof(VkDrawIndexedIndirectCommand);
+        frame.objects.Create(mAllocator,
+                             CAST<VkDeviceSize>(capacity) * sizeof(GpuObject),
+                             Buffer::Type::Storage,
+                             Buffer::MemoryUsage::CPU_To_GPU);
+        frame.batches.Create(mAllocator, drawsSize, Buffer::Type::Staging, Buffer::MemoryUsage::CPU_To_GPU);
+        frame.drawCommands.Create(mAllocator, drawsSize * 2, Buffer::Type::Indirect, Buffer::MemoryUsage::GPU_Only);
+        frame.visibleInstances.Create(mAllocator,
+                                      CAST<VkDeviceSize>(capacity) * sizeof(u32),
+                                      Buffer::Type::Storage,
+                                      Buffer::MemoryUsage::GPU_Only);
+
+        if (!frame.objects.IsValid() || !frame.batches.IsValid() || !frame.drawCommands.IsValid() ||
+            !frame.visibleInstances.IsValid() || !frame.occlusion.IsValid()) {
+            std::cerr << "Failed to grow indirect draw buffers to " << capacity << " objects!" << std::endl;
+            frame.capacity = 0;
+            return false;
+        }
+
+        frame.capacity = capacity;
+        return true;
+    }
+
+    void IndirectDrawPass::WriteDescriptorSet(const FrameResources& frame, VkImageView hiZView) const {
+        // Storage buffers at 0-2, the occlusion uniforms at 4
+        const u32 bufferBindings[4] = {0, 1, 2, 4};
+        VkDescriptorBufferInfo bufferInfos[4] {};
+        bufferInfos[0] = {frame.objects.GetHandle(), 0, VK_WHOLE_SIZE};
+        bufferInfos[1] = {frame.drawCommands.GetHandle(), 0, VK_WHOLE_SIZE};
+        bufferInfos[2] = {frame.visibleInstances.GetHandle(), 0, VK_WHOLE_SIZE};
+        bufferInfos[3] = {frame.occlusion.GetHandle(), 0, sizeof(OcclusionData)};
+
+        VkDescriptorImageInfo hiZInfo {};
+        hiZInfo.sampler     = mHiZPyramid->GetSampler();
+        hiZInfo.imageView   = hiZView;
+        hiZInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet writes[5] {};
+        for (u32 i = 0; i < 4; i++) {
+            writes[i].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet          = frame.descriptorSet;
+            writes[i].dstBinding      = bufferBindings[i];
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType  = i < 3 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            writes[i].pBufferInfo     = &bufferInfos[i];
+        }
+        writes[4].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[4].dstSet          = frame.descriptorSet;
+        writes[4].dstBinding      = 3;
+        writes[4].descriptorCount = 1;
+        writes[4].descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[4].pImageInfo      = &hiZInfo;
+
+        vkUpdateDescriptorSets(mDevice, 5, writes, 0, nullptr);
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,203 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+#include "DeletionQueue.hpp"
+#include "DescriptorAllocator.hpp"
+#include "DrawBatcher.hpp"
+#include "GeometryPool.hpp"
+#include "HiZPyramid.hpp"
+#include "RenderCommand.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace North::Graphics {
+    /// @brief Per-object data read by the culling shader and the mesh vertex shader (std430 layout)
+    struct GpuObject {
+        static constexpr u32 kOccluder = 1u << 0;  // Drawn into the depth prepass, see DrawCommand::occluder
+
+        Mat4x4 model;
+        Vec4 boundingSphere;  // xyz center (model space), w radius
+        u32 batchIndex;       // Instanced draw this object belongs to
+        u32 flags;
+        u32 _padding[2];
+    };
+
+    /// @brief Which objects a cull dispatch looks at and which draws it fills in
+    enum class CullPhase : u8 {
+        Occluders,  ///< Frustum culls the occluders into the depth prepass's draws
+        Main,       ///< Every object into the main draws, also tested against the Hi-Z pyramid when asked to
+    };
+
+    /**
+     * @brief GPU-driven drawing of everything in the geometry pool
+     *
+     * Each frame's draw commands are batched by mesh (DrawBatcher) and written to a storage buffer as
+     * GpuObjects, grouped by batch. Every batch gets one VkDrawIndexedIndirectCommand starting with zero
+     * instances. A compute shader (Cull.comp) frustum culls the objects and appends the visible ones to their
+     * batch's instance range, and the whole frame is then drawn with a single vkCmdDrawIndexedIndirect, one
+     * instanced draw per mesh. The CPU only copies object data, its cost no longer depends on how many draws or
+     * state changes the frame has.
+     *
+     * Occlusion culling tests every object's projected bounds against a HiZPyramid, which is either the previous
+     * frame's depth (reprojected through the camera it was rendered with) or, when the frame has occluders, the
+     * depth of a prepass that only draws those: a first cull dispatch frustum culls the occluders into their own
+     * set of draw commands, RecordDepthPrepass() draws them depth-only and the pyramid is built from that before
+     * the main dispatch culls everything against it. Hidden objects are never submitted, let alone shaded.
+     *
+     * Every frame in flight has its own buffers, so writing the next frame's objects never races the GPU still
+     * reading the previous one. Their descriptor set is a transient one from the DescriptorAllocator, rewritten
+     * every frame.
+     */
+    class IndirectDrawPass {
+    public:
+        IndirectDrawPass() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(IndirectDrawPass)
+
+        /**
+         * @param hiZPyramid Pyramid occlusion culling tests against, bound in every frame's descriptor set
+         * @param renderPass Render pass the mesh pipeline draws in (subpass 0), VK_NULL_HANDLE with dynamic rendering
+         * @param depthPrepass Depth-only render pass of the prepass pipeline, VK_NULL_HANDLE with dynamic rendering
+         * @param colorFormat Color attachment format, what the pipeline is built against without a render pass
+         * @param depthFormat Depth attachment format, same
+         * @param globalLayout Layout of the uniform ring's global set, bound as set 1 of the mesh pipeline
+         * @param pipelineCache Cache the pipelines are built through, may be VK_NULL_HANDLE
+         * @param frameCount Frames in flight, each gets its own buffers
+         * @return false if the shaders couldn't be loaded or a pipeline failed to build
+         */
+        bool Initialize(VkDevice device,
+                        VmaAllocator allocator,
+                        DeletionQueue& deletionQueue,
+                        DescriptorAllocator& descriptorAllocator,
+                        HiZPyramid& hiZPyramid,
+                        VkRenderPass renderPass,
+                        VkRenderPass depthPrepass,
+                        VkFormat colorFormat,
+                        VkFormat depthFormat,
+                        VkDescriptorSetLayout globalLayout,
+                        VkPipelineCache pipelineCache,
+                        u32 frameCount);
+        void Shutdown();
+
+        /// @brief Grow to at least `frameCount` per-frame slots
+        bool Reserve(u32 frameCount);
+
+        /// @brief Write the frame's draw commands to its object buffer and allocate its descriptor set. The slot's
+        /// previous frame must be complete and the descriptor allocator must have begun this frame.
+        void Prepare(u32 frameIndex, const vector<DrawCommand>& drawCommands);
+
+        /// @brief Whether any of the frame's objects are occluders, worth a depth prepass
+        NE_ND bool HasOccluders(u32 frameIndex) const {
+            return mFrames[frameIndex].occluderCount > 0;
+        }
+
+        /**
+         * @brief Record a culling dispatch, outside of a render pass
+         *
+         * @param occlusion Also test against the Hi-Z pyramid, ignored while it isn't valid
+         */
+        void RecordCull(VkCommandBuffer cmd,
+                        u32 frameIndex,
+                        const Mat4x4& viewProjection,
+                        CullPhase phase = CullPhase::Main,
+                        bool occlusion  = false);
+
+        /// @brief Record the depth-only draw of the occluders culled by the CullPhase::Occluders dispatch, inside
+        /// the depth prepass
+        void RecordDepthPrepass(VkCommandBuffer cmd,
+                                u32 frameIndex,
+                                const GeometryPool& geometryPool,
+                                VkDescriptorSet globalSet,
+                                u32 frameConstantsOffset,
+                                VkExtent2D extent);
+
+        /// @brief Record the indirect draw, inside the render pass
+        /// @param frameConstantsOffset Dynamic offset of this frame's FrameConstants in `globalSet`
+        void RecordDraw(VkCommandBuffer cmd,
+                        u32 frameIndex,
+                        const GeometryPool& geometryPool,
+                        VkDescriptorSet globalSet,
+                        u32 frameConstantsOffset,
+                        VkExtent2D extent);
+
+        NE_ND bool Initialized() const {
+            return mCullPipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        struct FrameResources {
+            Buffer objects;           // GpuObject[capacity], persistently mapped
+            Buffer batches;           // VkDrawIndexedIndirectCommand[capacity] with zero instances, persistently mapped
+            Buffer drawCommands;      // Two copies of batches (main, occluders), instance counts filled in by culling
+            Buffer visibleInstances;  // u32[capacity], object index of every visible instance in batch order
+            Buffer occlusion;         // OcclusionData, persistently mapped
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;  // Allocated for the current frame only
+            u32 capacity                  = 0;
+            u32 objectCount               = 0;
+            u32 batchCount                = 0;
+            u32 occluderCount             = 0;
+        };
+
+        // Cull.comp's push constants, everything per dispatch
+        struct CullParams {
+            Vec4 frustumPlanes[6];
+            u32 objectCount;
+            u32 drawOffset;
+            u32 flags;
+        };
+
+        // Cull.comp's uniform block, too large for the push constants next to the planes
+        struct OcclusionData {
+            Mat4x4 viewProjection;
+        };
+
+        static constexpr u32 kCullOccludersOnly = 1u << 0;  // Flags in Cull.comp
+        static constexpr u32 kCullOcclusion     = 1u << 1;
+
+        static constexpr u32 kWorkgroupSize   = 64;  // local_size_x in Cull.comp
+        static constexpr u32 kInitialCapacity = 1024;
+
+        bool CreateDescriptorSetLayout();
+        bool CreateCullPipeline();
+        bool CreateMeshPipelines(VkRenderPass renderPass,
+                                 VkRenderPass depthPrepass,
+                                 VkFormat colorFormat,
+                                 VkFormat depthFormat,
+                                 VkDescriptorSetLayout globalLayout);
+        bool GrowFrameResources(FrameResources& frame, u32 objectCount);
+        void WriteDescriptorSet(const FrameResources& frame, VkImageView hiZView) const;
+
+        // Bind `pipeline` with the frame's sets and draw the batches' commands starting at `drawOffset`
+        void RecordIndirectDraw(VkCommandBuffer cmd,
+                                const FrameResources& frame,
+                                VkPipeline pipeline,
+                                u32 drawOffset,
+                                const GeometryPool& geometryPool,
+                                VkDescriptorSet globalSet,
+                                u32 frameConstantsOffset,
+                                VkExtent2D extent) const;
+
+        VkDevice mDevice                          = VK_NULL_HANDLE;
+        VmaAllocator mAllocator                   = VK_NULL_HANDLE;
+        DeletionQueue* mDeletionQueue             = nullptr;
+        DescriptorAllocator* mDescriptorAllocator = nullptr;
+        HiZPyramid* mHiZPyramid                   = nullptr;
+        VkPipelineCache mPipelineCache            = VK_NULL_HANDLE;
+
+        VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;  // Owned by the descriptor allocator
+        VkPipelineLayout mCullPipelineLayout       = VK_NULL_HANDLE;
+        VkPipeline mCullPipeline                   = VK_NULL_HANDLE;
+        VkPipelineLayout mMeshPipelineLayout       = VK_NULL_HANDLE;
+        VkPipeline mMeshPipeline                   = VK_NULL_HANDLE;
+        VkPipeline mDepthPrepassPipeline           = VK_NULL_HANDLE;  // Same layout, no fragment shader
+
+        vector<FrameResources> mFrames;
+        DrawBatcher mBatcher;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,109 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "MemoryStats.hpp"
+#include "Image.hpp"
+
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        constexpr f64 kMegabyte = 1024.0 * 1024.0;
+
+        f64 ToMegabytes(VkDeviceSize bytes) {
+            return CAST<f64>(bytes) / kMegabyte;
+        }
+    }  // namespace
+
+    MemoryStats MemoryReport::Collect(VmaAllocator allocator) {
+        MemoryStats stats;
+
+        const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+        vmaGetMemoryProperties(allocator, &properties);
+
+        VmaBudget budgets[VK_MAX_MEMORY_HEAPS] {};
+        vmaGetHeapBudgets(allocator, budgets);
+
+        for (u32 i = 0; i < properties->memoryHeapCount; i++) {
+            HeapMemoryStats heap;
+            heap.size            = properties->memoryHeaps[i].size;
+            heap.budget          = budgets[i].budget;
+            heap.usage           = budgets[i].usage;
+            heap.blockBytes      = budgets[i].statistics.blockBytes;
+            heap.allocationBytes = budgets[i].statistics.allocationBytes;
+            heap.blockCount      = budgets[i].statistics.blockCount;
+            heap.allocationCount = budgets[i].statistics.allocationCount;
+            heap.deviceLocal     = properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+            stats.heaps.push_back(heap);
+        }
+
+        for (u32 type = 0; type < Buffer::kTypeCount; type++) {
+            stats.buffers[type] = Buffer::GetLiveStats(CAST<Buffer::Type>(type));
+        }
+        stats.images = Image::GetLiveStats();
+
+        // Walks every block, fine for a stats readout but not something to do every frame
+        VmaTotalStatistics totals {};
+        vmaCalculateStatistics(allocator, &totals);
+
+        const VmaDetailedStatistics& total = totals.total;
+        stats.allocationCount              = total.statistics.allocationCount;
+        stats.allocationBytes              = total.statistics.allocationBytes;
+        stats.blockBytes                   = total.statistics.blockBytes;
+
+        const VkDeviceSize unusedBytes = total.statistics.blockBytes - total.statistics.allocationBytes;
+        if (unusedBytes > 0 && total.unusedRangeCount > 0) {
+            stats.fragmentation = 1.0f - CAST<f32>(CAST<f64>(total.unusedRangeSizeMax) / CAST<f64>(unusedBytes));
+        }
+
+        return stats;
+    }
+
+    string MemoryReport::BuildJson(VmaAllocator allocator, bool detailed) {
+        char* json = nullptr;
+        vmaBuildStatsString(allocator, &json, detailed ? VK_TRUE : VK_FALSE);
+
+        string result = json ? json : "";
+        vmaFreeStatsString(allocator, json);
+        return result;
+    }
+
+    void MemoryReport::Print(const MemoryStats& stats, std::ostream& out) {
+        out << "GPU memory: " << stats.allocationCount << " allocations, " << ToMegabytes(stats.allocationBytes)
+            << " MB in " << ToMegabytes(stats.blockBytes) << " MB of blocks (" << stats.fragmentation * 100.0f
+            << "% fragmented)" << std::endl;
+
+        for (size_t i = 0; i < stats.heaps.size(); i++) {
+            const HeapMemoryStats& heap = stats.heaps[i];
+            if (heap.blockCount == 0 && heap.usage == 0) continue;
+
+            out << "  Heap " << i << (heap.deviceLocal ? " (device local)" : "") << ": "
+                << ToMegabytes(heap.usage) << " / " << ToMegabytes(heap.budget) << " MB budget, "
+                << heap.allocationCount << " allocations in " << heap.blockCount << " blocks" << std::endl;
+        }
+
+        for (u32 type = 0; type < Buffer::kTypeCount; type++) {
+            const Buffer::LiveStats& buffers = stats.buffers[type];
+            if (buffers.count == 0) continue;
+
+            out << "  " << Buffer::GetTypeName(CAST<Buffer::Type>(type)) << "s: " << buffers.count << " ("
+                << ToMegabytes(buffers.bytes) << " MB)" << std::endl;
+        }
+        if (stats.images.count > 0) {
+            out << "  Images: " << stats.images.count << " (" << ToMegabytes(stats.images.bytes) << " MB)"
+                << std::endl;
+        }
+    }
+
+    bool MemoryReport::ReportLeaks(VmaAllocator allocator) {
+        const MemoryStats stats = Collect(allocator);
+        if (stats.allocationCount == 0) return true;
+
+        std::cerr << "Leaked " << stats.allocationCount << " GPU allocations (" << stats.allocationBytes
+                  << " bytes) still alive at shutdown" << std::endl;
+        Print(stats, std::cerr);
+        std::cerr << BuildJson(allocator, true) << std::endl;
+        return false;
+    }
+}  // namespace North::Graphics
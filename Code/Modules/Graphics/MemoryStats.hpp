@@ -0,0 +1,68 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+#include <array>
+#include <ostream>
+
+namespace North::Graphics {
+    struct HeapMemoryStats {
+        VkDeviceSize size            = 0;  // As reported by the device
+        VkDeviceSize budget          = 0;  // How much this process may use, from VK_EXT_memory_budget when present
+        VkDeviceSize usage           = 0;  // Everything this process has allocated from it, not only through VMA
+        VkDeviceSize blockBytes      = 0;  // VkDeviceMemory blocks VMA allocated
+        VkDeviceSize allocationBytes = 0;  // Parts of those blocks handed out
+        u32 blockCount               = 0;
+        u32 allocationCount          = 0;
+        bool deviceLocal             = false;
+    };
+
+    /// @brief Snapshot of GPU memory, see MemoryReport::Collect()
+    struct MemoryStats {
+        vector<HeapMemoryStats> heaps;
+        std::array<Buffer::LiveStats, Buffer::kTypeCount> buffers {};  // Indexed by Buffer::Type
+        Buffer::LiveStats images;
+
+        u32 allocationCount          = 0;
+        VkDeviceSize allocationBytes = 0;
+        VkDeviceSize blockBytes      = 0;
+
+        /// 0 when the free space in blocks is one contiguous range, approaching 1 as it's split into small ones
+        f32 fragmentation = 0;
+    };
+
+    /**
+     * @brief Reads GPU memory statistics out of VMA
+     *
+     * Every Buffer and Image names its allocation (Buffer::GetTypeName(), "Image", "Render target"), so the JSON
+     * from BuildJson(allocator, true) tells what each allocation is. Per-type counts come from the live totals
+     * Buffer and Image keep, which drop as soon as an allocation is destroyed or handed to the deletion queue.
+     */
+    class MemoryReport {
+    public:
+        static MemoryStats Collect(VmaAllocator allocator);
+
+        /// @brief vmaBuildStatsString(), `detailed` adds every allocation and free range of every block
+        static string BuildJson(VmaAllocator allocator, bool detailed);
+
+        static void Print(const MemoryStats& stats, std::ostream& out);
+
+        /**
+         * @brief Report allocations still alive, right before the allocator is destroyed
+         *
+         * Prints the totals, the live counts by type and the detailed JSON (which names every leaked allocation)
+         * to stderr.
+         *
+         * @return true if nothing leaked
+         */
+        static bool ReportLeaks(VmaAllocator allocator);
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,43 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#include "Mesh.hpp"
+#include <cmath>
+
+namespace North::Graphics {
+    bool Mesh::Create(GeometryPool& pool, const vector<Vertex>& vertices, const vector<Index>& indices) {
+        if (vertices.empty()) return false;
+
+        geometry = pool.Allocate(CAST<u32>(vertices.size()), CAST<u32>(indices.size()));
+        if (!geometry.IsValid()) return false;
+
+        pool.Upload(geometry, vertices.data(), indices.empty() ? nullptr : indices.data());
+
+        // Sphere around the AABB center, not the tightest fit but cheap and good enough for culling
+        Vec3 min = vertices[0].position;
+        Vec3 max = vertices[0].position;
+        for (const auto& vertex : vertices) {
+            for (i32 axis = 0; axis < 3; axis++) {
+                min[axis] = NE_MIN(min[axis], vertex.position[axis]);
+                max[axis] = NE_MAX(max[axis], vertex.position[axis]);
+            }
+        }
+        boundsCenter = (min + max) * 0.5f;
+
+        f32 radiusSquared = 0;
+        for (const auto& vertex : vertices) {
+            const Vec3 offset = vertex.position - boundsCenter;
+            radiusSquared     = NE_MAX(radiusSquared, offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+        }
+        boundsRadius = std::sqrt(radiusSquared);
+
+        return true;
+    }
+
+    void Mesh::Destroy(GeometryPool& pool) {
+        pool.Free(geometry);
+        boundsCenter = {0, 0, 0};
+        boundsRadius = 0;
+    }
+}  // namespace North::Graphics
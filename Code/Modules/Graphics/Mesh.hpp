@@ -0,0 +1,29 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "GeometryPool.hpp"
+#include "Vertex.hpp"
+
+namespace North::Graphics {
+    /// @brief Mesh data living in the geometry pool, plus the bounds used for culling
+    struct Mesh {
+        GeometryAllocation geometry;
+        Vec3 boundsCenter {0, 0, 0};  // Model space
+        f32 boundsRadius = 0;
+
+        /// @brief Allocate space in the pool, compute bounds and queue the upload
+        /// @return false if the pool is out of space
+        bool Create(GeometryPool& pool, const vector<Vertex>& vertices, const vector<Index>& indices);
+
+        /// @brief Release the pool range once in-flight frames are done with it
+        void Destroy(GeometryPool& pool);
+
+        NE_ND bool IsValid() const {
+            return geometry.IsValid();
+        }
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,263 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "MipGenerator.hpp"
+#include "ShaderReflection.hpp"
+
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        constexpr const char* kShaderName = "Downsample.comp";
+        constexpr u32 kTileLevels         = 6;  // Levels a workgroup reduces its 64x64 tile through
+
+        /// Order the counter buffer's previous use before the next dispatch reads and resets it
+        void CounterBarrier(VkCommandBuffer cmd,
+                            VkBuffer buffer,
+                            VkPipelineStageFlags srcStage,
+                            VkAccessFlags srcAccess) {
+            VkBufferMemoryBarrier barrier {};
+            barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask       = srcAccess;
+            barrier.dstAccessMask       = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer              = buffer;
+            barrier.offset              = 0;
+            barrier.size                = VK_WHOLE_SIZE;
+
+            vkCmdPipelineBarrier(
+              cmd, srcStage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+        }
+    }  // namespace
+
+    bool MipGenerator::Initialize(VkDevice device,
+                                  VmaAllocator allocator,
+                                  DescriptorAllocator& descriptorAllocator,
+                                  ShaderLibrary& shaderLibrary,
+                                  VkPipelineCache pipelineCache) {
+        mDevice              = device;
+        mDescriptorAllocator = &descriptorAllocator;
+
+        ShaderReflection reflection;
+        if (!ShaderReflection::Load(ShaderReflection::GetPath(kShaderName), reflection)) return false;
+
+        mDescriptorSetLayout = mDescriptorAllocator->GetLayout(reflection.GetSetBindings(0));
+        if (mDescriptorSetLayout == VK_NULL_HANDLE) return false;
+
+        VkPushConstantRange pushConstantRange {};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset     = 0;
+        pushConstantRange.size       = sizeof(DownsampleParams);
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount         = 1;
+        layoutInfo.pSetLayouts            = &mDescriptorSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(mDevice, &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            std::cerr << "Failed to create downsample pipeline layout!" << std::endl;
+            return false;
+        }
+
+        // The HDR variant is optional, rgba16f images fall back to blits without it
+        u64 hdrVariant                 = 0;
+        const bool hasHdr              = shaderLibrary.GetVariantMask(kShaderName, {"HDR"}, hdrVariant);
+        const VkShaderModule modules[] = {
+          shaderLibrary.GetModule(kShaderName),
+          hasHdr ? shaderLibrary.GetModule(kShaderName, hdrVariant) : VK_NULL_HANDLE,
+        };
+
+        for (u32 i = 0; i < 2; i++) {
+            if (modules[i] == VK_NULL_HANDLE) continue;
+
+            VkComputePipelineCreateInfo pipelineInfo {};
+            pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineInfo.stage.module = modules[i];
+            pipelineInfo.stage.pName  = "main";
+            pipelineInfo.layout       = mPipelineLayout;
+
+            if (vkCreateComputePipelines(mDevice, pipelineCache, 1, &pipelineInfo, nullptr, &mPipelines[i]) !=
+                VK_SUCCESS) {
+                std::cerr << "Failed to create downsample pipeline!" << std::endl;
+                mPipelines[i] = VK_NULL_HANDLE;
+            }
+        }
+        if (mPipelines[0] == VK_NULL_HANDLE) return false;
+
+        mCounters.Create(allocator, kMaxLayers * sizeof(u32), Buffer::Type::Storage, Buffer::MemoryUsage::GPU_Only);
+        mCountersCleared = false;
+        mCountersUsed    = false;
+
+        return mCounters.IsValid();
+    }
+
+    void MipGenerator::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        mCounters.Destroy();
+        for (auto& pipeline : mPipelines) {
+            vkDestroyPipeline(mDevice, pipeline, nullptr);
+            pipeline = VK_NULL_HANDLE;
+        }
+        vkDestroyPipelineLayout(mDevice, mPipelineLayout, nullptr);
+
+        mPipelineLayout      = VK_NULL_HANDLE;
+        mDescriptorSetLayout = VK_NULL_HANDLE;
+        mDevice              = VK_NULL_HANDLE;
+    }
+
+    void MipGenerator::Generate(VkCommandBuffer cmd, Image& image) {
+        if (!GenerateCompute(cmd, image)) { GenerateBlit(cmd, image); }
+    }
+
+    bool MipGenerator::GenerateCompute(VkCommandBuffer cmd, Image& image) {
+        if (!SupportsCompute(image)) return false;
+
+        const u32 levels = image.GetMipLevels();
+        const u32 layers = image.GetArrayLayers();
+        if (levels < 2) return true;
+
+        if (!mCountersCleared) {
+            vkCmdFillBuffer(cmd, mCounters.GetHandle(), 0, VK_WHOLE_SIZE, 0);
+            CounterBarrier(cmd, mCounters.GetHandle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+            mCountersCleared = true;
+            mCountersUsed    = false;
+        }
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, GetPipeline(image.GetFormat()));
+
+        for (u32 base = 0; base + 1 < levels;) {
+            const VkExtent3D extent = image.GetExtent(base);
+
+            // The last workgroup can only finish the chain when every tile's final texel fits in one more tile
+            const bool singleTile = NE_MAX(extent.width, extent.height) <= kTileSize * kTileSize;
+            const u32 mipCount    = NE_MIN(levels - 1 - base, singleTile ? kMaxMipsPerDispatch : kTileLevels);
+            const u32 groupsX     = (extent.width + kTileSize - 1) / kTileSize;
+            const u32 groupsY     = (extent.height + kTileSize - 1) / kTileSize;
+
+            VkDescriptorSet set = mDescriptorAllocator->Allocate(mDescriptorSetLayout);
+            if (set == VK_NULL_HANDLE) return false;
+
+            // Entries past mipCount repeat the last level written, the shader never touches them
+            VkDescriptorImageInfo imageInfos[kMaxMipsPerDispatch + 1] {};
+            for (u32 i = 0; i <= kMaxMipsPerDispatch; i++) {
+                imageInfos[i].imageView =
+                  image.GetView(base + NE_MIN(i, mipCount), 1, 0, layers, VK_IMAGE_VIEW_TYPE_2D_ARRAY);
+                imageInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            }
+
+            VkDescriptorBufferInfo bufferInfo {};
+            bufferInfo.buffer = mCounters.GetHandle();
+            bufferInfo.offset = 0;
+            bufferInfo.range  = VK_WHOLE_SIZE;
+
+            VkWriteDescriptorSet writes[2] {};
+            writes[0].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[0].dstSet          = set;
+            writes[0].dstBinding      = 0;
+            writes[0].descriptorCount = kMaxMipsPerDispatch + 1;
+            writes[0].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[0].pImageInfo      = imageInfos;
+            writes[1].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[1].dstSet          = set;
+            writes[1].dstBinding      = 1;
+            writes[1].descriptorCount = 1;
+            writes[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[1].pBufferInfo     = &bufferInfo;
+            vkUpdateDescriptorSets(mDevice, 2, writes, 0, nullptr);
+
+            // The source level is only read, written levels are also read back by the last workgroup
+            image.Transition(
+              cmd, VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, base, 1);
+            image.Transition(cmd,
+                             VK_IMAGE_LAYOUT_GENERAL,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                             base + 1,
+                             mipCount);
+            if (mCountersUsed) {
+                CounterBarrier(
+                  cmd, mCounters.GetHandle(), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT);
+                mCountersUsed = false;
+            }
+
+            const DownsampleParams params {mipCount, groupsX * groupsY};
+            vkCmdBindDescriptorSets(
+              cmd, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, 1, &set, 0, nullptr);
+            vkCmdPushConstants(
+              cmd, mPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(DownsampleParams), &params);
+            vkCmdDispatch(cmd, groupsX, groupsY, layers);
+
+            mCountersUsed = mipCount > kTileLevels;
+            base += mipCount;
+        }
+
+        return true;
+    }
+
+    void MipGenerator::GenerateBlit(VkCommandBuffer cmd, Image& image) {
+        const VkImageAspectFlags aspect = Image::GetAspectMask(image.GetFormat());
+        const u32 layers                = image.GetArrayLayers();
+
+        for (u32 level = 1; level < image.GetMipLevels(); level++) {
+            image.Transition(cmd,
+                             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_ACCESS_TRANSFER_READ_BIT,
+                             level - 1,
+                             1);
+            image.Transition(cmd,
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_ACCESS_TRANSFER_WRITE_BIT,
+                             level,
+                             1);
+
+            const VkExtent3D src = image.GetExtent(level - 1);
+            const VkExtent3D dst = image.GetExtent(level);
+
+            VkImageBlit blit {};
+            blit.srcSubresource.aspectMask     = aspect;
+            blit.srcSubresource.mipLevel       = level - 1;
+            blit.srcSubresource.baseArrayLayer = 0;
+            blit.srcSubresource.layerCount     = layers;
+            blit.srcOffsets[1]                 = {CAST<i32>(src.width), CAST<i32>(src.height), CAST<i32>(src.depth)};
+            blit.dstSubresource                = blit.srcSubresource;
+            blit.dstSubresource.mipLevel       = level;
+            blit.dstOffsets[1]                 = {CAST<i32>(dst.width), CAST<i32>(dst.height), CAST<i32>(dst.depth)};
+
+            vkCmdBlitImage(cmd,
+                           image.GetHandle(),
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           image.GetHandle(),
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1,
+                           &blit,
+                           VK_FILTER_LINEAR);
+        }
+    }
+
+    bool MipGenerator::SupportsCompute(const Image& image) const {
+        const ImageDesc& desc = image.GetDesc();
+        return Initialized() && GetPipeline(desc.format) != VK_NULL_HANDLE &&
+               (desc.usage & VK_IMAGE_USAGE_STORAGE_BIT) != 0 && desc.type == VK_IMAGE_TYPE_2D &&
+               desc.arrayLayers <= kMaxLayers;
+    }
+
+    VkPipeline MipGenerator::GetPipeline(VkFormat format) const {
+        switch (format) {
+            case VK_FORMAT_R8G8B8A8_UNORM:
+                return mPipelines[0];
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+                return mPipelines[1];
+            default:
+                return VK_NULL_HANDLE;
+        }
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,83 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+#include "DescriptorAllocator.hpp"
+#include "Image.hpp"
+#include "ShaderLibrary.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace North::Graphics {
+    /**
+     * @brief Fills in the mip chain of an image from its first level
+     *
+     * The compute path (Downsample.comp) writes up to kMaxMipsPerDispatch levels in a single dispatch: each
+     * workgroup reduces a 64x64 tile through shared memory and the last one to finish reduces the tiles' results,
+     * instead of one blit and one barrier per level. It handles R8G8B8A8_UNORM and, when its HDR variant was
+     * built, R16G16B16A16_SFLOAT images created with STORAGE usage. Everything else goes through the blit chain,
+     * which needs TRANSFER_SRC and TRANSFER_DST usage and a format that supports linear filtering.
+     *
+     * Levels are left as the generation wrote them (GENERAL for compute, TRANSFER_DST/SRC for blits), the
+     * image's tracked state takes care of the barrier to whatever reads them next.
+     */
+    class MipGenerator {
+    public:
+        static constexpr u32 kMaxMipsPerDispatch = 12;
+        static constexpr u32 kTileSize           = 64;
+        static constexpr u32 kMaxLayers          = 2048;
+
+        MipGenerator() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(MipGenerator)
+
+        /// @param pipelineCache Cache the pipelines are built through, may be VK_NULL_HANDLE
+        /// @return false if the shader couldn't be loaded, only the blit chain is available then
+        bool Initialize(VkDevice device,
+                        VmaAllocator allocator,
+                        DescriptorAllocator& descriptorAllocator,
+                        ShaderLibrary& shaderLibrary,
+                        VkPipelineCache pipelineCache);
+        void Shutdown();
+
+        /// @brief Generate levels 1 and up from level 0, with compute when the image supports it
+        void Generate(VkCommandBuffer cmd, Image& image);
+
+        /// @brief Compute path only. Descriptor sets come from the current frame's DescriptorAllocator slot.
+        /// @return false (nothing recorded) if the image's format or usage doesn't allow it
+        bool GenerateCompute(VkCommandBuffer cmd, Image& image);
+
+        /// @brief One vkCmdBlitImage and barrier per level, for any image with transfer usage
+        static void GenerateBlit(VkCommandBuffer cmd, Image& image);
+
+        NE_ND bool SupportsCompute(const Image& image) const;
+
+        NE_ND bool Initialized() const {
+            return mPipelines[0] != VK_NULL_HANDLE;
+        }
+
+    private:
+        struct DownsampleParams {
+            u32 mipCount;
+            u32 workGroupCount;
+        };
+
+        // Pipeline per shader variant, [1] is the HDR (rgba16f) one
+        NE_ND VkPipeline GetPipeline(VkFormat format) const;
+
+        VkDevice mDevice                           = VK_NULL_HANDLE;
+        DescriptorAllocator* mDescriptorAllocator  = nullptr;
+        VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;  // Owned by the descriptor allocator
+        VkPipelineLayout mPipelineLayout           = VK_NULL_HANDLE;
+        VkPipeline mPipelines[2]                   = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+
+        Buffer mCounters;               // u32[kMaxLayers], zero between dispatches
+        bool mCountersCleared = false;  // Filled with zeros by the first dispatch
+        bool mCountersUsed    = false;  // A dispatch may have reset them since, the next one has to wait
+    };
+}  // namespace North::Graphics
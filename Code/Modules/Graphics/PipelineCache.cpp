@@ -0,0 +1,206 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "PipelineCache.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        /// FNV-1a, only meant to catch truncated or corrupted files
+        u64 Checksum(const u8* data, size_t size) {
+            u64 hash = 14695981039346656037ull;
+            for (size_t i = 0; i < size; i++) {
+                hash ^= data[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    }  // namespace
+
+    bool PipelineCache::Initialize(VkDevice device, VkPhysicalDevice physicalDevice, const fs::path& path) {
+        mDevice = device;
+        mPath   = path;
+        mStats  = {};
+
+        VkPhysicalDeviceIDProperties idProperties {};
+        idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 properties {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &idProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+        mProperties = properties.properties;
+        std::memcpy(mDriverUuid, idProperties.driverUUID, VK_UUID_SIZE);
+
+        const vector<u8> data = mPath.empty() ? vector<u8> {} : Load();
+
+        VkPipelineCacheCreateInfo createInfo {};
+        createInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData    = data.empty() ? nullptr : data.data();
+
+        if (vkCreatePipelineCache(mDevice, &createInfo, nullptr, &mCache) != VK_SUCCESS) {
+            std::cerr << "Failed to create pipeline cache!" << std::endl;
+            return false;
+        }
+
+        mStats.warm        = !data.empty();
+        mStats.loadedBytes = data.size();
+        mSavedBytes        = data.size();
+        return true;
+    }
+
+    void PipelineCache::Shutdown() {
+        if (mCache == VK_NULL_HANDLE) return;
+
+        Save();
+        vkDestroyPipelineCache(mDevice, mCache, nullptr);
+        mCache  = VK_NULL_HANDLE;
+        mDevice = VK_NULL_HANDLE;
+    }
+
+    void PipelineCache::Update(f64 now, ThreadPool& threadPool) {
+        if (mLastSaveTime == 0) { mLastSaveTime = now; }
+        if (now - mLastSaveTime < kSaveInterval) return;
+        mLastSaveTime = now;
+
+        if (mSaving.exchange(true)) return;
+
+        // The cache can be read while pipelines are being created into it, no need to hold up the render thread
+        threadPool.Enqueue([this] {
+            // Only worth writing if new pipelines made it into the cache
+            size_t size = 0;
+            if (vkGetPipelineCacheData(mDevice, mCache, &size, nullptr) == VK_SUCCESS && size != mSavedBytes) {
+                Save();
+            }
+            mSaving = false;
+        });
+    }
+
+    bool PipelineCache::Save() {
+        if (mCache == VK_NULL_HANDLE || mPath.empty()) return false;
+
+        size_t size = 0;
+        if (vkGetPipelineCacheData(mDevice, mCache, &size, nullptr) != VK_SUCCESS) { return false; }
+
+        vector<u8> data(size);
+        if (vkGetPipelineCacheData(mDevice, mCache, &size, data.data()) != VK_SUCCESS) { return false; }
+        data.resize(size);
+
+        FileHeader header = MakeHeader();
+        header.dataSize   = data.size();
+        header.checksum   = Checksum(data.data(), data.size());
+
+        std::error_code error;
+        fs::create_directories(mPath.parent_path(), error);
+
+        // Write next to the real file and swap it in, readers only ever see a complete cache
+        fs::path tempPath = mPath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "Failed to write pipeline cache: " << tempPath.string() << std::endl;
+                return false;
+            }
+            file.write(RCAST<const char*>(&header), sizeof(header));
+            file.write(RCAST<const char*>(data.data()), CAST<std::streamsize>(data.size()));
+            if (!file.good()) {
+                std::cerr << "Failed to write pipeline cache: " << tempPath.string() << std::endl;
+                return false;
+            }
+        }
+
+        fs::rename(tempPath, mPath, error);
+        if (error) {
+            std::cerr << "Failed to replace pipeline cache: " << error.message() << std::endl;
+            fs::remove(tempPath, error);
+            return false;
+        }
+
+        mSavedBytes = data.size();
+        return true;
+    }
+
+    fs::path PipelineCache::GetDefaultPath() {
+        fs::path base;
+#if defined(_WIN32)
+        if (const char* localAppData = std::getenv("LOCALAPPDATA")) { base = localAppData; }
+#elif defined(__APPLE__)
+        if (const char* home = std::getenv("HOME")) { base = fs::path(home) / "Library" / "Caches"; }
+#else
+        if (const char* xdgCache = std::getenv("XDG_CACHE_HOME"); xdgCache && *xdgCache) {
+            base = xdgCache;
+        } else if (const char* home = std::getenv("HOME")) {
+            base = fs::path(home) / ".cache";
+        }
+#endif
+        if (base.empty()) { base = fs::temp_directory_path(); }
+        return base / "North" / "PipelineCache.bin";
+    }
+
+    PipelineCache::FileHeader PipelineCache::MakeHeader() const {
+        FileHeader header {};
+        header.magic         = kMagic;
+        header.version       = kVersion;
+        header.vendorId      = mProperties.vendorID;
+        header.deviceId      = mProperties.deviceID;
+        header.driverVersion = mProperties.driverVersion;
+        std::memcpy(header.driverUuid, mDriverUuid, VK_UUID_SIZE);
+        std::memcpy(header.pipelineCacheUuid, mProperties.pipelineCacheUUID, VK_UUID_SIZE);
+        return header;
+    }
+
+    vector<u8> PipelineCache::Load() const {
+        std::ifstream file(mPath, std::ios::binary);
+        if (!file.is_open()) return {};  // First run
+
+        FileHeader header {};
+        file.read(RCAST<char*>(&header), sizeof(header));
+
+        const FileHeader expected = MakeHeader();
+        if (!file.good() || header.magic != kMagic || header.version != kVersion) {
+            std::cout << "Ignoring pipeline cache with an unknown format" << std::endl;
+            return {};
+        }
+        if (header.vendorId != expected.vendorId || header.deviceId != expected.deviceId ||
+            header.driverVersion != expected.driverVersion ||
+            std::memcmp(header.driverUuid, expected.driverUuid, VK_UUID_SIZE) != 0 ||
+            std::memcmp(header.pipelineCacheUuid, expected.pipelineCacheUuid, VK_UUID_SIZE) != 0) {
+            std::cout << "Ignoring pipeline cache from a different GPU or driver" << std::endl;
+            return {};
+        }
+
+        std::error_code error;
+        const u64 fileSize = fs::file_size(mPath, error);
+        if (error || header.dataSize != fileSize - sizeof(header)) {
+            std::cout << "Ignoring truncated or corrupted pipeline cache" << std::endl;
+            return {};
+        }
+
+        vector<u8> data(header.dataSize);
+        file.read(RCAST<char*>(data.data()), CAST<std::streamsize>(data.size()));
+        if (!file.good() || Checksum(data.data(), data.size()) != header.checksum) {
+            std::cout << "Ignoring truncated or corrupted pipeline cache" << std::endl;
+            return {};
+        }
+
+        // The driver's own header has to agree as well
+        VkPipelineCacheHeaderVersionOne driverHeader {};
+        if (data.size() < sizeof(driverHeader)) return {};
+        std::memcpy(&driverHeader, data.data(), sizeof(driverHeader));
+        if (driverHeader.vendorID != expected.vendorId || driverHeader.deviceID != expected.deviceId ||
+            std::memcmp(driverHeader.pipelineCacheUUID, expected.pipelineCacheUuid, VK_UUID_SIZE) != 0) {
+            std::cout << "Ignoring pipeline cache with a mismatched driver header" << std::endl;
+            return {};
+        }
+
+        return data;
+    }
+}  // namespace North::Graphics
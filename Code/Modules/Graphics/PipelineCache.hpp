@@ -0,0 +1,104 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Common/ThreadPool.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+
+namespace North::Graphics {
+    /// @brief How the last startup went, to compare cold (empty cache) and warm starts
+    struct PipelineCacheStats {
+        bool warm              = false;  // Loaded a valid cache from disk
+        u64 loadedBytes        = 0;
+        u64 savedBytes         = 0;
+        f64 pipelineCreationMs = 0;  // Time spent building the startup pipelines
+    };
+
+    /**
+     * @brief VkPipelineCache persisted to disk between runs
+     *
+     * The file starts with our own header identifying the GPU (vendor, device, driver version and UUID,
+     * pipeline cache UUID) plus the payload size and a checksum. A file from another GPU or driver, or a
+     * truncated or corrupted one, is ignored and the cache starts empty, since feeding one to the driver is
+     * undefined at best.
+     *
+     * Saves go to a temporary file that is renamed over the old one, so a crash mid-save never leaves a
+     * half-written cache behind. Besides Shutdown(), Update() saves periodically when the cache has grown, on a
+     * worker thread so the driver's serialization and the file write never stall a frame.
+     */
+    class PipelineCache {
+    public:
+        static constexpr f64 kSaveInterval = 60.0;  // Seconds
+
+        PipelineCache() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(PipelineCache)
+
+        /// @param path Cache file, empty keeps the cache in memory only
+        bool Initialize(VkDevice device, VkPhysicalDevice physicalDevice, const fs::path& path);
+
+        /// @brief Saves one last time. The pool Update() was given has to be stopped first.
+        void Shutdown();
+
+        /// @brief Every kSaveInterval, queue a save on `threadPool` that only writes if the cache has changed.
+        /// Skipped while the previous one is still running.
+        void Update(f64 now, ThreadPool& threadPool);
+
+        bool Save();
+
+        /// @brief <user cache directory>/North/PipelineCache.bin
+        static fs::path GetDefaultPath();
+
+        NE_ND VkPipelineCache GetHandle() const {
+            return mCache;
+        }
+
+        NE_ND PipelineCacheStats GetStats() const {
+            PipelineCacheStats stats = mStats;
+            stats.savedBytes         = mSavedBytes;
+            return stats;
+        }
+
+        /// @brief Adds to the startup pipeline creation time reported in the stats
+        void RecordPipelineCreation(f64 milliseconds) {
+            mStats.pipelineCreationMs += milliseconds;
+        }
+
+    private:
+        struct FileHeader {
+            u32 magic;
+            u32 version;
+            u32 vendorId;
+            u32 deviceId;
+            u32 driverVersion;
+            u8 driverUuid[VK_UUID_SIZE];
+            u8 pipelineCacheUuid[VK_UUID_SIZE];
+            u64 dataSize;
+            u64 checksum;
+        };
+
+        static constexpr u32 kMagic   = 0x4350454E;  // "NEPC"
+        static constexpr u32 kVersion = 1;
+
+        FileHeader MakeHeader() const;
+        vector<u8> Load() const;
+
+        VkDevice mDevice       = VK_NULL_HANDLE;
+        VkPipelineCache mCache = VK_NULL_HANDLE;
+        fs::path mPath;
+
+        VkPhysicalDeviceProperties mProperties {};
+        u8 mDriverUuid[VK_UUID_SIZE] {};
+
+        f64 mLastSaveTime = 0;
+        PipelineCacheStats mStats;  // savedBytes lives in mSavedBytes, the save task writes it
+        std::atomic<u64> mSavedBytes {0};
+        std::atomic<bool> mSaving {false};
+    };
+}  // namespace North::Graphics
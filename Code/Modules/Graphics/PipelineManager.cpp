@@ -0,0 +1,292 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "PipelineManager.hpp"
+#include "Common/Clock.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        void HashCombine(u64& seed, u64 value) {
+            seed ^= value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+        }
+
+        VkPipelineColorBlendAttachmentState MakeBlendState(BlendMode mode) {
+            VkPipelineColorBlendAttachmentState state {};
+            state.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+                                   VK_COLOR_COMPONENT_A_BIT;
+            if (mode == BlendMode::Opaque) return state;
+
+            // Additive just sums, alpha blending weights the destination by the source's coverage
+            const bool alpha          = mode == BlendMode::Alpha;
+            state.blendEnable         = VK_TRUE;
+            state.srcColorBlendFactor = alpha ? VK_BLEND_FACTOR_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
+            state.dstColorBlendFactor = alpha ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
+            state.colorBlendOp        = VK_BLEND_OP_ADD;
+            state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            state.dstAlphaBlendFactor = alpha ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
+            state.alphaBlendOp        = VK_BLEND_OP_ADD;
+            return state;
+        }
+    }  // namespace
+
+    u64 GraphicsPipelineDesc::Hash() const {
+        u64 hash = 0;
+        HashCombine(hash, std::hash<string> {}(vertexShader));
+        HashCombine(hash, std::hash<string> {}(fragmentShader));
+        HashCombine(hash, vertexVariant);
+        HashCombine(hash, fragmentVariant);
+        for (const auto& constant : specialization) {
+            HashCombine(hash, constant.id);
+            HashCombine(hash, constant.value);
+        }
+
+        // Field by field, Vulkan structs may contain padding
+        for (const auto& binding : vertexBindings) {
+            HashCombine(hash, binding.binding);
+            HashCombine(hash, binding.stride);
+            HashCombine(hash, binding.inputRate);
+        }
+        for (const auto& attribute : vertexAttributes) {
+            HashCombine(hash, attribute.location);
+            HashCombine(hash, attribute.binding);
+            HashCombine(hash, attribute.format);
+            HashCombine(hash, attribute.offset);
+        }
+
+        HashCombine(hash, topology);
+        HashCombine(hash, polygonMode);
+        HashCombine(hash, cullMode);
+        HashCombine(hash, frontFace);
+        HashCombine(hash, CAST<u64>(blendMode));
+        HashCombine(hash, depthTest);
+        HashCombine(hash, depthWrite);
+        HashCombine(hash, depthCompare);
+        HashCombine(hash, RCAST<uptr>(renderPass));
+        HashCombine(hash, subpass);
+        for (const auto format : colorFormats) {
+            HashCombine(hash, format);
+        }
+        HashCombine(hash, depthFormat);
+        HashCombine(hash, RCAST<uptr>(layout));
+        return hash;
+    }
+
+    bool GraphicsPipelineDesc::operator==(const GraphicsPipelineDesc& other) const {
+        const auto sameBindings = [](const VkVertexInputBindingDescription& a,
+                                     const VkVertexInputBindingDescription& b) {
+            return a.binding == b.binding && a.stride == b.stride && a.inputRate == b.inputRate;
+        };
+        const auto sameAttributes = [](const VkVertexInputAttributeDescription& a,
+                                       const VkVertexInputAttributeDescription& b) {
+            return a.location == b.location && a.binding == b.binding && a.format == b.format && a.offset == b.offset;
+        };
+
+        return vertexShader == other.vertexShader && fragmentShader == other.fragmentShader &&
+               vertexVariant == other.vertexVariant && fragmentVariant == other.fragmentVariant &&
+               specialization == other.specialization &&
+               std::equal(vertexBindings.begin(),
+                          vertexBindings.end(),
+                          other.vertexBindings.begin(),
+                          other.vertexBindings.end(),
+                          sameBindings) &&
+               std::equal(vertexAttributes.begin(),
+                          vertexAttributes.end(),
+                          other.vertexAttributes.begin(),
+                          other.vertexAttributes.end(),
+                          sameAttributes) &&
+               topology == other.topology && polygonMode == other.polygonMode && cullMode == other.cullMode &&
+               frontFace == other.frontFace && blendMode == other.blendMode && depthTest == other.depthTest &&
+               depthWrite == other.depthWrite && depthCompare == other.depthCompare &&
+               renderPass == other.renderPass && subpass == other.subpass && colorFormats == other.colorFormats &&
+               depthFormat == other.depthFormat && layout == other.layout;
+    }
+
+    void PipelineManager::Initialize(VkDevice device,
+                                     VkPipelineCache pipelineCache,
+                                     ShaderLibrary& shaderLibrary,
+                                     ThreadPool& threadPool) {
+        mDevice        = device;
+        mPipelineCache = pipelineCache;
+        mShaderLibrary = &shaderLibrary;
+        mThreadPool    = &threadPool;
+    }
+
+    void PipelineManager::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        WaitIdle();
+        for (auto& [desc, entry] : mEntries) {
+            vkDestroyPipeline(mDevice, entry->pipeline, nullptr);
+        }
+        mEntries.clear();
+
+        mDevice = VK_NULL_HANDLE;
+    }
+
+    VkPipeline PipelineManager::Request(const GraphicsPipelineDesc& desc, VkPipeline fallback) {
+        if (auto it = mEntries.find(desc); it != mEntries.end()) {
+            mHits++;
+            const Entry& entry = *it->second;
+            return entry.state.load(std::memory_order_acquire) == State::Ready ? entry.pipeline : fallback;
+        }
+
+        mMisses++;
+        Entry* entry = mEntries.emplace(desc, make_unique<Entry>()).first->second.get();
+
+        // The description is copied into the task, the caller's may be gone by the time it runs
+        mThreadPool->Enqueue([this, entry, desc] {
+            const f64 start         = Clock::Now();
+            const VkPipeline result = Compile(desc);
+            mCompileTimeUs += CAST<u64>((Clock::Now() - start) * 1000000.0);
+
+            if (result == VK_NULL_HANDLE) {
+                mFailed++;
+                entry->state.store(State::Failed, std::memory_order_release);
+                return;
+            }
+
+            mCompiled++;
+            entry->pipeline = result;
+            entry->state.store(State::Ready, std::memory_order_release);
+        });
+
+        return entry->state.load(std::memory_order_acquire) == State::Ready ? entry->pipeline : fallback;
+    }
+
+    void PipelineManager::WaitIdle() {
+        if (mThreadPool) { mThreadPool->WaitIdle(); }
+    }
+
+    PipelineManagerStats PipelineManager::GetStats() const {
+        PipelineManagerStats stats;
+        stats.hits          = mHits;
+        stats.misses        = mMisses;
+        stats.compiled      = mCompiled.load();
+        stats.failed        = mFailed.load();
+        stats.compileTimeMs = CAST<f64>(mCompileTimeUs.load()) / 1000.0;
+        return stats;
+    }
+
+    VkPipeline PipelineManager::Compile(const GraphicsPipelineDesc& desc) const {
+        // Modules are shared through the library, variants with identical code reuse the same one
+        VkShaderModule vertexModule   = mShaderLibrary->GetModule(desc.vertexShader, desc.vertexVariant);
+        VkShaderModule fragmentModule = mShaderLibrary->GetModule(desc.fragmentShader, desc.fragmentVariant);
+        if (vertexModule == VK_NULL_HANDLE || fragmentModule == VK_NULL_HANDLE) return VK_NULL_HANDLE;
+
+        // One 4-byte entry per constant, stages ignore the ids they don't declare
+        vector<VkSpecializationMapEntry> mapEntries;
+        vector<u32> constantData;
+        for (const auto& constant : desc.specialization) {
+            mapEntries.push_back({constant.id, CAST<u32>(constantData.size() * sizeof(u32)), sizeof(u32)});
+            constantData.push_back(constant.value);
+        }
+
+        VkSpecializationInfo specializationInfo {};
+        specializationInfo.mapEntryCount = CAST<u32>(mapEntries.size());
+        specializationInfo.pMapEntries   = mapEntries.data();
+        specializationInfo.dataSize      = constantData.size() * sizeof(u32);
+        specializationInfo.pData         = constantData.data();
+
+        const VkSpecializationInfo* specialization = mapEntries.empty() ? nullptr : &specializationInfo;
+
+        VkPipelineShaderStageCreateInfo stages[2] {};
+        stages[0].sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[0].stage               = VK_SHADER_STAGE_VERTEX_BIT;
+        stages[0].module              = vertexModule;
+        stages[0].pName               = "main";
+        stages[0].pSpecializationInfo = specialization;
+        stages[1].sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stages[1].stage               = VK_SHADER_STAGE_FRAGMENT_BIT;
+        stages[1].module              = fragmentModule;
+        stages[1].pName               = "main";
+        stages[1].pSpecializationInfo = specialization;
+
+        VkPipelineVertexInputStateCreateInfo vertexInput {};
+        vertexInput.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount   = CAST<u32>(desc.vertexBindings.size());
+        vertexInput.pVertexBindingDescriptions      = desc.vertexBindings.data();
+        vertexInput.vertexAttributeDescriptionCount = CAST<u32>(desc.vertexAttributes.size());
+        vertexInput.pVertexAttributeDescriptions    = desc.vertexAttributes.data();
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
+        inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = desc.topology;
+
+        VkPipelineViewportStateCreateInfo viewportState {};
+        viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount  = 1;
+
+        VkPipelineRasterizationStateCreateInfo rasterizer {};
+        rasterizer.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.polygonMode = desc.polygonMode;
+        rasterizer.cullMode    = desc.cullMode;
+        rasterizer.frontFace   = desc.frontFace;
+        rasterizer.lineWidth   = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisampling {};
+        multisampling.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencil {};
+        depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable  = desc.depthTest ? VK_TRUE : VK_FALSE;
+        depthStencil.depthWriteEnable = desc.depthWrite ? VK_TRUE : VK_FALSE;
+        depthStencil.depthCompareOp   = desc.depthCompare;
+
+        // One attachment per color format with dynamic rendering, render passes used here have a single one
+        const u32 colorCount = desc.renderPass != VK_NULL_HANDLE ? 1 : CAST<u32>(desc.colorFormats.size());
+        const vector<VkPipelineColorBlendAttachmentState> blendAttachments(colorCount, MakeBlendState(desc.blendMode));
+
+        VkPipelineColorBlendStateCreateInfo colorBlend {};
+        colorBlend.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlend.attachmentCount = colorCount;
+        colorBlend.pAttachments    = blendAttachments.data();
+
+        const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        VkPipelineDynamicStateCreateInfo dynamicState {};
+        dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates    = dynamicStates;
+
+        VkPipelineRenderingCreateInfo renderingInfo {};
+        renderingInfo.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        renderingInfo.colorAttachmentCount    = CAST<u32>(desc.colorFormats.size());
+        renderingInfo.pColorAttachmentFormats = desc.colorFormats.data();
+        renderingInfo.depthAttachmentFormat   = desc.depthFormat;
+
+        VkGraphicsPipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.pNext               = desc.renderPass == VK_NULL_HANDLE ? &renderingInfo : nullptr;
+        pipelineInfo.stageCount          = 2;
+        pipelineInfo.pStages             = stages;
+        pipelineInfo.pVertexInputState   = &vertexInput;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState      = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState   = &multisampling;
+        pipelineInfo.pDepthStencilState  = &depthStencil;
+        pipelineInfo.pColorBlendState    = &colorBlend;
+        pipelineInfo.pDynamicState       = &dynamicState;
+        pipelineInfo.layout              = desc.layout;
+        pipelineInfo.renderPass          = desc.renderPass;
+        pipelineInfo.subpass             = desc.subpass;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        const VkResult result =
+          vkCreateGraphicsPipelines(mDevice, mPipelineCache, 1, &pipelineInfo, nullptr, &pipeline);
+
+        if (result != VK_SUCCESS) {
+            std::cerr << "Failed to compile pipeline (" << desc.vertexShader << ", " << desc.fragmentShader << ")"
+                      << std::endl;
+            return VK_NULL_HANDLE;
+        }
+
+        return pipeline;
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,135 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Common/ThreadPool.hpp"
+#include "ShaderLibrary.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <atomic>
+#include <unordered_map>
+
+namespace North::Graphics {
+    enum class BlendMode : u8 { Opaque, Alpha, Additive };
+
+    /// @brief Value of a `layout(constant_id = id)` constant, applied to every stage that declares it
+    struct SpecializationConstant {
+        u32 id;
+        u32 value;  // bools are 0 or 1, floats are passed by their bit pattern
+
+        bool operator==(const SpecializationConstant& other) const {
+            return id == other.id && value == other.value;
+        }
+    };
+
+    /// @brief Everything that goes into a graphics pipeline. Two equal descriptions always map to the same VkPipeline.
+    struct GraphicsPipelineDesc {
+        string vertexShader;  // Compiled shader names, see Shader::GetCompiledPath()
+        string fragmentShader;
+        u64 vertexVariant   = 0;  // Compile-time feature masks, see ShaderVariantTable
+        u64 fragmentVariant = 0;
+        vector<SpecializationConstant> specialization;
+        vector<VkVertexInputBindingDescription> vertexBindings;
+        vector<VkVertexInputAttributeDescription> vertexAttributes;
+
+        VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        VkPolygonMode polygonMode    = VK_POLYGON_MODE_FILL;
+        VkCullModeFlags cullMode     = VK_CULL_MODE_BACK_BIT;
+        VkFrontFace frontFace        = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        BlendMode blendMode          = BlendMode::Opaque;
+
+        bool depthTest           = false;
+        bool depthWrite          = false;
+        VkCompareOp depthCompare = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+        /// Render pass compatibility, or the attachment formats when drawing with dynamic rendering (no render pass)
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        u32 subpass             = 0;
+        vector<VkFormat> colorFormats;
+        VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+
+        NE_ND u64 Hash() const;
+        bool operator==(const GraphicsPipelineDesc& other) const;
+
+        struct Hasher {
+            size_t operator()(const GraphicsPipelineDesc& desc) const {
+                return CAST<size_t>(desc.Hash());
+            }
+        };
+    };
+
+    struct PipelineManagerStats {
+        u64 hits          = 0;
+        u64 misses        = 0;
+        u64 compiled      = 0;
+        u64 failed        = 0;
+        f64 compileTimeMs = 0;  // Summed over worker threads
+    };
+
+    /**
+     * @brief Hash-keyed cache of graphics pipelines compiled off the render thread
+     *
+     * Request() looks a description up by its full hash. A miss queues the compile on the thread pool and returns
+     * the fallback (or VK_NULL_HANDLE, meaning skip the draw) until the pipeline is ready, so a material seen for
+     * the first time never stalls the frame on shader compilation. Compiles go through the pipeline cache, which
+     * is internally synchronized.
+     *
+     * Request() is meant for the render thread only; workers touch nothing but their own entry.
+     */
+    class PipelineManager {
+    public:
+        PipelineManager() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(PipelineManager)
+
+        void Initialize(VkDevice device,
+                        VkPipelineCache pipelineCache,
+                        ShaderLibrary& shaderLibrary,
+                        ThreadPool& threadPool);
+
+        /// @brief Waits for in-flight compiles, then destroys every pipeline. The GPU must be idle.
+        void Shutdown();
+
+        /// @return The pipeline if it's ready, otherwise `fallback` while it compiles (or if it failed)
+        VkPipeline Request(const GraphicsPipelineDesc& desc, VkPipeline fallback = VK_NULL_HANDLE);
+
+        /// @brief Block until every queued compile has finished, e.g. behind a loading screen
+        void WaitIdle();
+
+        NE_ND PipelineManagerStats GetStats() const;
+
+        NE_ND size_t GetPipelineCount() const {
+            return mEntries.size();
+        }
+
+    private:
+        enum class State : u8 { Pending, Ready, Failed };
+
+        struct Entry {
+            std::atomic<State> state {State::Pending};
+            VkPipeline pipeline = VK_NULL_HANDLE;  // Written by the worker before state becomes Ready
+        };
+
+        VkPipeline Compile(const GraphicsPipelineDesc& desc) const;
+
+        VkDevice mDevice               = VK_NULL_HANDLE;
+        VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+        ShaderLibrary* mShaderLibrary  = nullptr;
+        ThreadPool* mThreadPool        = nullptr;
+
+        std::unordered_map<GraphicsPipelineDesc, unique_ptr<Entry>, GraphicsPipelineDesc::Hasher> mEntries;
+        u64 mHits   = 0;
+        u64 mMisses = 0;
+
+        // Updated by workers
+        std::atomic<u64> mCompiled {0};
+        std::atomic<u64> mFailed {0};
+        std::atomic<u64> mCompileTimeUs {0};
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,121 @@
+// Author: Jake Rieger
+// Created: 11/20/25.
+//
+
+#include "ReadbackQueue.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace North::Graphics {
+    void ReadbackQueue::Initialize(VmaAllocator allocator, u32 slotCount) {
+        mAllocator = allocator;
+        mSlots.clear();
+        mSlots.resize(slotCount);
+    }
+
+    void ReadbackQueue::Shutdown() {
+        // Anything still pending is discarded, the buffers go back to VMA
+        mSlots.clear();
+        mAllocator = VK_NULL_HANDLE;
+    }
+
+    void ReadbackQueue::Reserve(u32 slotCount) {
+        if (mSlots.size() < slotCount) { mSlots.resize(slotCount); }
+    }
+
+    bool ReadbackQueue::RecordCopy(
+      VkCommandBuffer cmd, VkImage image, VkExtent2D extent, VkFormat format, u64 frameNumber) {
+        Slot* slot = nullptr;
+        for (auto& candidate : mSlots) {
+            if (!candidate.pending) {
+                slot = &candidate;
+                break;
+            }
+        }
+
+        if (!slot) {
+            std::cerr << "Readback queue full, dropping capture of frame " << frameNumber << std::endl;
+            return false;
+        }
+
+        // Buffers are kept between captures and only reallocated when the image size changes
+        const VkDeviceSize size = CAST<VkDeviceSize>(extent.width) * extent.height * kBytesPerPixel;
+        if (!slot->buffer.IsValid() || slot->buffer.GetSize() != size) {
+            slot->buffer.Create(mAllocator, size, Buffer::Type::Readback, Buffer::MemoryUsage::GPU_To_CPU);
+            if (!slot->buffer.IsValid()) { return false; }
+        }
+
+        VkBufferImageCopy region {};
+        region.bufferOffset                    = 0;
+        region.bufferRowLength                 = 0;  // Tightly packed
+        region.bufferImageHeight               = 0;
+        region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel       = 0;
+        region.imageSubresource.baseArrayLayer = 0;
+        region.imageSubresource.layerCount     = 1;
+        region.imageOffset                     = {0, 0, 0};
+        region.imageExtent                     = {extent.width, extent.height, 1};
+
+        vkCmdCopyImageToBuffer(
+          cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, slot->buffer.GetHandle(), 1, &region);
+
+        // Make the copy visible to the host once the frame has completed
+        VkBufferMemoryBarrier barrier {};
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer              = slot->buffer.GetHandle();
+        barrier.offset              = 0;
+        barrier.size                = VK_WHOLE_SIZE;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_HOST_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr);
+
+        slot->frameNumber = frameNumber;
+        slot->width       = extent.width;
+        slot->height      = extent.height;
+        slot->format      = format;
+        slot->pending     = true;
+
+        return true;
+    }
+
+    void ReadbackQueue::Collect(u64 completedFrame, vector<CapturedImage>& out) {
+        for (auto& slot : mSlots) {
+            if (!slot.pending || slot.frameNumber > completedFrame) { continue; }
+
+            CapturedImage image;
+            image.frameNumber = slot.frameNumber;
+            image.width       = slot.width;
+            image.height      = slot.height;
+            image.format      = slot.format;
+            image.pixels.resize(slot.buffer.GetSize());
+            slot.buffer.Download(image.pixels.data(), slot.buffer.GetSize());
+
+            out.push_back(std::move(image));
+            slot.pending = false;
+        }
+
+        // Slots aren't filled in frame order, keep results ordered for the caller
+        std::sort(out.begin(), out.end(), [](const CapturedImage& a, const CapturedImage& b) {
+            return a.frameNumber < b.frameNumber;
+        });
+    }
+
+    bool ReadbackQueue::HasPending() const {
+        for (const auto& slot : mSlots) {
+            if (slot.pending) { return true; }
+        }
+        return false;
+    }
+}  // namespace North::Graphics
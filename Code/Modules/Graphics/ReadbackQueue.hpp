@@ -0,0 +1,76 @@
+// Author: Jake Rieger
+// Created: 11/20/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace North::Graphics {
+    /// @brief A frame's color output copied back to the CPU
+    struct CapturedImage {
+        u64 frameNumber = 0;
+        u32 width       = 0;
+        u32 height      = 0;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        vector<u8> pixels;  // Tightly packed rows, 4 bytes per pixel
+    };
+
+    /**
+     * @brief Non-blocking GPU -> CPU image readback
+     *
+     * Copies are recorded into the frame's command buffer and land in a pool of persistently mapped
+     * GPU_To_CPU buffers. They are only read once the frame that recorded them is known to have
+     * completed, so capturing never waits on the GPU (no vkDeviceWaitIdle / vkQueueWaitIdle). Results
+     * show up a few frames after the request, once the frame loop has seen that frame complete.
+     */
+    class ReadbackQueue {
+    public:
+        ReadbackQueue() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(ReadbackQueue)
+
+        /**
+         * @param allocator VMA allocator the readback buffers come from
+         * @param slotCount How many captures may be in flight at once
+         */
+        void Initialize(VmaAllocator allocator, u32 slotCount);
+        void Shutdown();
+
+        /// @brief Grow the pool to at least `slotCount` slots, pending captures are kept
+        void Reserve(u32 slotCount);
+
+        /**
+         * @brief Record a copy of a color image into a free readback buffer
+         *
+         * The image must be in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL and use a 4 byte per pixel format.
+         *
+         * @return false if every slot is still waiting on the GPU (the capture is dropped, never stalls)
+         */
+        bool RecordCopy(VkCommandBuffer cmd, VkImage image, VkExtent2D extent, VkFormat format, u64 frameNumber);
+
+        /// @brief Move every capture whose frame is <= completedFrame into `out`
+        void Collect(u64 completedFrame, vector<CapturedImage>& out);
+
+        NE_ND bool HasPending() const;
+
+    private:
+        struct Slot {
+            Buffer buffer;
+            u64 frameNumber = 0;
+            u32 width       = 0;
+            u32 height      = 0;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            bool pending    = false;
+        };
+
+        static constexpr u32 kBytesPerPixel = 4;
+
+        VmaAllocator mAllocator = VK_NULL_HANDLE;
+        vector<Slot> mSlots;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,36 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "DeletionQueue.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+namespace North::Graphics {
+    /**
+     * @brief A resource the Defragmenter is allowed to move to another place in memory
+     *
+     * Opting in points the resource's VMA allocation user data at it, which is how the defragmenter finds the
+     * owner of an allocation VMA wants to move. Allocations without user data are left where they are.
+     */
+    class IRelocatable {
+    public:
+        IRelocatable()          = default;
+        virtual ~IRelocatable() = default;
+
+        /**
+         * @brief Move the resource into `allocation`, the new place VMA picked for its memory
+         *
+         * Creates a new handle bound to `allocation`, records the copy of the contents into `cmd`, switches to
+         * the new handle and retires the old one. The old memory stays valid until the frame `cmd` belongs to
+         * has completed. The caller orders the copy against earlier and later work with barriers.
+         *
+         * @return false to leave the resource where it is
+         */
+        virtual bool Relocate(VkCommandBuffer cmd, VmaAllocation allocation, DeletionQueue& deletionQueue) = 0;
+    };
+}  // namespace North::Graphics
@@ -6,6 +6,7 @@
 
 #include "Common/Common.hpp"
 #include "Buffer.hpp"
+#include "Mesh.hpp"
 #include "Math/Constants.hpp"
 
 #include <vk_mem_alloc.h>
@@ -15,12 +16,12 @@ namespace North::Graphics {
     struct DrawCommand {
         // const Pipeline* pipeline = nullptr;
         // const Material* material = nullptr;
-        // const Mesh* mesh         = nullptr;
+        const Mesh* mesh   = nullptr;
         Mat4x4 modelMatrix = Math::Constants::kIdentity4x4;
-        //
-        // // Additional per-draw data
-        u32 instanceCount = 1;
-        u32 firstInstance = 0;
+
+        /// Large and likely to hide things (walls, floors, big props). Drawn into the depth prepass, so the rest of
+        /// the frame is occlusion culled against it instead of against the previous frame.
+        bool occluder = false;
     };
 
     /// @brief High-level render commands that can be submitted to the renderer
@@ -64,11 +65,13 @@ namespace North::Graphics {
         VkCommandBuffer commandBuffer       = VK_NULL_HANDLE;
         VkSemaphore imageAvailableSemaphore = VK_NULL_HANDLE;
         VkSemaphore renderFinishedSemaphore = VK_NULL_HANDLE;
-        VkFence inFlightFence               = VK_NULL_HANDLE;
+
+        // Frame number this slot last submitted, signaled on the render context's frame timeline
+        u64 timelineValue = 0;
 
         // Per-frame resources
         VkDescriptorSet globalDescriptorSet = VK_NULL_HANDLE;
-        Buffer* uniformBuffer               = nullptr;
+        Buffer* uniformBuffer               = nullptr;  // The frame's uniform ring slot
 
         // Frame-specific command collection
         RenderCommandBuffer renderCommandBuffer;
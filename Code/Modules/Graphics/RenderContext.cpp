@@ -3,32 +3,173 @@
 //
 
 #include "RenderContext.hpp"
+#include "CpuDownsampler.hpp"
+#include "Common/Clock.hpp"
+
+#include <cmath>
 #include <iostream>
 #include <cstring>
 
 namespace North::Graphics {
+    namespace {
+        VkPresentModeKHR ToVkPresentMode(PresentMode mode) {
+            switch (mode) {
+                case PresentMode::FifoRelaxed:
+                    return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+                case PresentMode::Mailbox:
+                    return VK_PRESENT_MODE_MAILBOX_KHR;
+                case PresentMode::Immediate:
+                    return VK_PRESENT_MODE_IMMEDIATE_KHR;
+                default:
+                    return VK_PRESENT_MODE_FIFO_KHR;
+            }
+        }
+
+        PresentMode FromVkPresentMode(VkPresentModeKHR mode) {
+            switch (mode) {
+                case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+                    return PresentMode::FifoRelaxed;
+                case VK_PRESENT_MODE_MAILBOX_KHR:
+                    return PresentMode::Mailbox;
+                case VK_PRESENT_MODE_IMMEDIATE_KHR:
+                    return PresentMode::Immediate;
+                default:
+                    return PresentMode::Fifo;
+            }
+        }
+
+        const char* PresentModeName(PresentMode mode) {
+            switch (mode) {
+                case PresentMode::FifoRelaxed:
+                    return "FIFO relaxed";
+                case PresentMode::Mailbox:
+                    return "mailbox";
+                case PresentMode::Immediate:
+                    return "immediate";
+                default:
+                    return "FIFO";
+            }
+        }
+
+        // The depth buffer is sampled into the Hi-Z pyramid. D16 is the only format guaranteed to allow that, D32
+        // is near universal and keeps occlusion tests precise at a distance.
+        VkFormat FindDepthFormat(VkPhysicalDevice physicalDevice) {
+            constexpr VkFormatFeatureFlags kRequired =
+              VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+            constexpr VkFormat kCandidates[] = {
+              VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32, VK_FORMAT_D16_UNORM};
+
+            for (const VkFormat format : kCandidates) {
+                VkFormatProperties properties {};
+                vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+                if ((properties.optimalTilingFeatures & kRequired) == kRequired) return format;
+            }
+            return VK_FORMAT_D16_UNORM;
+        }
+    }  // namespace
+
     void RenderContext::Initialize(GLFWwindow* window, u32 width, u32 height) {
-        mWidth  = width;
-        mHeight = height;
+        mWidth    = width;
+        mHeight   = height;
+        mHeadless = window == nullptr;
 
         if (!CreateInstance()) { throw std::runtime_error("Failed to create Vulkan instance"); }
 
         // Create surface
-        if (glfwCreateWindowSurface(mInstance, window, nullptr, &mSurface) != VK_SUCCESS) {
+        if (!mHeadless && glfwCreateWindowSurface(mInstance, window, nullptr, &mSurface) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create window surface");
         }
 
         if (!SelectPhysicalDevice()) { throw std::runtime_error("Failed to select physical device"); }
         if (!CreateDevice()) { throw std::runtime_error("Failed to create Vulkan device"); }
         if (!CreateAllocator()) { throw std::runtime_error("Failed to create Vulkan allocator"); }
-        if (!CreateSwapchain()) { throw std::runtime_error("Failed to create Vulkan swapchain"); }
-        if (!CreateRenderPass()) { throw std::runtime_error("Failed to create Vulkan render pass"); }
-        if (!CreateFramebuffers()) { throw std::runtime_error("Failed to create Vulkan frame buffers"); }
+        mDeletionQueue.Initialize(mDevice, mAllocator);
+        mDeletionQueue.SetFrameNumber(mFrameNumber);
+        if (!mGeometryPool.Initialize(
+              mAllocator, mDeletionQueue, sizeof(Vertex), kGeometryPoolVertices, kGeometryPoolIndices)) {
+            throw std::runtime_error("Failed to create geometry pool");
+        }
+        if (mHeadless) {
+            if (!CreateOffscreenTarget()) { throw std::runtime_error("Failed to create offscreen render target"); }
+        } else {
+            if (!CreateSwapchain()) { throw std::runtime_error("Failed to create Vulkan swapchain"); }
+        }
+        if (!CreateDepthTarget()) { throw std::runtime_error("Failed to create depth buffer"); }
+        mCpuOcclusionCuller.Resize(mSwapchainExtent.width / kCpuOcclusionDownscale,
+                                   mSwapchainExtent.height / kCpuOcclusionDownscale);
+        // Dynamic rendering begins on the target's image view every frame, there's nothing to build up front
+        if (!mDynamicRendering) {
+            if (!CreateRenderPass()) { throw std::runtime_error("Failed to create Vulkan render pass"); }
+            if (!CreateFramebuffers()) { throw std::runtime_error("Failed to create Vulkan frame buffers"); }
+        }
         if (!CreateCommandPool()) { throw std::runtime_error("Failed to create Vulkan command pool"); }
+        if (mFrames.size() < mFramesInFlight) { mFrames.resize(mFramesInFlight); }
         if (!CreateCommandBuffers()) { throw std::runtime_error("Failed to create Vulkan command buffers"); }
         if (!CreateSyncObjects()) { throw std::runtime_error("Failed to create Vulkan sync objects"); }
 
-        mInitialized = true;
+        // One more slot than frames in flight so a capture can be requested every frame without dropping any
+        mReadbackQueue.Initialize(mAllocator, mFramesInFlight + 1);
+
+        const VkDeviceSize uniformAlignment = mVkbPhysicalDevice.properties.limits.minUniformBufferOffsetAlignment;
+        if (!mUniformRing.Initialize(
+              mDevice, mAllocator, mDeletionQueue, uniformAlignment, CAST<u32>(mFrames.size()))) {
+            throw std::runtime_error("Failed to create uniform ring");
+        }
+        if (!mDescriptorAllocator.Initialize(mDevice, CAST<u32>(mFrames.size()))) {
+            throw std::runtime_error("Failed to create descriptor allocator");
+        }
+        if (!mBindlessTable.Initialize(mDevice, mPhysicalDevice, mDeletionQueue)) {
+            throw std::runtime_error("Failed to create bindless descriptor table");
+        }
+        if (!mPipelineCache.Initialize(mDevice, mPhysicalDevice, mPipelineCachePath)) {
+            throw std::runtime_error("Failed to create pipeline cache");
+        }
+        mThreadPool.Start();
+        mShaderLibrary.Initialize(mDevice);
+        mPipelineManager.Initialize(mDevice, mPipelineCache.GetHandle(), mShaderLibrary, mThreadPool);
+        if (!mTextureStreamer.Initialize(mDevice, mAllocator, mDeletionQueue, mBindlessTable, mThreadPool)) {
+            throw std::runtime_error("Failed to create texture streamer");
+        }
+        mDefragmenter.Initialize(mAllocator, mDeletionQueue);
+
+        // Timed to compare cold starts (empty cache, every shader compiled by the driver) with warm ones
+        const f64 pipelineStart = Clock::Now();
+
+        if (!mHiZPyramid.Initialize(
+              mDevice, mAllocator, mDeletionQueue, mDescriptorAllocator, mPipelineCache.GetHandle())) {
+            std::cerr << "Hi-Z pyramid unavailable, occlusion culling is off" << std::endl;
+        }
+        mHiZPyramid.Resize(mSwapchainExtent);
+        if (!mIndirectDrawPass.Initialize(mDevice,
+                                          mAllocator,
+                                          mDeletionQueue,
+                                          mDescriptorAllocator,
+                                          mHiZPyramid,
+                                          mRenderPass,
+                                          mDepthPrepassRenderPass,
+                                          mSwapchainImageFormat,
+                                          mDepthFormat,
+                                          mUniformRing.GetDescriptorSetLayout(),
+                                          mPipelineCache.GetHandle(),
+                                          CAST<u32>(mFrames.size()))) {
+            std::cerr << "Indirect draw pass unavailable, submitted meshes will not be drawn" << std::endl;
+            mIndirectDrawPass.Shutdown();
+        }
+        if (!mMipGenerator.Initialize(
+              mDevice, mAllocator, mDescriptorAllocator, mShaderLibrary, mPipelineCache.GetHandle())) {
+            std::cerr << "Mip generation compute path unavailable, using blits" << std::endl;
+            mMipGenerator.Shutdown();
+        }
+
+        mPipelineCache.RecordPipelineCreation((Clock::Now() - pipelineStart) * 1000.0);
+        const PipelineCacheStats cacheStats = mPipelineCache.GetStats();
+        std::cout << "Startup pipelines built in " << cacheStats.pipelineCreationMs << " ms ("
+                  << (cacheStats.warm ? "warm" : "cold") << " pipeline cache, " << cacheStats.loadedBytes
+                  << " bytes loaded)" << std::endl;
+
+        mStartTime     = Clock::Now();
+        mLastFrameTime = mStartTime;
+        mInitialized   = true;
     }
 
     void RenderContext::Shutdown() {
@@ -36,59 +177,119 @@ namespace North::Graphics {
 
         vkDeviceWaitIdle(mDevice);
 
+        mReadbackQueue.Shutdown();
+        mCompletedCaptures.clear();
+
         // Cleanup sync objects
-        for (size_t i = 0; i < kMaxFramesInFlight; i++) {
-            vkDestroySemaphore(mDevice, mImageAvailableSemaphores[i], nullptr);
-            vkDestroySemaphore(mDevice, mRenderFinishedSemaphores[i], nullptr);
-            vkDestroyFence(mDevice, mInFlightFences[i], nullptr);
+        for (const auto& frame : mFrames) {
+            vkDestroySemaphore(mDevice, frame.imageAvailableSemaphore, nullptr);
+            vkDestroySemaphore(mDevice, frame.renderFinishedSemaphore, nullptr);
         }
+        mFrames.clear();
+        vkDestroySemaphore(mDevice, mFrameTimeline, nullptr);
+        mFrameTimeline = VK_NULL_HANDLE;
 
         // Cleanup command pool
         vkDestroyCommandPool(mDevice, mCommandPool, nullptr);
 
-        // Cleanup swapchain
+        mDefragmenter.Shutdown();  // Before anything it may be moving is destroyed
+        mIndirectDrawPass.Shutdown();
+        mHiZPyramid.Shutdown();
+        mMipGenerator.Shutdown();
+        mTextureStreamer.Shutdown();  // Before the thread pool stops, it waits for loads still running
+        mDescriptorAllocator.Shutdown();
+        mUniformRing.Shutdown();
+        mBindlessTable.Shutdown();
+        mPipelineManager.Shutdown();  // Before the cache so pipelines compiled this run are saved
+        mThreadPool.Stop();
+        mShaderLibrary.Shutdown();
+        mPipelineCache.Shutdown();
+
+        // The device is idle, everything retired can go
+        mDeletionQueue.FlushAll();
+        mGeometryPool.Shutdown();
+
+        // Cleanup swapchain (or the offscreen target standing in for it)
         CleanupSwapchain();
+        mOffscreenTarget.Destroy();
+        mDepthTarget.Destroy();
 
-        // Cleanup render pass
+        // Cleanup render passes
         vkDestroyRenderPass(mDevice, mRenderPass, nullptr);
+        vkDestroyRenderPass(mDevice, mRenderPassKeepDepth, nullptr);
+        vkDestroyRenderPass(mDevice, mDepthPrepassRenderPass, nullptr);
 
-        // Cleanup allocator
-        if (mAllocator != VK_NULL_HANDLE) { vmaDestroyAllocator(mAllocator); }
+        // Cleanup allocator, anything still allocated from it at this point was never freed
+        if (mAllocator != VK_NULL_HANDLE) {
+            MemoryReport::ReportLeaks(mAllocator);
+            vmaDestroyAllocator(mAllocator);
+        }
 
         // Cleanup device and instance (vk-bootstrap handles this)
         vkb::destroy_device(mVkbDevice);
-        vkDestroySurfaceKHR(mInstance, mSurface, nullptr);
+        if (mSurface != VK_NULL_HANDLE) { vkDestroySurfaceKHR(mInstance, mSurface, nullptr); }
         vkb::destroy_instance(mVkbInstance);
 
         mInitialized = false;
     }
 
     void RenderContext::DrawFrame() {
-        // Wait for the previous frame to finish
-        vkWaitForFences(mDevice, 1, &mInFlightFences[mCurrentFrame], VK_TRUE, UINT64_MAX);
-
-        // Acquire an image from the swapchain
-        u32 imageIndex;
-        VkResult result = vkAcquireNextImageKHR(mDevice,
-                                                mSwapchain,
-                                                UINT64_MAX,
-                                                mImageAvailableSemaphores[mCurrentFrame],
-                                                VK_NULL_HANDLE,
-                                                &imageIndex);
-
-        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-            Resize(mWidth, mHeight);
-            return;
-        } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-            std::cerr << "Failed to acquire swapchain image!" << std::endl;
-            return;
+        FrameData& frame = mFrames[mCurrentFrame];
+
+        // Wait for the frame that last used this slot to finish, then pick up anything that completed meanwhile
+        WaitForFrame(frame.timelineValue);
+        mReadbackQueue.Collect(mCompletedFrame, mCompletedCaptures);
+        mDeletionQueue.Flush(mCompletedFrame);
+
+        // VMA refreshes its heap budgets when the frame index changes
+        vmaSetCurrentFrameIndex(mAllocator, CAST<u32>(mFrameNumber));
+
+        // The slot's uniforms and transient descriptor sets are free again, start the frame with its constants
+        mUniformRing.BeginFrame(mCurrentFrame);
+        mDescriptorAllocator.BeginFrame(mCurrentFrame);
+        frame.uniformBuffer       = &mUniformRing.GetBuffer(mCurrentFrame);
+        frame.globalDescriptorSet = mUniformRing.GetDescriptorSet(mCurrentFrame);
+
+        const f64 now              = Clock::Now();
+        mFrameConstants.time       = CAST<f32>(now - mStartTime);
+        mFrameConstants.deltaTime  = CAST<f32>(now - mLastFrameTime);
+        mFrameConstants.frameIndex = mCurrentFrame;
+        mLastFrameTime             = now;
+        mFrameConstantsOffset      = mUniformRing.Push(mFrameConstants).offset;
+
+        // Before anything is written for the GPU, so hidden draws cost nothing past this point
+        if (mCpuOcclusionCulling) { CullOccludedDraws(frame.drawCommands); }
+        mCpuOccluders.clear();
+
+        mPipelineCache.Update(now, mThreadPool);
+
+        if (mRenderTargetsDirty) { RecreateRenderTargets(); }
+
+        // Acquire an image from the swapchain (headless always renders into the single offscreen target)
+        u32 imageIndex  = 0;
+        VkResult result = VK_SUCCESS;
+        if (!mHeadless) {
+            result = vkAcquireNextImageKHR(mDevice,
+                                           mSwapchain,
+                                           UINT64_MAX,
+                                           frame.imageAvailableSemaphore,
+                                           VK_NULL_HANDLE,
+                                           &imageIndex);
+
+            // A skipped frame drops its draws, the slot's next frame would draw them again on top of its own
+            if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+                frame.drawCommands.clear();
+                RecreateRenderTargets();
+                return;
+            } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+                std::cerr << "Failed to acquire swapchain image!" << std::endl;
+                frame.drawCommands.clear();
+                return;
+            }
         }
 
-        // Reset fence only if we're submitting work
-        vkResetFences(mDevice, 1, &mInFlightFences[mCurrentFrame]);
-
         // Record command buffer
-        VkCommandBuffer cmd = mCommandBuffers[mCurrentFrame];
+        VkCommandBuffer cmd = frame.commandBuffer;
         vkResetCommandBuffer(cmd, 0);
 
         VkCommandBufferBeginInfo beginInfo {};
@@ -96,58 +297,119 @@ namespace North::Graphics {
 
         if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS) {
             std::cerr << "Failed to begin recording command buffer!" << std::endl;
+            frame.drawCommands.clear();
             return;
         }
 
-        // Begin render pass with clear color
-        VkRenderPassBeginInfo renderPassInfo {};
-        renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass        = mRenderPass;
-        renderPassInfo.framebuffer       = mFramebuffers[imageIndex];
-        renderPassInfo.renderArea.offset = {0, 0};
-        renderPassInfo.renderArea.extent = mSwapchainExtent;
+        // Resources it moves switch handles right away, everything recorded after this uses the new ones
+        mDefragmenter.Update(cmd, mFrameNumber);
+
+        // Mesh data queued since the last frame, ahead of anything that could draw it
+        mGeometryPool.RecordUploads(cmd);
+        mTextureStreamer.Update(cmd);
+
+        // Culling writes the draw list on the GPU, it has to happen before the render pass begins. A frame with
+        // occluders draws them depth-only first and culls everything against the Hi-Z pyramid of that depth,
+        // otherwise the pyramid left by the previous frame is used.
+        const Mat4x4& viewProjection = mFrameConstants.viewProjectionMatrix;
+        const bool drawMeshes        = mIndirectDrawPass.Initialized() && !frame.drawCommands.empty();
+        bool depthPrepass            = false;
+        if (drawMeshes) {
+            mIndirectDrawPass.Prepare(mCurrentFrame, frame.drawCommands);
+
+            depthPrepass = mOcclusionCulling && mDepthPrepassEnabled && mHiZPyramid.Initialized() &&
+                           mIndirectDrawPass.HasOccluders(mCurrentFrame);
+            if (depthPrepass) {
+                mIndirectDrawPass.RecordCull(cmd, mCurrentFrame, viewProjection, CullPhase::Occluders);
+                BeginDepthPrepass(cmd);
+                mIndirectDrawPass.RecordDepthPrepass(cmd,
+                                                     mCurrentFrame,
+                                                     mGeometryPool,
+                                                     frame.globalDescriptorSet,
+                                                     mFrameConstantsOffset,
+                                                     mSwapchainExtent);
+                EndDepthPrepass(cmd);
+                mHiZPyramid.Build(cmd, mDepthTarget, viewProjection);
+            }
+
+            mIndirectDrawPass.RecordCull(cmd, mCurrentFrame, viewProjection, CullPhase::Main, mOcclusionCulling);
+        }
+        frame.drawCommands.clear();
 
-        VkClearValue clearColor        = {{{0.01f, 0.01f, 0.01f, 1.0f}}};
-        renderPassInfo.clearValueCount = 1;
-        renderPassInfo.pClearValues    = &clearColor;
+        BeginMainPass(cmd, imageIndex, depthPrepass);
 
-        vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        if (drawMeshes) {
+            mIndirectDrawPass.RecordDraw(cmd,
+                                         mCurrentFrame,
+                                         mGeometryPool,
+                                         frame.globalDescriptorSet,
+                                         mFrameConstantsOffset,
+                                         mSwapchainExtent);
+        }
 
-        // Nothing to draw, just clearing
+        EndMainPass(cmd, imageIndex);
 
-        vkCmdEndRenderPass(cmd);
+        // Without a prepass of its own, the next frame culls against this frame's depth
+        if (drawMeshes && mOcclusionCulling && !depthPrepass) { mHiZPyramid.Build(cmd, mDepthTarget, viewProjection); }
+
+        if (mCaptureRequested) {
+            RecordCapture(cmd, imageIndex);
+            mCaptureRequested = false;
+        }
 
         if (vkEndCommandBuffer(cmd) != VK_SUCCESS) {
             std::cerr << "Failed to record command buffer!" << std::endl;
             return;
         }
 
+        mUniformRing.Flush();
+
         // Submit command buffer
         VkSubmitInfo submitInfo {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-        VkSemaphore waitSemaphores[]      = {mImageAvailableSemaphores[mCurrentFrame]};
+        // Headless has nothing to acquire from or present to, so it only signals the frame timeline
+        VkSemaphore waitSemaphores[]      = {frame.imageAvailableSemaphore};
         VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        submitInfo.waitSemaphoreCount     = 1;
+        const u64 waitValues[]            = {0};  // Ignored for binary semaphores
+        submitInfo.waitSemaphoreCount     = mHeadless ? 0 : 1;
         submitInfo.pWaitSemaphores        = waitSemaphores;
         submitInfo.pWaitDstStageMask      = waitStages;
         submitInfo.commandBufferCount     = 1;
         submitInfo.pCommandBuffers        = &cmd;
 
-        VkSemaphore signalSemaphores[]  = {mRenderFinishedSemaphores[mCurrentFrame]};
-        submitInfo.signalSemaphoreCount = 1;
-        submitInfo.pSignalSemaphores    = signalSemaphores;
-
-        if (vkQueueSubmit(mGraphicsQueue, 1, &submitInfo, mInFlightFences[mCurrentFrame]) != VK_SUCCESS) {
+        VkSemaphore signalSemaphores[]  = {frame.renderFinishedSemaphore, mFrameTimeline};
+        const u64 signalValues[]        = {0, mFrameNumber};
+        const u32 firstSignal           = mHeadless ? 1 : 0;
+        submitInfo.signalSemaphoreCount = 2 - firstSignal;
+        submitInfo.pSignalSemaphores    = signalSemaphores + firstSignal;
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo {};
+        timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount   = submitInfo.waitSemaphoreCount;
+        timelineInfo.pWaitSemaphoreValues      = waitValues;
+        timelineInfo.signalSemaphoreValueCount = submitInfo.signalSemaphoreCount;
+        timelineInfo.pSignalSemaphoreValues    = signalValues + firstSignal;
+        submitInfo.pNext                       = &timelineInfo;
+
+        if (vkQueueSubmit(mGraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
             std::cerr << "Failed to submit draw command buffer!" << std::endl;
             return;
         }
 
+        frame.timelineValue = mFrameNumber++;
+        mDeletionQueue.SetFrameNumber(mFrameNumber);
+
+        if (mHeadless) {
+            mCurrentFrame = (mCurrentFrame + 1) % mFramesInFlight;
+            return;
+        }
+
         // Present
         VkPresentInfoKHR presentInfo {};
         presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
         presentInfo.waitSemaphoreCount = 1;
-        presentInfo.pWaitSemaphores    = signalSemaphores;
+        presentInfo.pWaitSemaphores    = &frame.renderFinishedSemaphore;
 
         VkSwapchainKHR swapChains[] = {mSwapchain};
         presentInfo.swapchainCount  = 1;
@@ -156,35 +418,597 @@ namespace North::Graphics {
 
         result = vkQueuePresentKHR(mPresentQueue, &presentInfo);
 
+        if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) { RecordPresentLatency(); }
+
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-            Resize(mWidth, mHeight);
+            mRenderTargetsDirty = true;
         } else if (result != VK_SUCCESS) {
             std::cerr << "Failed to present swapchain image!" << std::endl;
         }
 
-        mCurrentFrame = (mCurrentFrame + 1) % kMaxFramesInFlight;
+        mCurrentFrame = (mCurrentFrame + 1) % mFramesInFlight;
+    }
+
+    void RenderContext::SetFramesInFlight(u32 count) {
+        count = NE_MAX(count, 1u);
+
+        // Slots are only ever added. Each one still waits on its own last frame before being reused, so switching
+        // between counts is safe without draining the GPU.
+        if (mFrames.size() < count) {
+            mFrames.resize(count);
+            if (mInitialized) {
+                if (!CreateCommandBuffers() || !CreateSyncObjects()) {
+                    throw std::runtime_error("Failed to create per-frame resources");
+                }
+                mReadbackQueue.Reserve(count + 1);
+                if (!mUniformRing.Reserve(count) || !mDescriptorAllocator.Reserve(count)) {
+                    throw std::runtime_error("Failed to create per-frame resources");
+                }
+                if (mIndirectDrawPass.Initialized() && !mIndirectDrawPass.Reserve(count)) {
+                    throw std::runtime_error("Failed to create per-frame resources");
+                }
+            }
+        }
+
+        mFramesInFlight = count;
+        mCurrentFrame %= mFramesInFlight;
+    }
+
+    void RenderContext::SetPresentMode(PresentMode mode) {
+        if (mode == mPresentMode) return;
+        mPresentMode        = mode;
+        mPresentModeChanged = true;
+        if (mInitialized && !mHeadless) { mRenderTargetsDirty = true; }
+    }
+
+    void RenderContext::SetSwapchainImageCount(u32 count) {
+        if (count == mSwapchainImageCount) return;
+        mSwapchainImageCount = count;
+        if (mInitialized && !mHeadless) { mRenderTargetsDirty = true; }
+    }
+
+    void RenderContext::MarkInput(f64 timestamp) {
+        if (timestamp <= 0) return;
+        if (mPendingInputTime == 0 || timestamp < mPendingInputTime) { mPendingInputTime = timestamp; }
+    }
+
+    void RenderContext::ResetPresentLatency() {
+        mPresentLatency = {};
+    }
+
+    void RenderContext::Submit(const DrawCommand& command) {
+        if (!mInitialized || !mIndirectDrawPass.Initialized()) return;
+        mFrames[mCurrentFrame].drawCommands.push_back(command);
+    }
+
+    void RenderContext::SubmitOccluder(const Occluder& occluder) {
+        if (!mInitialized || occluder.triangleCount == 0) return;
+        mCpuOccluders.push_back(occluder);
+    }
+
+    void RenderContext::SetCamera(const Mat4x4& view, const Mat4x4& projection, const Vec3& position) {
+        mFrameConstants.viewMatrix           = view;
+        mFrameConstants.projectionMatrix     = projection;
+        mFrameConstants.viewProjectionMatrix = projection * view;
+        mFrameConstants.cameraPosition       = Vec4(position, 1.0f);
+    }
+
+    void RenderContext::RecordPresentLatency() {
+        if (mPendingInputTime == 0) return;
+
+        // Input only arrives between frames, so whatever is pending was seen by the frame just presented
+        const f64 latencyMs = (Clock::Now() - mPendingInputTime) * 1000.0;
+        mPendingInputTime   = 0;
+
+        mPresentLatency.samples++;
+        mPresentLatency.lastMs = latencyMs;
+        mPresentLatency.maxMs  = NE_MAX(mPresentLatency.maxMs, latencyMs);
+        mPresentLatency.averageMs += (latencyMs - mPresentLatency.averageMs) / CAST<f64>(mPresentLatency.samples);
+    }
+
+    u64 RenderContext::PollCompletedFrame() {
+        u64 value = 0;
+        if (vkGetSemaphoreCounterValue(mDevice, mFrameTimeline, &value) == VK_SUCCESS) {
+            mCompletedFrame = NE_MAX(mCompletedFrame, value);
+        }
+        return mCompletedFrame;
+    }
+
+    void RenderContext::WaitForFrame(u64 frameNumber) {
+        if (frameNumber == 0 || frameNumber <= mCompletedFrame) {
+            PollCompletedFrame();
+            return;
+        }
+
+        VkSemaphoreWaitInfo waitInfo {};
+        waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores    = &mFrameTimeline;
+        waitInfo.pValues        = &frameNumber;
+
+        vkWaitSemaphores(mDevice, &waitInfo, UINT64_MAX);
+        PollCompletedFrame();
+    }
+
+    bool RenderContext::RequestCapture() {
+        // Headless renders into the offscreen target, which can always be copied from
+        if (!mHeadless && !mSwapchainCapture) {
+            std::cerr << "Frame capture is not supported by this surface" << std::endl;
+            return false;
+        }
+
+        mCaptureRequested = true;
+        return true;
+    }
+
+    vector<CapturedImage> RenderContext::TakeCaptures() {
+        vector<CapturedImage> captures;
+        captures.swap(mCompletedCaptures);
+        return captures;
+    }
+
+    void RenderContext::CullOccludedDraws(vector<DrawCommand>& drawCommands) {
+        if (mCpuOccluders.empty() || drawCommands.empty()) return;
+
+        mCpuOcclusionCuller.BeginFrame(mFrameConstants.viewProjectionMatrix);
+        for (const auto& occluder : mCpuOccluders) {
+            mCpuOcclusionCuller.AddOccluder(occluder);
+        }
+        mCpuOcclusionCuller.RenderOccluders(mThreadPool);
+
+        // World space boxes around the meshes' bounding spheres, scaled by the model matrix's largest axis
+        const u32 count = CAST<u32>(drawCommands.size());
+        mCpuOcclusionBounds.resize(count);
+        mCpuOcclusionVisible.resize(count);
+        for (u32 i = 0; i < count; i++) {
+            const DrawCommand& command = drawCommands[i];
+            OcclusionBounds& bounds    = mCpuOcclusionBounds[i];
+            if (!command.mesh) {
+                bounds = {};
+                continue;
+            }
+
+            const Mat4x4& model = command.modelMatrix;
+            f32 scale           = 0;
+            for (u32 axis = 0; axis < 3; axis++) {
+                const Vec4& column = model[CAST<i32>(axis)];
+                scale = NE_MAX(scale, column.x * column.x + column.y * column.y + column.z * column.z);
+            }
+
+            const Vec4 center = model * Vec4(command.mesh->boundsCenter, 1.0f);
+            const Vec3 extent = Vec3(command.mesh->boundsRadius * std::sqrt(scale));
+            bounds.min        = Vec3(center.x, center.y, center.z) - extent;
+            bounds.max        = Vec3(center.x, center.y, center.z) + extent;
+        }
+        mCpuOcclusionCuller.TestBounds(mThreadPool, mCpuOcclusionBounds.data(), count, mCpuOcclusionVisible.data());
+
+        u32 kept = 0;
+        for (u32 i = 0; i < count; i++) {
+            if (mCpuOcclusionVisible[i] || drawCommands[i].occluder) { drawCommands[kept++] = drawCommands[i]; }
+        }
+        drawCommands.resize(kept);
+    }
+
+    void RenderContext::RecordCapture(VkCommandBuffer cmd, u32 imageIndex) {
+        // The offscreen target already ends the render pass in TRANSFER_SRC_OPTIMAL, only the color writes have to
+        // be made visible to the copy. With dynamic rendering it's still a color attachment.
+        if (mHeadless) {
+            mOffscreenTarget.Transition(
+              cmd, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+            mReadbackQueue.RecordCopy(
+              cmd, mOffscreenTarget.GetHandle(), mSwapchainExtent, mSwapchainImageFormat, mFrameNumber);
+            return;
+        }
+
+        // Swapchain images have to be moved out of PRESENT_SRC for the copy and back again afterwards
+        VkImageMemoryBarrier barrier {};
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask                   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask                   = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.oldLayout                       = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        barrier.newLayout                       = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = mSwapchainImages[imageIndex];
+        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel   = 0;
+        barrier.subresourceRange.levelCount     = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount     = 1;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+
+        mReadbackQueue.RecordCopy(
+          cmd, mSwapchainImages[imageIndex], mSwapchainExtent, mSwapchainImageFormat, mFrameNumber);
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.dstAccessMask = 0;
+        barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.newLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+    }
+
+    MipBenchmark RenderContext::BenchmarkMipGeneration(u32 size, u32 iterations) {
+        MipBenchmark result;
+        if (!mInitialized || size < 2 || iterations == 0) return result;
+
+        ImageDesc desc;
+        desc.extent = {size, size, 1};
+        desc.format = VK_FORMAT_R8G8B8A8_UNORM;
+        desc.usage  = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                     VK_IMAGE_USAGE_SAMPLED_BIT;
+
+        Image image;
+        if (!image.Create(mDevice, mAllocator, desc)) return result;
+        result.levels = image.GetMipLevels();
+
+        // Noise, so nothing can take a shortcut on uniform blocks
+        vector<u8> texels(CAST<size_t>(size) * size * 4);
+        u32 seed = 0x9E3779B9u;
+        for (auto& texel : texels) {
+            seed  = seed * 1664525u + 1013904223u;
+            texel = CAST<u8>(seed >> 24);
+        }
+
+        Buffer staging;
+        staging.Create(mAllocator, texels.size(), Buffer::Type::Staging, Buffer::MemoryUsage::CPU_To_GPU);
+        staging.Upload(texels.data(), texels.size());
+
+        VkQueryPoolCreateInfo queryInfo {};
+        queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        queryInfo.queryCount = iterations * 3;
+
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        const bool timestamps = mVkbPhysicalDevice.properties.limits.timestampComputeAndGraphics &&
+                                vkCreateQueryPool(mDevice, &queryInfo, nullptr, &queryPool) == VK_SUCCESS;
+        if (!timestamps) { std::cerr << "Timestamp queries unavailable, only timing the CPU path" << std::endl; }
+
+        VkCommandBufferAllocateInfo allocInfo {};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool        = mCommandPool;
+        allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        if (timestamps && vkAllocateCommandBuffers(mDevice, &allocInfo, &cmd) == VK_SUCCESS) {
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(cmd, &beginInfo);
+
+            image.CopyFrom(cmd, staging, 0);
+            vkCmdResetQueryPool(cmd, queryPool, 0, queryInfo.queryCount);
+
+            // Both paths regenerate levels 1 and up from the same level 0, the image's state tracking puts the
+            // barriers between them
+            for (u32 i = 0; i < iterations; i++) {
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, i * 3);
+                mMipGenerator.GenerateCompute(cmd, image);
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, i * 3 + 1);
+                MipGenerator::GenerateBlit(cmd, image);
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, i * 3 + 2);
+            }
+            vkEndCommandBuffer(cmd);
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers    = &cmd;
+            vkQueueSubmit(mGraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+            vkQueueWaitIdle(mGraphicsQueue);
+
+            vector<u64> ticks(queryInfo.queryCount);
+            if (vkGetQueryPoolResults(mDevice,
+                                      queryPool,
+                                      0,
+                                      queryInfo.queryCount,
+                                      ticks.size() * sizeof(u64),
+                                      ticks.data(),
+                                      sizeof(u64),
+                                      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) == VK_SUCCESS) {
+                const f64 msPerTick = mVkbPhysicalDevice.properties.limits.timestampPeriod / 1e6;
+                for (u32 i = 0; i < iterations; i++) {
+                    result.computeMs += CAST<f64>(ticks[i * 3 + 1] - ticks[i * 3]) * msPerTick;
+                    result.blitMs += CAST<f64>(ticks[i * 3 + 2] - ticks[i * 3 + 1]) * msPerTick;
+                }
+                result.computeMs = mMipGenerator.SupportsCompute(image) ? result.computeMs / iterations : 0;
+                result.blitMs /= iterations;
+            }
+
+            vkFreeCommandBuffers(mDevice, mCommandPool, 1, &cmd);
+        }
+        vkDestroyQueryPool(mDevice, queryPool, nullptr);
+
+        const f64 cpuStart = Clock::Now();
+        for (u32 i = 0; i < iterations; i++) {
+            const auto levels = CpuDownsampler::GenerateRgba8(texels.data(), size, size);
+            (void)levels;
+        }
+        result.cpuMs = (Clock::Now() - cpuStart) * 1000.0 / iterations;
+
+        staging.Destroy();
+        image.Destroy();
+        return result;
     }
 
     void RenderContext::Resize(u32 width, u32 height) {
         if (width == 0 || height == 0) return;
 
-        vkDeviceWaitIdle(mDevice);
+        // Only record the new size. Dragging a window fires many resize events per frame, the targets are rebuilt
+        // once at the start of the next frame instead.
+        mWidth              = width;
+        mHeight             = height;
+        mRenderTargetsDirty = true;
+    }
+
+    void RenderContext::RecreateRenderTargets() {
+        mRenderTargetsDirty = false;
+
+        // The old targets are retired rather than destroyed, frames still in flight keep rendering into them
+        if (mHeadless) {
+            RetireRenderTargets();
+            CreateOffscreenTarget();
+        } else {
+            // CreateSwapchain will retire the old swapchain resources
+            CreateSwapchain();
+        }
+        CreateDepthTarget();
+        mHiZPyramid.Resize(mSwapchainExtent);
+        mCpuOcclusionCuller.Resize(mSwapchainExtent.width / kCpuOcclusionDownscale,
+                                   mSwapchainExtent.height / kCpuOcclusionDownscale);
+
+        if (!mDynamicRendering) { CreateFramebuffers(); }
+    }
+
+    void RenderContext::BeginMainPass(VkCommandBuffer cmd, u32 imageIndex, bool keepDepth) {
+        VkClearValue clearValues[2] {};
+        clearValues[0].color        = {{0.01f, 0.01f, 0.01f, 1.0f}};
+        clearValues[1].depthStencil = {1.0f, 0};
+
+        // Every pass keeps depth in the one layout. Its tracking orders this frame's depth writes after the
+        // previous frame's and after whatever Hi-Z build read them.
+        mDepthTarget.Transition(cmd,
+                                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+        if (!mDynamicRendering) {
+            VkRenderPassBeginInfo renderPassInfo {};
+            renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            renderPassInfo.renderPass        = keepDepth ? mRenderPassKeepDepth : mRenderPass;
+            renderPassInfo.framebuffer       = mFramebuffers[imageIndex];
+            renderPassInfo.renderArea.offset = {0, 0};
+            renderPassInfo.renderArea.extent = mSwapchainExtent;
+            renderPassInfo.clearValueCount   = 2;
+            renderPassInfo.pClearValues      = clearValues;
+
+            vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+            return;
+        }
+
+        // No render pass to do the layout transitions, the offscreen target's tracking orders this frame after
+        // the previous one's writes and copy
+        VkImageView colorView = VK_NULL_HANDLE;
+        if (mHeadless) {
+            mOffscreenTarget.Transition(cmd,
+                                        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                                        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+            colorView = mOffscreenTarget.GetView();
+        } else {
+            // Waits on the acquire semaphore through the submit's COLOR_ATTACHMENT_OUTPUT wait stage
+            VkImageMemoryBarrier barrier {};
+            barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask                   = 0;
+            barrier.dstAccessMask                   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout                       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image                           = mSwapchainImages[imageIndex];
+            barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.baseMipLevel   = 0;
+            barrier.subresourceRange.levelCount     = 1;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount     = 1;
+
+            vkCmdPipelineBarrier(cmd,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 1,
+                                 &barrier);
+            colorView = mSwapchainImageViews[imageIndex];
+        }
+
+        VkRenderingAttachmentInfoKHR colorAttachment {};
+        colorAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        colorAttachment.imageView   = colorView;
+        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue  = clearValues[0];
+
+        // Stored for the Hi-Z pyramid
+        VkRenderingAttachmentInfoKHR depthAttachment {};
+        depthAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        depthAttachment.imageView   = mDepthTarget.GetView();
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp      = keepDepth ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.clearValue  = clearValues[1];
+
+        VkRenderingInfoKHR renderingInfo {};
+        renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.renderArea.offset    = {0, 0};
+        renderingInfo.renderArea.extent    = mSwapchainExtent;
+        renderingInfo.layerCount           = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments    = &colorAttachment;
+        renderingInfo.pDepthAttachment     = &depthAttachment;
+
+        mCmdBeginRendering(cmd, &renderingInfo);
+    }
+
+    void RenderContext::EndMainPass(VkCommandBuffer cmd, u32 imageIndex) {
+        if (!mDynamicRendering) {
+            vkCmdEndRenderPass(cmd);
+
+            // The render pass moved the offscreen target to its final layout behind the image's back
+            if (mHeadless) {
+                mOffscreenTarget.SetState(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                          VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+            }
+            return;
+        }
+
+        mCmdEndRendering(cmd);
+
+        // The offscreen target stays a color attachment, a capture transitions it for the copy
+        if (mHeadless) return;
+
+        VkImageMemoryBarrier barrier {};
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask                   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask                   = 0;
+        barrier.oldLayout                       = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        barrier.newLayout                       = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = mSwapchainImages[imageIndex];
+        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel   = 0;
+        barrier.subresourceRange.levelCount     = 1;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount     = 1;
+
+        vkCmdPipelineBarrier(cmd,
+                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+    }
+
+    void RenderContext::BeginDepthPrepass(VkCommandBuffer cmd) {
+        VkClearValue clearDepth {};
+        clearDepth.depthStencil = {1.0f, 0};
+
+        mDepthTarget.Transition(cmd,
+                                VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                  VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+        if (!mDynamicRendering) {
+            VkRenderPassBeginInfo renderPassInfo {};
+            renderPassInfo.sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            renderPassInfo.renderPass        = mDepthPrepassRenderPass;
+            renderPassInfo.framebuffer       = mDepthPrepassFramebuffer;
+            renderPassInfo.renderArea.offset = {0, 0};
+            renderPassInfo.renderArea.extent = mSwapchainExtent;
+            renderPassInfo.clearValueCount   = 1;
+            renderPassInfo.pClearValues      = &clearDepth;
+
+            vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+            return;
+        }
+
+        VkRenderingAttachmentInfoKHR depthAttachment {};
+        depthAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        depthAttachment.imageView   = mDepthTarget.GetView();
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.clearValue  = clearDepth;
+
+        VkRenderingInfoKHR renderingInfo {};
+        renderingInfo.sType             = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.renderArea.offset = {0, 0};
+        renderingInfo.renderArea.extent = mSwapchainExtent;
+        renderingInfo.layerCount        = 1;
+        renderingInfo.pDepthAttachment  = &depthAttachment;
+
+        mCmdBeginRendering(cmd, &renderingInfo);
+    }
 
-        mWidth  = width;
-        mHeight = height;
+    void RenderContext::EndDepthPrepass(VkCommandBuffer cmd) {
+        if (mDynamicRendering) {
+            mCmdEndRendering(cmd);
+        } else {
+            vkCmdEndRenderPass(cmd);
+        }
+    }
 
-        // CreateSwapchain will handle cleanup of old swapchain resources
-        CreateSwapchain();
-        CreateFramebuffers();
+    void RenderContext::RetireRenderTargets() {
+        // Frames up to mFrameNumber - 1 may still use these. Presents aren't tracked by the timeline, so also let
+        // every in-flight slot cycle once more before the swapchain goes away, by then its presents are long done.
+        const u64 retireAfter = mFrameNumber + mFramesInFlight - 1;
+
+        mDeletionQueue.Retire(retireAfter,
+                              [swapchain    = mSwapchain,
+                               imageViews   = std::move(mSwapchainImageViews),
+                               framebuffers = std::move(mFramebuffers),
+                               depthPrepassFramebuffer = mDepthPrepassFramebuffer](VkDevice device, VmaAllocator) {
+                                  for (const auto framebuffer : framebuffers) {
+                                      vkDestroyFramebuffer(device, framebuffer, nullptr);
+                                  }
+                                  vkDestroyFramebuffer(device, depthPrepassFramebuffer, nullptr);
+                                  for (const auto imageView : imageViews) {
+                                      vkDestroyImageView(device, imageView, nullptr);
+                                  }
+                                  if (swapchain != VK_NULL_HANDLE) {
+                                      vkDestroySwapchainKHR(device, swapchain, nullptr);
+                                  }
+                              });
+        // Retired after the framebuffers that reference them, FlushAll() destroys in retirement order
+        mOffscreenTarget.Retire(mDeletionQueue, retireAfter);
+        mDepthTarget.Retire(mDeletionQueue, retireAfter);
+
+        mSwapchain = VK_NULL_HANDLE;
+        mSwapchainImageViews.clear();
+        mFramebuffers.clear();
+        mDepthPrepassFramebuffer = VK_NULL_HANDLE;
     }
 
     bool RenderContext::CreateInstance() {
         vkb::InstanceBuilder builder;
 
         auto instRet = builder.set_app_name("North Engine")
+                         .set_headless(mHeadless)
                          .request_validation_layers(true)
                          .use_default_debug_messenger()
-                         .require_api_version(1, 1, 0)
+                         .require_api_version(1, 2, 0)
                          .build();
 
         if (!instRet) {
@@ -202,7 +1026,40 @@ namespace North::Graphics {
     bool RenderContext::SelectPhysicalDevice() {
         vkb::PhysicalDeviceSelector selector {mVkbInstance};
 
-        auto physRet = selector.set_surface(mSurface).set_minimum_version(1, 1).select();
+        // Without a surface any device will do, including software rasterizers like lavapipe
+        if (mHeadless) {
+            selector.require_present(false);
+        } else {
+            selector.set_surface(mSurface);
+        }
+
+        // Frame synchronization runs on a timeline semaphore (core in 1.2), GPU-driven drawing issues several
+        // indirect draws per call and starts each batch's instances at a nonzero firstInstance
+        VkPhysicalDeviceVulkan12Features features12 {};
+        features12.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features12.timelineSemaphore = VK_TRUE;
+
+        // Bindless table: unbounded, partially written arrays updated while in use and indexed non-uniformly
+        features12.descriptorIndexing                            = VK_TRUE;
+        features12.runtimeDescriptorArray                        = VK_TRUE;
+        features12.descriptorBindingPartiallyBound               = VK_TRUE;
+        features12.descriptorBindingUpdateUnusedWhilePending     = VK_TRUE;
+        features12.descriptorBindingSampledImageUpdateAfterBind  = VK_TRUE;
+        features12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        features12.shaderSampledImageArrayNonUniformIndexing     = VK_TRUE;
+        features12.shaderStorageBufferArrayNonUniformIndexing    = VK_TRUE;
+
+        VkPhysicalDeviceFeatures features {};
+        features.multiDrawIndirect         = VK_TRUE;
+        features.drawIndirectFirstInstance = VK_TRUE;
+
+        // The mip downsampler picks its output level out of an array of storage images
+        features.shaderStorageImageArrayDynamicIndexing = VK_TRUE;
+
+        auto physRet = selector.set_minimum_version(1, 2)
+                         .set_required_features(features)
+                         .set_required_features_12(features12)
+                         .select();
 
         if (!physRet) {
             std::cerr << "Failed to select physical device: " << physRet.error().message() << std::endl;
@@ -212,6 +1069,20 @@ namespace North::Graphics {
         mVkbPhysicalDevice = physRet.value();
         mPhysicalDevice    = mVkbPhysicalDevice.physical_device;
 
+        // Lets VMA report how much of each heap this process can actually use, instead of a guess from the heap size
+        mMemoryBudgetSupported = mVkbPhysicalDevice.enable_extension_if_present(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+        // Optional, the render pass path is kept for devices without it
+        if (mDynamicRenderingRequested) {
+            VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRendering {};
+            dynamicRendering.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+            dynamicRendering.dynamicRendering = VK_TRUE;
+
+            mDynamicRendering =
+              mVkbPhysicalDevice.enable_extension_if_present(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) &&
+              mVkbPhysicalDevice.enable_extension_features_if_present(dynamicRendering);
+        }
+
         std::cout << "Selected GPU: " << mVkbPhysicalDevice.name << std::endl;
         return true;
     }
@@ -229,6 +1100,14 @@ namespace North::Graphics {
         mVkbDevice = devRet.value();
         mDevice    = mVkbDevice.device;
 
+        if (mDynamicRendering) {
+            mCmdBeginRendering =
+              RCAST<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(mDevice, "vkCmdBeginRenderingKHR"));
+            mCmdEndRendering = RCAST<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(mDevice, "vkCmdEndRenderingKHR"));
+            mDynamicRendering = mCmdBeginRendering != nullptr && mCmdEndRendering != nullptr;
+        }
+        std::cout << "Rendering with " << (mDynamicRendering ? "dynamic rendering" : "render passes") << std::endl;
+
         // Get queues
         auto graphicsQueueRet = mVkbDevice.get_queue(vkb::QueueType::graphics);
         if (!graphicsQueueRet) {
@@ -237,6 +1116,8 @@ namespace North::Graphics {
         }
         mGraphicsQueue = graphicsQueueRet.value();
 
+        if (mHeadless) { return true; }
+
         auto presentQueueRet = mVkbDevice.get_queue(vkb::QueueType::present);
         if (!presentQueueRet) {
             std::cerr << "Failed to get present queue: " << presentQueueRet.error().message() << std::endl;
@@ -249,10 +1130,11 @@ namespace North::Graphics {
 
     bool RenderContext::CreateAllocator() {
         VmaAllocatorCreateInfo allocatorInfo {};
-        allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_1;
+        allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_2;
         allocatorInfo.physicalDevice   = mPhysicalDevice;
         allocatorInfo.device           = mDevice;
         allocatorInfo.instance         = mInstance;
+        if (mMemoryBudgetSupported) { allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT; }
 
         if (vmaCreateAllocator(&allocatorInfo, &mAllocator) != VK_SUCCESS) {
             std::cerr << "Failed to create VMA allocator!" << std::endl;
@@ -266,32 +1148,39 @@ namespace North::Graphics {
         // Store the old swapchain handle for retirement
         VkSwapchainKHR oldSwapchain = mSwapchain;
 
-        // Cleanup old swapchain resources if recreating (but keep the swapchain handle for now)
-        if (oldSwapchain != VK_NULL_HANDLE) {
-            // Destroy framebuffers and image views, but not the swapchain itself yet
-            for (const auto framebuffer : mFramebuffers) {
-                vkDestroyFramebuffer(mDevice, framebuffer, nullptr);
-            }
-            mFramebuffers.clear();
+        // Create new swapchain (passing old swapchain for efficient recreation)
+        vkb::SwapchainBuilder swapchainBuilder {mVkbDevice};
 
-            for (const auto imageView : mSwapchainImageViews) {
-                vkDestroyImageView(mDevice, imageView, nullptr);
-            }
-            mSwapchainImageViews.clear();
+        // TRANSFER_SRC lets frames be captured straight from the swapchain image, when the surface allows it
+        VkSurfaceCapabilitiesKHR capabilities {};
+        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mPhysicalDevice, mSurface, &capabilities);
+        mSwapchainCapture = (capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
+
+        VkImageUsageFlags usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        if (mSwapchainCapture) { usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT; }
+
+        swapchainBuilder.set_old_swapchain(oldSwapchain)
+          .set_desired_extent(mWidth, mHeight)
+          .set_image_usage_flags(usage)
+          .set_desired_present_mode(ToVkPresentMode(mPresentMode));
+
+        // Immediate is the only mode without a vsync'd fallback better than FIFO; FIFO is always supported
+        if (mPresentMode == PresentMode::Immediate) {
+            swapchainBuilder.add_fallback_present_mode(VK_PRESENT_MODE_MAILBOX_KHR);
         }
+        swapchainBuilder.add_fallback_present_mode(VK_PRESENT_MODE_FIFO_KHR);
 
-        // Create new swapchain (passing old swapchain for efficient recreation)
-        vkb::SwapchainBuilder swapchainBuilder {mVkbDevice};
+        if (mSwapchainImageCount > 0) { swapchainBuilder.set_desired_min_image_count(mSwapchainImageCount); }
 
-        auto swapRet = swapchainBuilder.set_old_swapchain(oldSwapchain).set_desired_extent(mWidth, mHeight).build();
+        auto swapRet = swapchainBuilder.build();
 
         if (!swapRet) {
             std::cerr << "Failed to create swapchain: " << swapRet.error().message() << std::endl;
             return false;
         }
 
-        // Now destroy the old swapchain (the new one is created)
-        if (oldSwapchain != VK_NULL_HANDLE) { vkDestroySwapchainKHR(mDevice, oldSwapchain, nullptr); }
+        // The new one exists now, hand the old swapchain, its views and framebuffers over for deferred destruction
+        if (oldSwapchain != VK_NULL_HANDLE) { RetireRenderTargets(); }
 
         mVkbSwapchain         = swapRet.value();
         mSwapchain            = mVkbSwapchain.swapchain;
@@ -300,11 +1189,62 @@ namespace North::Graphics {
         mSwapchainImageFormat = mVkbSwapchain.image_format;
         mSwapchainExtent      = mVkbSwapchain.extent;
 
+        const PresentMode activeMode = FromVkPresentMode(mVkbSwapchain.present_mode);
+        if (mPresentModeChanged && activeMode != mPresentMode) {
+            std::cout << "Present mode " << PresentModeName(mPresentMode) << " not supported, using "
+                      << PresentModeName(activeMode) << std::endl;
+        }
+        mActivePresentMode  = activeMode;
+        mPresentModeChanged = false;
+
+        return true;
+    }
+
+    bool RenderContext::CreateOffscreenTarget() {
+        ImageDesc desc;
+        desc.extent = {mWidth, mHeight, 1};
+        desc.format = kOffscreenFormat;
+        desc.usage  = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+        if (!mOffscreenTarget.Create(mDevice, mAllocator, desc)) {
+            std::cerr << "Failed to create offscreen image!" << std::endl;
+            return false;
+        }
+        if (mOffscreenTarget.GetView() == VK_NULL_HANDLE) {
+            std::cerr << "Failed to create offscreen image view!" << std::endl;
+            return false;
+        }
+
+        // The rest of the renderer only looks at these, so it doesn't need to care whether a swapchain exists
+        mSwapchainImageFormat = kOffscreenFormat;
+        mSwapchainExtent      = {mWidth, mHeight};
+
+        return true;
+    }
+
+    bool RenderContext::CreateDepthTarget() {
+        if (mDepthFormat == VK_FORMAT_UNDEFINED) { mDepthFormat = FindDepthFormat(mPhysicalDevice); }
+
+        ImageDesc desc;
+        desc.extent = {mSwapchainExtent.width, mSwapchainExtent.height, 1};
+        desc.format = mDepthFormat;
+        desc.usage  = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+        if (!mDepthTarget.Create(mDevice, mAllocator, desc)) {
+            std::cerr << "Failed to create depth image!" << std::endl;
+            return false;
+        }
+        if (mDepthTarget.GetView() == VK_NULL_HANDLE) {
+            std::cerr << "Failed to create depth image view!" << std::endl;
+            return false;
+        }
+
         return true;
     }
 
     bool RenderContext::CreateRenderPass() {
-        VkAttachmentDescription colorAttachment {};
+        VkAttachmentDescription attachments[2] {};
+        VkAttachmentDescription& colorAttachment = attachments[0];
         colorAttachment.format         = mSwapchainImageFormat;
         colorAttachment.samples        = VK_SAMPLE_COUNT_1_BIT;
         colorAttachment.loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR;
@@ -312,16 +1252,35 @@ namespace North::Graphics {
         colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-        colorAttachment.finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        // Offscreen frames are left ready to be copied out instead of presented
+        colorAttachment.finalLayout =
+          mHeadless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+        // Transitioned by its own tracking before every pass, so it never changes layout in one. Stored for the
+        // Hi-Z pyramid.
+        VkAttachmentDescription& depthAttachment = attachments[1];
+        depthAttachment.format                   = mDepthFormat;
+        depthAttachment.samples                  = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachment.loadOp                   = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp                  = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.stencilLoadOp            = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp           = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout            = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.finalLayout              = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
         VkAttachmentReference colorAttachmentRef {};
         colorAttachmentRef.attachment = 0;
         colorAttachmentRef.layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+        VkAttachmentReference depthAttachmentRef {};
+        depthAttachmentRef.attachment = 1;
+        depthAttachmentRef.layout     = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
         VkSubpassDescription subpass {};
-        subpass.pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass.colorAttachmentCount = 1;
-        subpass.pColorAttachments    = &colorAttachmentRef;
+        subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount    = 1;
+        subpass.pColorAttachments       = &colorAttachmentRef;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
 
         VkSubpassDependency dependency {};
         dependency.srcSubpass    = VK_SUBPASS_EXTERNAL;
@@ -331,10 +1290,17 @@ namespace North::Graphics {
         dependency.dstStageMask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
 
+        // Every frame in flight writes the same offscreen image, so order against the previous frame's writes and
+        // copies. The swapchain path gets this from the acquire semaphore instead.
+        if (mHeadless) {
+            dependency.srcStageMask |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+            dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        }
+
         VkRenderPassCreateInfo renderPassInfo {};
         renderPassInfo.sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        renderPassInfo.attachmentCount = 1;
-        renderPassInfo.pAttachments    = &colorAttachment;
+        renderPassInfo.attachmentCount = 2;
+        renderPassInfo.pAttachments    = attachments;
         renderPassInfo.subpassCount    = 1;
         renderPassInfo.pSubpasses      = &subpass;
         renderPassInfo.dependencyCount = 1;
@@ -345,19 +1311,47 @@ namespace North::Graphics {
             return false;
         }
 
+        // Continues from the depth prepass. Differs only in the load op, so it stays compatible with the same
+        // framebuffers and pipelines.
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        if (vkCreateRenderPass(mDevice, &renderPassInfo, nullptr, &mRenderPassKeepDepth) != VK_SUCCESS) {
+            std::cerr << "Failed to create render pass!" << std::endl;
+            return false;
+        }
+
+        // Depth only, for the occluders
+        depthAttachment.loadOp        = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachmentRef.attachment = 0;
+
+        VkSubpassDescription depthSubpass {};
+        depthSubpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        depthSubpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+        renderPassInfo.attachmentCount = 1;
+        renderPassInfo.pAttachments    = &depthAttachment;
+        renderPassInfo.pSubpasses      = &depthSubpass;
+        renderPassInfo.dependencyCount = 0;
+        renderPassInfo.pDependencies   = nullptr;
+
+        if (vkCreateRenderPass(mDevice, &renderPassInfo, nullptr, &mDepthPrepassRenderPass) != VK_SUCCESS) {
+            std::cerr << "Failed to create depth prepass render pass!" << std::endl;
+            return false;
+        }
+
         return true;
     }
 
     bool RenderContext::CreateFramebuffers() {
-        mFramebuffers.resize(mSwapchainImageViews.size());
+        const vector<VkImageView> colorViews = mHeadless ? vector {mOffscreenTarget.GetView()} : mSwapchainImageViews;
+        mFramebuffers.resize(colorViews.size());
 
-        for (size_t i = 0; i < mSwapchainImageViews.size(); i++) {
-            VkImageView attachments[] = {mSwapchainImageViews[i]};
+        for (size_t i = 0; i < colorViews.size(); i++) {
+            VkImageView attachments[] = {colorViews[i], mDepthTarget.GetView()};
 
             VkFramebufferCreateInfo framebufferInfo {};
             framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
             framebufferInfo.renderPass      = mRenderPass;
-            framebufferInfo.attachmentCount = 1;
+            framebufferInfo.attachmentCount = 2;
             framebufferInfo.pAttachments    = attachments;
             framebufferInfo.width           = mSwapchainExtent.width;
             framebufferInfo.height          = mSwapchainExtent.height;
@@ -369,6 +1363,22 @@ namespace North::Graphics {
             }
         }
 
+        VkImageView depthView = mDepthTarget.GetView();
+
+        VkFramebufferCreateInfo framebufferInfo {};
+        framebufferInfo.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass      = mDepthPrepassRenderPass;
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments    = &depthView;
+        framebufferInfo.width           = mSwapchainExtent.width;
+        framebufferInfo.height          = mSwapchainExtent.height;
+        framebufferInfo.layers          = 1;
+
+        if (vkCreateFramebuffer(mDevice, &framebufferInfo, nullptr, &mDepthPrepassFramebuffer) != VK_SUCCESS) {
+            std::cerr << "Failed to create depth prepass framebuffer!" << std::endl;
+            return false;
+        }
+
         return true;
     }
 
@@ -393,38 +1403,51 @@ namespace North::Graphics {
     }
 
     bool RenderContext::CreateCommandBuffers() {
-        mCommandBuffers.resize(kMaxFramesInFlight);
-
         VkCommandBufferAllocateInfo allocInfo {};
         allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         allocInfo.commandPool        = mCommandPool;
         allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandBufferCount = static_cast<u32>(mCommandBuffers.size());
+        allocInfo.commandBufferCount = 1;
 
-        if (vkAllocateCommandBuffers(mDevice, &allocInfo, mCommandBuffers.data()) != VK_SUCCESS) {
-            std::cerr << "Failed to allocate command buffers!" << std::endl;
-            return false;
+        // Only fills slots that don't have one yet, so this also works when frames in flight are raised at runtime
+        for (auto& frame : mFrames) {
+            if (frame.commandBuffer != VK_NULL_HANDLE) continue;
+
+            if (vkAllocateCommandBuffers(mDevice, &allocInfo, &frame.commandBuffer) != VK_SUCCESS) {
+                std::cerr << "Failed to allocate command buffers!" << std::endl;
+                return false;
+            }
         }
 
         return true;
     }
 
     bool RenderContext::CreateSyncObjects() {
-        mImageAvailableSemaphores.resize(kMaxFramesInFlight);
-        mRenderFinishedSemaphores.resize(kMaxFramesInFlight);
-        mInFlightFences.resize(kMaxFramesInFlight);
-
         VkSemaphoreCreateInfo semaphoreInfo {};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-        VkFenceCreateInfo fenceInfo {};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        if (mFrameTimeline == VK_NULL_HANDLE) {
+            VkSemaphoreTypeCreateInfo typeInfo {};
+            typeInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+            typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            typeInfo.initialValue  = 0;
+
+            VkSemaphoreCreateInfo timelineInfo {};
+            timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            timelineInfo.pNext = &typeInfo;
+
+            if (vkCreateSemaphore(mDevice, &timelineInfo, nullptr, &mFrameTimeline) != VK_SUCCESS) {
+                std::cerr << "Failed to create frame timeline semaphore!" << std::endl;
+                return false;
+            }
+        }
+
+        // Acquire and present still need binary semaphores, the timeline replaces the per-frame fences
+        for (auto& frame : mFrames) {
+            if (frame.imageAvailableSemaphore != VK_NULL_HANDLE) continue;
 
-        for (size_t i = 0; i < kMaxFramesInFlight; i++) {
-            if (vkCreateSemaphore(mDevice, &semaphoreInfo, nullptr, &mImageAvailableSemaphores[i]) != VK_SUCCESS ||
-                vkCreateSemaphore(mDevice, &semaphoreInfo, nullptr, &mRenderFinishedSemaphores[i]) != VK_SUCCESS ||
-                vkCreateFence(mDevice, &fenceInfo, nullptr, &mInFlightFences[i]) != VK_SUCCESS) {
+            if (vkCreateSemaphore(mDevice, &semaphoreInfo, nullptr, &frame.imageAvailableSemaphore) != VK_SUCCESS ||
+                vkCreateSemaphore(mDevice, &semaphoreInfo, nullptr, &frame.renderFinishedSemaphore) != VK_SUCCESS) {
                 std::cerr << "Failed to create synchronization objects!" << std::endl;
                 return false;
             }
@@ -439,6 +1462,8 @@ namespace North::Graphics {
             vkDestroyFramebuffer(mDevice, framebuffer, nullptr);
         }
         mFramebuffers.clear();
+        vkDestroyFramebuffer(mDevice, mDepthPrepassFramebuffer, nullptr);
+        mDepthPrepassFramebuffer = VK_NULL_HANDLE;
 
         // Destroy image views manually before destroying swapchain
         for (const auto imageView : mSwapchainImageViews) {
@@ -5,6 +5,25 @@
 #pragma once
 
 #include "Common/Common.hpp"
+#include "BindlessTable.hpp"
+#include "CpuOcclusionCuller.hpp"
+#include "Defragmenter.hpp"
+#include "DeletionQueue.hpp"
+#include "DescriptorAllocator.hpp"
+#include "GeometryPool.hpp"
+#include "HiZPyramid.hpp"
+#include "Image.hpp"
+#include "IndirectDrawPass.hpp"
+#include "MemoryStats.hpp"
+#include "MipGenerator.hpp"
+#include "PipelineCache.hpp"
+#include "PipelineManager.hpp"
+#include "ReadbackQueue.hpp"
+#include "RenderCommand.hpp"
+#include "ShaderLibrary.hpp"
+#include "TextureStreamer.hpp"
+#include "UniformRing.hpp"
+#include "Common/ThreadPool.hpp"
 
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
@@ -12,20 +31,318 @@
 #include <GLFW/glfw3.h>
 
 namespace North::Graphics {
+    /// @brief How finished frames are handed to the display
+    enum class PresentMode : u8 {
+        Fifo,         ///< Vsync, frames queue up behind each other. Always supported, highest latency.
+        FifoRelaxed,  ///< Vsync, but a frame that missed its vblank is shown right away (may tear)
+        Mailbox,      ///< Vsync, a newer frame replaces the queued one. Low latency without tearing.
+        Immediate,    ///< No vsync, lowest latency, tears
+    };
+
+    /// @brief Time from the oldest input event a frame reacted to until that frame was queued for presentation.
+    /// Measured on the CPU, so time spent in the presentation engine and display itself isn't included.
+    struct PresentLatency {
+        f64 lastMs    = 0;
+        f64 averageMs = 0;
+        f64 maxMs     = 0;
+        u64 samples   = 0;
+    };
+
+    /// @brief Average time to build a full mip chain, see RenderContext::BenchmarkMipGeneration()
+    struct MipBenchmark {
+        f64 computeMs = 0;  // Single-pass compute, 0 if unavailable
+        f64 blitMs    = 0;  // One vkCmdBlitImage per level
+        f64 cpuMs     = 0;  // CpuDownsampler, on the calling thread
+        u32 levels    = 0;
+    };
+
     class RenderContext {
     public:
+        static constexpr u32 kDefaultFramesInFlight = 2;
+        /// @brief Geometry pool capacity, 32 MB of vertices and 16 MB of indices
+        static constexpr u32 kGeometryPoolVertices = 1u << 20;
+        static constexpr u32 kGeometryPoolIndices  = 1u << 22;
+        /// @brief The CPU occlusion culler's depth buffer is this many times smaller than the swapchain each way
+        static constexpr u32 kCpuOcclusionDownscale = 4;
+
         RenderContext() = default;
 
+        /// @brief Pass a null window to run headless: no surface or swapchain, frames render into an offscreen target
         void Initialize(GLFWwindow* window, u32 width, u32 height);
         void Shutdown();
 
         void DrawFrame();
         void Resize(u32 width, u32 height);
 
+        /// @brief Copy the next frame's color output back to the CPU. Never stalls; the image is returned by
+        /// TakeCaptures() a few frames later, once the GPU is known to be done with it.
+        /// @return false if the surface's swapchain images can't be copied from
+        bool RequestCapture();
+
+        /// @brief Returns (and clears) every capture that has completed so far, oldest first
+        NE_ND vector<CapturedImage> TakeCaptures();
+
+        /// @brief How many frames the CPU may record ahead of the GPU. Can be changed at any time, including
+        /// before Initialize(); changing it never waits on the GPU.
+        void SetFramesInFlight(u32 count);
+
+        NE_ND u32 GetFramesInFlight() const {
+            return mFramesInFlight;
+        }
+
+        /**
+         * @brief Requested present mode
+         *
+         * Falls back towards FIFO when the surface doesn't support it (Immediate tries Mailbox first). Can be
+         * called before Initialize(); at runtime the swapchain is recreated at the start of the next frame.
+         */
+        void SetPresentMode(PresentMode mode);
+
+        NE_ND PresentMode GetPresentMode() const {
+            return mPresentMode;
+        }
+
+        /// @brief Present mode the swapchain actually ended up with
+        NE_ND PresentMode GetActivePresentMode() const {
+            return mActivePresentMode;
+        }
+
+        /// @brief Minimum number of swapchain images to ask for, clamped to what the surface allows. Fewer images
+        /// means fewer frames queued for display. 0 lets the driver decide (its minimum plus one).
+        void SetSwapchainImageCount(u32 count);
+
+        NE_ND u32 GetSwapchainImageCount() const {
+            return CAST<u32>(mSwapchainImages.size());
+        }
+
+        /// @brief Records when input arrived (Clock::Now() seconds) for the next presented frame's latency sample
+        void MarkInput(f64 timestamp);
+
+        NE_ND const PresentLatency& GetPresentLatency() const {
+            return mPresentLatency;
+        }
+
+        void ResetPresentLatency();
+
+        /// @brief Queue a mesh for this frame. Commands sharing a mesh are instanced together, culled on the GPU
+        /// and drawn in one indirect call. The command is copied so it doesn't need to outlive the call.
+        void Submit(const DrawCommand& command);
+
+        /// @brief Queue a low-poly occluder for this frame's CPU occlusion culling. Its positions and indices are
+        /// referenced, not copied, and have to stay alive until the next DrawFrame() returns.
+        void SubmitOccluder(const Occluder& occluder);
+
+        /// @brief Camera used for culling and drawing from the next DrawFrame() on
+        void SetCamera(const Mat4x4& view, const Mat4x4& projection, const Vec3& position);
+
+        NE_ND const FrameConstants& GetFrameConstants() const {
+            return mFrameConstants;
+        }
+
+        /// @brief Per-frame uniform memory. Allocations are valid for the frame being recorded and are bound
+        /// through FrameData::globalDescriptorSet with their offset as the kDrawBinding dynamic offset.
+        NE_ND UniformRing& GetUniformRing() {
+            return mUniformRing;
+        }
+
+        /// @brief Transient descriptor sets for the frame being recorded, and the shared set layout cache
+        NE_ND DescriptorAllocator& GetDescriptorAllocator() {
+            return mDescriptorAllocator;
+        }
+
+        /// @brief Where the pipeline cache is kept between runs, PipelineCache::GetDefaultPath() unless changed.
+        /// Empty disables persisting it. Only takes effect before Initialize().
+        void SetPipelineCachePath(const fs::path& path) {
+            mPipelineCachePath = path;
+        }
+
+        NE_ND const fs::path& GetPipelineCachePath() const {
+            return mPipelineCachePath;
+        }
+
+        NE_ND VkPipelineCache GetPipelineCache() const {
+            return mPipelineCache.GetHandle();
+        }
+
+        /// @brief Whether this run started from a cache on disk and how long startup pipelines took to build
+        NE_ND PipelineCacheStats GetPipelineCacheStats() const {
+            return mPipelineCache.GetStats();
+        }
+
+        /// @brief Draw straight into the target's image view with VK_KHR_dynamic_rendering (core in 1.3) when the
+        /// device supports it, instead of through a render pass and framebuffers. On by default, only takes effect
+        /// before Initialize().
+        void SetDynamicRendering(bool enabled) {
+            mDynamicRenderingRequested = enabled;
+        }
+
+        /// @brief Whether frames are drawn with dynamic rendering, false on the render pass fallback
+        NE_ND bool UsesDynamicRendering() const {
+            return mDynamicRendering;
+        }
+
+        /// @brief What pipelines drawing in the frame are built against: this render pass, or when it's
+        /// VK_NULL_HANDLE (dynamic rendering), GetColorFormat() and GetDepthFormat() as the attachment formats
+        NE_ND VkRenderPass GetRenderPass() const {
+            return mRenderPass;
+        }
+
+        NE_ND VkFormat GetColorFormat() const {
+            return mSwapchainImageFormat;
+        }
+
+        NE_ND VkFormat GetDepthFormat() const {
+            return mDepthFormat;
+        }
+
+        /// @brief Skip objects hidden behind others, tested on the GPU against a Hi-Z pyramid of the depth buffer.
+        /// On by default, can be changed at any time.
+        void SetOcclusionCulling(bool enabled) {
+            mOcclusionCulling = enabled;
+        }
+
+        NE_ND bool GetOcclusionCulling() const {
+            return mOcclusionCulling;
+        }
+
+        /// @brief Drop submitted draws hidden behind SubmitOccluder() occluders on the CPU, before anything is
+        /// written for the GPU. Meant for when the GPU occlusion test is off or unavailable. Off by default.
+        void SetCpuOcclusionCulling(bool enabled) {
+            mCpuOcclusionCulling = enabled;
+        }
+
+        NE_ND bool GetCpuOcclusionCulling() const {
+            return mCpuOcclusionCulling;
+        }
+
+        /// @brief Draw a frame's occluders (DrawCommand::occluder) depth-only before culling and test against
+        /// their depth, instead of last frame's. On by default, only frames with occluders get the extra pass.
+        void SetDepthPrepass(bool enabled) {
+            mDepthPrepassEnabled = enabled;
+        }
+
+        NE_ND bool GetDepthPrepass() const {
+            return mDepthPrepassEnabled;
+        }
+
+        /// @brief Graphics pipelines by description, compiled on worker threads the first time they're requested
+        NE_ND PipelineManager& GetPipelineManager() {
+            return mPipelineManager;
+        }
+
+        /// @brief Heap budgets and usage, live allocations by type and fragmentation. Walks every VMA block, so
+        /// it's meant for stats readouts rather than every frame.
+        NE_ND MemoryStats GetMemoryStats() const {
+            return MemoryReport::Collect(mAllocator);
+        }
+
+        /// @brief VMA's JSON stats dump, `detailed` lists every allocation by name
+        NE_ND string GetMemoryStatsJson(bool detailed = false) const {
+            return MemoryReport::BuildJson(mAllocator, detailed);
+        }
+
+        /// @brief Fills in texture mip chains on the GPU
+        NE_ND MipGenerator& GetMipGenerator() {
+            return mMipGenerator;
+        }
+
+        /**
+         * @brief Times mip generation of a size x size RGBA8 image through every path
+         *
+         * GPU paths are measured with timestamp queries around each one, recorded into a single command buffer
+         * and waited on. Stalls the graphics queue, call it outside the frame loop.
+         */
+        MipBenchmark BenchmarkMipGeneration(u32 size, u32 iterations);
+
+        /// @brief Textures streamed in by screen size under a GPU memory budget
+        NE_ND TextureStreamer& GetTextureStreamer() {
+            return mTextureStreamer;
+        }
+
+        /// @brief Moves relocatable buffers and images around to compact GPU memory, a bounded amount per frame
+        NE_ND Defragmenter& GetDefragmenter() {
+            return mDefragmenter;
+        }
+
+        /// @brief Shader modules by variant, shared by every pipeline that uses them
+        NE_ND ShaderLibrary& GetShaderLibrary() {
+            return mShaderLibrary;
+        }
+
+        /// @brief Culls against occluders on the CPU, used by DrawFrame() with SetCpuOcclusionCulling(). Sized with
+        /// the swapchain, run it on GetThreadPool() to use it directly.
+        NE_ND CpuOcclusionCuller& GetCpuOcclusionCuller() {
+            return mCpuOcclusionCuller;
+        }
+
+        /// @brief Renderer worker threads, started by Initialize()
+        NE_ND ThreadPool& GetThreadPool() {
+            return mThreadPool;
+        }
+
+        /// @brief Global texture/buffer/sampler arrays, pipelines that use them bind it at set
+        /// BindlessTable::kDescriptorSet
+        NE_ND BindlessTable& GetBindlessTable() {
+            return mBindlessTable;
+        }
+
+        /**
+         * @brief GPU progress
+         *
+         * Every submitted frame signals its frame number on a single timeline semaphore. Anything stamped with
+         * a frame number (deferred deletions, uploads, readbacks) is safe to touch once the completed frame
+         * has reached it, without waiting on or polling per-frame fences.
+         */
+        NE_ND u64 GetFrameNumber() const {
+            return mFrameNumber;
+        }
+
+        /// @brief Last frame known to be finished on the GPU, as of the last PollCompletedFrame()
+        NE_ND u64 GetCompletedFrame() const {
+            return mCompletedFrame;
+        }
+
+        /// @brief Re-reads the timeline semaphore's counter without blocking
+        u64 PollCompletedFrame();
+
+        NE_ND bool IsFrameComplete(u64 frameNumber) const {
+            return frameNumber <= mCompletedFrame;
+        }
+
+        NE_ND VkSemaphore GetFrameTimeline() const {
+            return mFrameTimeline;
+        }
+
+        /// @brief Retire GPU resources here instead of destroying them, flushed as the frame timeline advances
+        NE_ND DeletionQueue& GetDeletionQueue() {
+            return mDeletionQueue;
+        }
+
+        /// @brief Shared vertex/index storage for all meshes, uploads are recorded at the start of each frame
+        NE_ND GeometryPool& GetGeometryPool() {
+            return mGeometryPool;
+        }
+
+        NE_ND VkDevice GetDevice() const {
+            return mDevice;
+        }
+
+        NE_ND VkPhysicalDevice GetPhysicalDevice() const {
+            return mPhysicalDevice;
+        }
+
+        NE_ND VmaAllocator GetAllocator() const {
+            return mAllocator;
+        }
+
         NE_ND bool Initialized() const {
             return mInitialized;
         }
 
+        NE_ND bool IsHeadless() const {
+            return mHeadless;
+        }
+
     private:
         // Initialization helpers
         bool CreateInstance();
@@ -33,18 +350,39 @@ namespace North::Graphics {
         bool CreateDevice();
         bool CreateAllocator();
         bool CreateSwapchain();
+        bool CreateOffscreenTarget();
+        bool CreateDepthTarget();
         bool CreateRenderPass();
         bool CreateFramebuffers();
         bool CreateCommandPool();
         bool CreateCommandBuffers();
         bool CreateSyncObjects();
 
+        void RecreateRenderTargets();
+
+        // Start and end drawing into the frame's color target, through the render pass or dynamic rendering.
+        // `keepDepth` starts from what the depth prepass drew instead of clearing it.
+        void BeginMainPass(VkCommandBuffer cmd, u32 imageIndex, bool keepDepth);
+        void EndMainPass(VkCommandBuffer cmd, u32 imageIndex);
+        void BeginDepthPrepass(VkCommandBuffer cmd);
+        void EndDepthPrepass(VkCommandBuffer cmd);
+
+        // Drops the draws CpuOcclusionCuller finds hidden behind this frame's occluders, draws that are occluders
+        // themselves stay for the depth prepass
+        void CullOccludedDraws(vector<DrawCommand>& drawCommands);
+
+        void RecordCapture(VkCommandBuffer cmd, u32 imageIndex);
+        void RecordPresentLatency();
+        void WaitForFrame(u64 frameNumber);
+
         // Cleanup helpers
         void CleanupSwapchain();
+        void RetireRenderTargets();
 
         u32 mWidth        = 0;
         u32 mHeight       = 0;
         bool mInitialized = false;
+        bool mHeadless    = false;
 
         // Vulkan core objects
         vkb::Instance mVkbInstance;
@@ -58,6 +396,7 @@ namespace North::Graphics {
         VkSurfaceKHR mSurface            = VK_NULL_HANDLE;
         VkQueue mGraphicsQueue           = VK_NULL_HANDLE;
         VkQueue mPresentQueue            = VK_NULL_HANDLE;
+        bool mMemoryBudgetSupported      = false;  // VK_EXT_memory_budget, VMA reports real heap budgets with it
 
         // Swapchain
         VkSwapchainKHR mSwapchain = VK_NULL_HANDLE;
@@ -65,21 +404,105 @@ namespace North::Graphics {
         vector<VkImageView> mSwapchainImageViews;
         VkFormat mSwapchainImageFormat {};
         VkExtent2D mSwapchainExtent {};
+        PresentMode mPresentMode       = PresentMode::Fifo;
+        PresentMode mActivePresentMode = PresentMode::Fifo;
+        u32 mSwapchainImageCount       = 0;
+        bool mPresentModeChanged       = true;  // Report a fallback once per requested mode, not every resize
+
+        // Input-to-present latency
+        f64 mPendingInputTime = 0;
+        PresentLatency mPresentLatency;
+
+        // Offscreen color target, stands in for the swapchain when running headless
+        static constexpr VkFormat kOffscreenFormat = VK_FORMAT_R8G8B8A8_UNORM;
+        Image mOffscreenTarget;
 
-        // Render pass and framebuffers
-        VkRenderPass mRenderPass = VK_NULL_HANDLE;
+        // Depth buffer, shared by every frame in flight like the offscreen target. Sampled into the Hi-Z pyramid.
+        VkFormat mDepthFormat = VK_FORMAT_UNDEFINED;
+        Image mDepthTarget;
+
+        // Render passes and framebuffers, none exist with dynamic rendering. The main pass has a compatible variant
+        // that keeps the depth prepass's depth instead of clearing it, both use the same framebuffers.
+        VkRenderPass mRenderPass             = VK_NULL_HANDLE;
+        VkRenderPass mRenderPassKeepDepth    = VK_NULL_HANDLE;
+        VkRenderPass mDepthPrepassRenderPass = VK_NULL_HANDLE;
         vector<VkFramebuffer> mFramebuffers;
+        VkFramebuffer mDepthPrepassFramebuffer = VK_NULL_HANDLE;
+        bool mRenderTargetsDirty               = false;
+
+        // The instance targets 1.2, so the commands come from the extension and are loaded with the device
+        bool mDynamicRenderingRequested               = true;
+        bool mDynamicRendering                        = false;
+        PFN_vkCmdBeginRenderingKHR mCmdBeginRendering = nullptr;
+        PFN_vkCmdEndRenderingKHR mCmdEndRendering     = nullptr;
 
         // Command buffers
         VkCommandPool mCommandPool = VK_NULL_HANDLE;
-        vector<VkCommandBuffer> mCommandBuffers;
-
-        // Synchronization
-        static constexpr i32 kMaxFramesInFlight = 2;
-        vector<VkSemaphore> mImageAvailableSemaphores;
-        vector<VkSemaphore> mRenderFinishedSemaphores;
-        vector<VkFence> mInFlightFences;
-        u32 mCurrentFrame = 0;
+
+        // Per-frame resources and synchronization. Can hold more slots than mFramesInFlight after the count was
+        // lowered at runtime, the extra ones are simply not used until it's raised again.
+        vector<FrameData> mFrames;
+        u32 mFramesInFlight = kDefaultFramesInFlight;
+        u32 mCurrentFrame   = 0;
+
+        // Frame numbers start at 1, 0 means "no frame". The timeline's counter value is the last completed frame.
+        VkSemaphore mFrameTimeline = VK_NULL_HANDLE;
+        u64 mFrameNumber           = 1;
+        u64 mCompletedFrame        = 0;
+
+        // Resources waiting for the GPU to finish with them
+        DeletionQueue mDeletionQueue;
+
+        // Mesh data and GPU-driven drawing. The pass stays uninitialized (and submissions are dropped) when its
+        // shaders are missing.
+        GeometryPool mGeometryPool;
+        IndirectDrawPass mIndirectDrawPass;
+
+        // Occlusion culling. The pyramid holds the depth prepass when the frame had one, the last frame's depth
+        // otherwise.
+        HiZPyramid mHiZPyramid;
+        bool mOcclusionCulling    = true;
+        bool mDepthPrepassEnabled = true;
+        CpuOcclusionCuller mCpuOcclusionCuller;
+        bool mCpuOcclusionCulling = false;
+        vector<Occluder> mCpuOccluders;
+        vector<OcclusionBounds> mCpuOcclusionBounds;
+        vector<u8> mCpuOcclusionVisible;
+
+        // Blits only when Downsample.comp is missing
+        MipGenerator mMipGenerator;
+
+        // Texture mips resident within a memory budget, uploads recorded at the start of every frame
+        TextureStreamer mTextureStreamer;
+
+        // Compacts memory churned by streaming, passes recorded ahead of everything else in the frame
+        Defragmenter mDefragmenter;
+
+        // Per-frame uniforms. FrameConstants are pushed into the ring at the start of every frame.
+        UniformRing mUniformRing;
+        FrameConstants mFrameConstants {};
+        u32 mFrameConstantsOffset = 0;
+        f64 mStartTime            = 0;
+        f64 mLastFrameTime        = 0;
+
+        // Descriptor sets that only live for one frame, reset with the frame's slot
+        DescriptorAllocator mDescriptorAllocator;
+
+        // Descriptor indices for every registered resource
+        BindlessTable mBindlessTable;
+
+        // Compiled pipelines, persisted across runs, and the workers compiling new ones
+        PipelineCache mPipelineCache;
+        fs::path mPipelineCachePath = PipelineCache::GetDefaultPath();
+        ShaderLibrary mShaderLibrary;
+        PipelineManager mPipelineManager;
+        ThreadPool mThreadPool;
+
+        // Frame capture
+        ReadbackQueue mReadbackQueue;
+        vector<CapturedImage> mCompletedCaptures;
+        bool mCaptureRequested = false;
+        bool mSwapchainCapture = false;  // The surface supports TRANSFER_SRC swapchain images
 
         // Memory allocator
         VmaAllocator mAllocator = VK_NULL_HANDLE;
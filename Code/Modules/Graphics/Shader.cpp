@@ -0,0 +1,55 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#include "Shader.hpp"
+#include <fstream>
+#include <iostream>
+
+#ifndef NE_CONTENT_DIR
+    #define NE_CONTENT_DIR "Content"
+#endif
+
+namespace North::Graphics {
+    fs::path Shader::GetCompiledPath(const string& name) {
+        return fs::path(NE_CONTENT_DIR) / "Shaders" / "Compiled" / (name + ".spv");
+    }
+
+    vector<u32> Shader::LoadSpirv(const fs::path& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open shader: " << path.string() << std::endl;
+            return {};
+        }
+
+        const auto size = CAST<size_t>(file.tellg());
+        if (size == 0 || size % sizeof(u32) != 0) {
+            std::cerr << "Invalid SPIR-V size in shader: " << path.string() << std::endl;
+            return {};
+        }
+
+        vector<u32> code(size / sizeof(u32));
+        file.seekg(0);
+        file.read(RCAST<char*>(code.data()), CAST<std::streamsize>(size));
+
+        return code;
+    }
+
+    VkShaderModule Shader::CreateModule(VkDevice device, const string& name) {
+        const vector<u32> code = LoadSpirv(GetCompiledPath(name));
+        if (code.empty()) { return VK_NULL_HANDLE; }
+
+        VkShaderModuleCreateInfo createInfo {};
+        createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size() * sizeof(u32);
+        createInfo.pCode    = code.data();
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        if (vkCreateShaderModule(device, &createInfo, nullptr, &module) != VK_SUCCESS) {
+            std::cerr << "Failed to create shader module: " << name << std::endl;
+            return VK_NULL_HANDLE;
+        }
+
+        return module;
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,31 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace North::Graphics {
+    /**
+     * @brief Loads compiled SPIR-V shaders
+     *
+     * GLSL and HLSL sources live in Content/Shaders/Source and are compiled by the build (Code/Tools/ShaderCompiler)
+     * into Content/Shaders/Compiled/<file name>.spv, e.g. "Cull.comp" -> "Cull.comp.spv". Their descriptor and push
+     * constant layouts are next to them, see ShaderReflection.
+     */
+    class Shader {
+    public:
+        /// @brief Path of the compiled SPIR-V for a shader source file name
+        static fs::path GetCompiledPath(const string& name);
+
+        /// @brief Read a SPIR-V binary, returns an empty vector if the file is missing or malformed
+        static vector<u32> LoadSpirv(const fs::path& path);
+
+        /// @brief Load a compiled shader by source file name and create a module from it
+        /// @return VK_NULL_HANDLE on failure
+        static VkShaderModule CreateModule(VkDevice device, const string& name);
+    };
+}  // namespace North::Graphics
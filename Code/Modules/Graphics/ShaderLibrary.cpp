@@ -0,0 +1,88 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "ShaderLibrary.hpp"
+#include "Shader.hpp"
+
+#include <iostream>
+
+namespace North::Graphics {
+    void ShaderLibrary::Initialize(VkDevice device) {
+        mDevice = device;
+    }
+
+    void ShaderLibrary::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        std::lock_guard lock(mMutex);
+        for (auto& [name, module] : mModules) {
+            vkDestroyShaderModule(mDevice, module, nullptr);
+        }
+        mModules.clear();
+        mVariants.clear();
+        mStats = {};
+
+        mDevice = VK_NULL_HANDLE;
+    }
+
+    VkShaderModule ShaderLibrary::GetModule(const string& name, u64 variant) {
+        std::lock_guard lock(mMutex);
+        mStats.lookups++;
+
+        const optional<u64> source = GetVariants(name).Resolve(variant);
+        if (!source) {
+            std::cerr << "Variant " << std::hex << variant << std::dec << " of shader " << name
+                      << " wasn't built, add it to Content/Shaders/Source/Variants.txt" << std::endl;
+            return VK_NULL_HANDLE;
+        }
+        if (*source != variant) { mStats.sharedLoads++; }
+
+        const string variantName = ShaderVariantTable::GetVariantName(name, *source);
+        if (auto it = mModules.find(variantName); it != mModules.end()) return it->second;
+
+        const vector<u32> code = Shader::LoadSpirv(Shader::GetCompiledPath(variantName));
+        if (code.empty()) return VK_NULL_HANDLE;
+
+        VkShaderModuleCreateInfo createInfo {};
+        createInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size() * sizeof(u32);
+        createInfo.pCode    = code.data();
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        if (vkCreateShaderModule(mDevice, &createInfo, nullptr, &module) != VK_SUCCESS) {
+            std::cerr << "Failed to create shader module: " << variantName << std::endl;
+            return VK_NULL_HANDLE;
+        }
+
+        mModules.emplace(variantName, module);
+        mStats.modules++;
+        mStats.spirvBytes += createInfo.codeSize;
+
+        return module;
+    }
+
+    bool ShaderLibrary::GetVariantMask(const string& name, const vector<string>& features, u64& mask) {
+        std::lock_guard lock(mMutex);
+        return GetVariants(name).GetMask(features, mask);
+    }
+
+    ShaderLibraryStats ShaderLibrary::GetStats() const {
+        std::lock_guard lock(mMutex);
+        return mStats;
+    }
+
+    const ShaderVariantTable& ShaderLibrary::GetVariants(const string& name) {
+        if (auto it = mVariants.find(name); it != mVariants.end()) return it->second;
+
+        // Shaders without features have no table, their only variant is the base one
+        ShaderVariantTable table;
+        const fs::path path = ShaderVariantTable::GetPath(name);
+        if (!fs::exists(path) || !ShaderVariantTable::Load(path, table)) {
+            table          = {};
+            table.variants = {{0, 0}};
+        }
+
+        return mVariants.emplace(name, std::move(table)).first->second;
+    }
+}  // namespace North::Graphics
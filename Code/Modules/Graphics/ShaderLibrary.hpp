@@ -0,0 +1,64 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "ShaderVariants.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace North::Graphics {
+    struct ShaderLibraryStats {
+        u64 modules     = 0;  // Unique SPIR-V blobs loaded
+        u64 spirvBytes  = 0;  // Their combined size
+        u64 lookups     = 0;
+        u64 sharedLoads = 0;  // Lookups of a variant whose code was deduplicated into another one
+    };
+
+    /**
+     * @brief Shader modules by name and variant mask, loaded the first time a variant is used
+     *
+     * Variant masks are per shader, see ShaderVariantTable. Variants the compiler found to be identical resolve to
+     * one VkShaderModule, so loading time and module memory only grow with the distinct code actually requested.
+     * Features that don't need separate SPIR-V belong in specialization constants instead
+     * (GraphicsPipelineDesc::specialization).
+     *
+     * Thread-safe, pipelines are compiled on worker threads.
+     */
+    class ShaderLibrary {
+    public:
+        ShaderLibrary() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(ShaderLibrary)
+
+        void Initialize(VkDevice device);
+
+        /// @brief Destroys every module. Pipelines built from them stay valid.
+        void Shutdown();
+
+        /// @brief Module of one variant, owned by the library
+        /// @return VK_NULL_HANDLE if the shader is missing or that variant wasn't built
+        VkShaderModule GetModule(const string& name, u64 variant = 0);
+
+        /// @brief Variant mask enabling the named features of a shader
+        /// @return false if the shader doesn't declare one of them
+        bool GetVariantMask(const string& name, const vector<string>& features, u64& mask);
+
+        NE_ND ShaderLibraryStats GetStats() const;
+
+    private:
+        const ShaderVariantTable& GetVariants(const string& name);
+
+        VkDevice mDevice = VK_NULL_HANDLE;
+
+        mutable std::mutex mMutex;
+        std::unordered_map<string, ShaderVariantTable> mVariants;  // By shader name
+        std::unordered_map<string, VkShaderModule> mModules;       // By variant name of the code's owner
+        ShaderLibraryStats mStats;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,226 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "ShaderReflection.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#ifndef NE_CONTENT_DIR
+    #define NE_CONTENT_DIR "Content"
+#endif
+
+namespace North::Graphics {
+    namespace {
+        struct FileHeader {
+            u32 magic;
+            u32 version;
+            u32 stage;
+            u32 bindingCount;
+            u32 pushConstantCount;
+            u32 vertexInputCount;
+            u64 sourceHash;
+        };
+
+        /// `remaining` is what's left of the file, counts beyond it are corrupt and never get allocated
+        template<typename T>
+        bool ReadArray(std::ifstream& file, vector<T>& out, u32 count, u64& remaining) {
+            const u64 size = CAST<u64>(count) * sizeof(T);
+            if (size > remaining) return false;
+            remaining -= size;
+
+            out.resize(count);
+            file.read(RCAST<char*>(out.data()), CAST<std::streamsize>(count * sizeof(T)));
+            return file.good();
+        }
+
+        template<typename T>
+        void WriteArray(std::ofstream& file, const vector<T>& values) {
+            file.write(RCAST<const char*>(values.data()), CAST<std::streamsize>(values.size() * sizeof(T)));
+        }
+
+        /// Size of the 32-bit formats the shader compiler emits for vertex inputs
+        u32 GetFormatSize(VkFormat format) {
+            switch (format) {
+                case VK_FORMAT_R32_SFLOAT:
+                case VK_FORMAT_R32_SINT:
+                case VK_FORMAT_R32_UINT:
+                    return 4;
+                case VK_FORMAT_R32G32_SFLOAT:
+                case VK_FORMAT_R32G32_SINT:
+                case VK_FORMAT_R32G32_UINT:
+                    return 8;
+                case VK_FORMAT_R32G32B32_SFLOAT:
+                case VK_FORMAT_R32G32B32_SINT:
+                case VK_FORMAT_R32G32B32_UINT:
+                    return 12;
+                case VK_FORMAT_R32G32B32A32_SFLOAT:
+                case VK_FORMAT_R32G32B32A32_SINT:
+                case VK_FORMAT_R32G32B32A32_UINT:
+                    return 16;
+                default:
+                    return 0;
+            }
+        }
+    }  // namespace
+
+    fs::path ShaderReflection::GetPath(const string& name) {
+        return fs::path(NE_CONTENT_DIR) / "Shaders" / "Compiled" / (name + ".refl");
+    }
+
+    bool ShaderReflection::Load(const fs::path& path, ShaderReflection& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open shader reflection: " << path.string() << std::endl;
+            return false;
+        }
+
+        FileHeader header {};
+        file.read(RCAST<char*>(&header), sizeof(header));
+        if (!file.good() || header.magic != kMagic || header.version != kVersion) {
+            std::cerr << "Invalid shader reflection, rebuild shaders: " << path.string() << std::endl;
+            return false;
+        }
+
+        std::error_code error;
+        const u64 fileSize = fs::file_size(path, error);
+        u64 remaining      = error ? 0 : fileSize - sizeof(header);
+
+        out.stage      = header.stage;
+        out.sourceHash = header.sourceHash;
+        if (!ReadArray(file, out.bindings, header.bindingCount, remaining) ||
+            !ReadArray(file, out.pushConstants, header.pushConstantCount, remaining) ||
+            !ReadArray(file, out.vertexInputs, header.vertexInputCount, remaining)) {
+            std::cerr << "Truncated shader reflection: " << path.string() << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ShaderReflection::Save(const fs::path& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write shader reflection: " << path.string() << std::endl;
+            return false;
+        }
+
+        FileHeader header {};
+        header.magic             = kMagic;
+        header.version           = kVersion;
+        header.stage             = stage;
+        header.bindingCount      = CAST<u32>(bindings.size());
+        header.pushConstantCount = CAST<u32>(pushConstants.size());
+        header.vertexInputCount  = CAST<u32>(vertexInputs.size());
+        header.sourceHash        = sourceHash;
+
+        file.write(RCAST<const char*>(&header), sizeof(header));
+        WriteArray(file, bindings);
+        WriteArray(file, pushConstants);
+        WriteArray(file, vertexInputs);
+
+        return file.good();
+    }
+
+    void ShaderReflection::Merge(const ShaderReflection& other) {
+        stage |= other.stage;
+
+        for (const auto& binding : other.bindings) {
+            auto it = std::find_if(bindings.begin(), bindings.end(), [&](const ReflectedBinding& existing) {
+                return existing.set == binding.set && existing.binding == binding.binding;
+            });
+
+            if (it == bindings.end()) {
+                bindings.push_back(binding);
+            } else {
+                it->stageFlags |= binding.stageFlags;
+                it->descriptorCount = NE_MAX(it->descriptorCount, binding.descriptorCount);
+            }
+        }
+
+        for (const auto& range : other.pushConstants) {
+            auto it = std::find_if(pushConstants.begin(), pushConstants.end(), [&](const VkPushConstantRange& r) {
+                return r.offset == range.offset && r.size == range.size;
+            });
+
+            if (it == pushConstants.end()) {
+                pushConstants.push_back(range);
+            } else {
+                it->stageFlags |= range.stageFlags;
+            }
+        }
+
+        // Vertex inputs only ever come from the vertex stage
+        if (vertexInputs.empty()) { vertexInputs = other.vertexInputs; }
+    }
+
+    u32 ShaderReflection::GetSetCount() const {
+        u32 count = 0;
+        for (const auto& binding : bindings) {
+            count = NE_MAX(count, binding.set + 1);
+        }
+        return count;
+    }
+
+    vector<VkDescriptorSetLayoutBinding> ShaderReflection::GetSetBindings(u32 set, u32 runtimeArrayCount) const {
+        vector<VkDescriptorSetLayoutBinding> result;
+        for (const auto& binding : bindings) {
+            if (binding.set != set) continue;
+
+            VkDescriptorSetLayoutBinding layoutBinding {};
+            layoutBinding.binding         = binding.binding;
+            layoutBinding.descriptorType  = binding.descriptorType;
+            layoutBinding.descriptorCount = binding.descriptorCount == 0 ? runtimeArrayCount : binding.descriptorCount;
+            layoutBinding.stageFlags      = binding.stageFlags;
+            result.push_back(layoutBinding);
+        }
+
+        std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.binding < b.binding; });
+        return result;
+    }
+
+    VkDescriptorSetLayout ShaderReflection::CreateSetLayout(VkDevice device, u32 set) const {
+        const vector<VkDescriptorSetLayoutBinding> layoutBindings = GetSetBindings(set);
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = CAST<u32>(layoutBindings.size());
+        layoutInfo.pBindings    = layoutBindings.data();
+
+        VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &layout) != VK_SUCCESS) {
+            std::cerr << "Failed to create descriptor set layout " << set << " from reflection!" << std::endl;
+            return VK_NULL_HANDLE;
+        }
+
+        return layout;
+    }
+
+    vector<VkVertexInputAttributeDescription> ShaderReflection::GetVertexAttributes(u32 binding, u32& stride) const {
+        vector<ReflectedVertexInput> inputs = vertexInputs;
+        std::sort(inputs.begin(), inputs.end(), [](const auto& a, const auto& b) { return a.location < b.location; });
+
+        vector<VkVertexInputAttributeDescription> attributes;
+        stride = 0;
+        for (const auto& input : inputs) {
+            const u32 size = GetFormatSize(input.format);
+            if (size == 0) {
+                stride = 0;
+                return {};
+            }
+
+            VkVertexInputAttributeDescription attribute {};
+            attribute.location = input.location;
+            attribute.binding  = binding;
+            attribute.format   = input.format;
+            attribute.offset   = stride;
+            attributes.push_back(attribute);
+
+            stride += size;
+        }
+
+        return attributes;
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,75 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace North::Graphics {
+    /// @brief One descriptor a shader declares. Uniform buffers always come out as VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    /// binding one with a dynamic offset is the layout's choice.
+    struct ReflectedBinding {
+        u32 set;
+        u32 binding;
+        VkDescriptorType descriptorType;
+        u32 descriptorCount;  // 0 for runtime-sized arrays, the layout decides how many it holds
+        VkShaderStageFlags stageFlags;
+    };
+
+    /// @brief One vertex shader input, `format` is VK_FORMAT_UNDEFINED for types without a single-location format
+    struct ReflectedVertexInput {
+        u32 location;
+        VkFormat format;
+    };
+
+    /**
+     * @brief Descriptor bindings, push constant ranges and vertex inputs of a compiled shader
+     *
+     * Written next to the SPIR-V by the shader compiler tool (Code/Tools/ShaderCompiler) as
+     * Content/Shaders/Compiled/<file name>.refl, a small binary file that is read straight into these arrays, so
+     * pipelines can build their layouts at startup without parsing any SPIR-V.
+     */
+    struct ShaderReflection {
+        static constexpr u32 kMagic   = 0x5253454E;  // "NESR"
+        static constexpr u32 kVersion = 1;
+
+        VkShaderStageFlags stage = 0;
+        u64 sourceHash           = 0;  // Content hash of the sources the SPIR-V was built from
+        vector<ReflectedBinding> bindings;
+        vector<VkPushConstantRange> pushConstants;
+        vector<ReflectedVertexInput> vertexInputs;
+
+        /// @brief Path of the reflection data for a shader source file name, e.g. "Cull.comp" -> "Cull.comp.refl"
+        static fs::path GetPath(const string& name);
+
+        /// @brief Read reflection data, returns false if the file is missing, malformed or from another version
+        static bool Load(const fs::path& path, ShaderReflection& out);
+
+        bool Save(const fs::path& path) const;
+
+        /// @brief Combine with another stage of the same pipeline. Bindings and push constant ranges declared by
+        /// both stages are merged and see the union of their stage flags.
+        void Merge(const ShaderReflection& other);
+
+        /// @brief Highest set index used plus one
+        NE_ND u32 GetSetCount() const;
+
+        /// @brief Layout bindings of one set, sorted by binding. Runtime-sized arrays get `runtimeArrayCount`.
+        NE_ND vector<VkDescriptorSetLayoutBinding> GetSetBindings(u32 set, u32 runtimeArrayCount = 1) const;
+
+        /// @brief Create the layout of one set
+        /// @return VK_NULL_HANDLE on failure
+        NE_ND VkDescriptorSetLayout CreateSetLayout(VkDevice device, u32 set) const;
+
+        /**
+         * @brief Vertex attributes in location order, tightly packed into a single binding
+         *
+         * Only correct when the vertex buffer is laid out in location order with no padding. `stride` receives the
+         * size of one vertex. Returns an empty vector if any input has no format.
+         */
+        NE_ND vector<VkVertexInputAttributeDescription> GetVertexAttributes(u32 binding, u32& stride) const;
+    };
+}  // namespace North::Graphics
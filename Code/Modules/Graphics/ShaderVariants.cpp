@@ -0,0 +1,127 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "ShaderVariants.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifndef NE_CONTENT_DIR
+    #define NE_CONTENT_DIR "Content"
+#endif
+
+namespace North::Graphics {
+    namespace {
+        struct FileHeader {
+            u32 magic;
+            u32 version;
+            u32 featureCount;
+            u32 variantCount;
+        };
+    }  // namespace
+
+    string ShaderVariantTable::GetVariantName(const string& name, u64 variant) {
+        if (variant == 0) return name;
+
+        std::ostringstream stream;
+        stream << name << ".v" << std::hex << variant;
+        return stream.str();
+    }
+
+    fs::path ShaderVariantTable::GetPath(const string& name) {
+        return fs::path(NE_CONTENT_DIR) / "Shaders" / "Compiled" / (name + ".variants");
+    }
+
+    bool ShaderVariantTable::Load(const fs::path& path, ShaderVariantTable& out) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open shader variants: " << path.string() << std::endl;
+            return false;
+        }
+
+        FileHeader header {};
+        file.read(RCAST<char*>(&header), sizeof(header));
+        if (!file.good() || header.magic != kMagic || header.version != kVersion ||
+            header.featureCount > kMaxFeatures) {
+            std::cerr << "Invalid shader variants, rebuild shaders: " << path.string() << std::endl;
+            return false;
+        }
+
+        // Feature names are stored as a length followed by the characters
+        out.features.resize(header.featureCount);
+        for (auto& feature : out.features) {
+            u32 length = 0;
+            file.read(RCAST<char*>(&length), sizeof(length));
+            if (file.good() && length <= 256) {
+                feature.resize(length);
+                file.read(feature.data(), length);
+            }
+            if (!file.good() || length > 256) {
+                std::cerr << "Invalid shader variants, rebuild shaders: " << path.string() << std::endl;
+                return false;
+            }
+        }
+
+        // A corrupt count could ask for far more than the file holds, check before allocating
+        std::error_code error;
+        const u64 fileSize = fs::file_size(path, error);
+        const u64 position = file.good() ? CAST<u64>(file.tellg()) : fileSize;
+        if (error || CAST<u64>(header.variantCount) * sizeof(Entry) > fileSize - NE_MIN(position, fileSize)) {
+            std::cerr << "Truncated shader variants: " << path.string() << std::endl;
+            return false;
+        }
+
+        out.variants.resize(header.variantCount);
+        file.read(RCAST<char*>(out.variants.data()), CAST<std::streamsize>(out.variants.size() * sizeof(Entry)));
+        if (!file.good()) {
+            std::cerr << "Truncated shader variants: " << path.string() << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ShaderVariantTable::Save(const fs::path& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write shader variants: " << path.string() << std::endl;
+            return false;
+        }
+
+        FileHeader header {};
+        header.magic        = kMagic;
+        header.version      = kVersion;
+        header.featureCount = CAST<u32>(features.size());
+        header.variantCount = CAST<u32>(variants.size());
+        file.write(RCAST<const char*>(&header), sizeof(header));
+
+        for (const auto& feature : features) {
+            const u32 length = CAST<u32>(feature.size());
+            file.write(RCAST<const char*>(&length), sizeof(length));
+            file.write(feature.data(), length);
+        }
+        file.write(RCAST<const char*>(variants.data()), CAST<std::streamsize>(variants.size() * sizeof(Entry)));
+
+        return file.good();
+    }
+
+    optional<u64> ShaderVariantTable::Resolve(u64 variant) const {
+        for (const auto& entry : variants) {
+            if (entry.variant == variant) return entry.source;
+        }
+        return std::nullopt;
+    }
+
+    bool ShaderVariantTable::GetMask(const vector<string>& names, u64& mask) const {
+        mask = 0;
+        for (const auto& name : names) {
+            const auto it = std::find(features.begin(), features.end(), name);
+            if (it == features.end()) return false;
+            mask |= 1ull << (it - features.begin());
+        }
+        return true;
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,50 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+namespace North::Graphics {
+    /**
+     * @brief Which variants of a shader were built and where their SPIR-V lives
+     *
+     * A shader lists its compile-time features in its source with a `// @features NAME ...` line. Bit i of a
+     * variant mask enables the i-th feature (`#define NAME 1`). Only the base variant (mask 0) and the
+     * combinations listed in Content/Shaders/Source/Variants.txt are built, and variants that compile to identical
+     * SPIR-V are stored once: each entry maps a variant to the variant whose files hold its code.
+     *
+     * Written by the shader compiler tool as Content/Shaders/Compiled/<file name>.variants, only for shaders that
+     * declare features.
+     */
+    struct ShaderVariantTable {
+        static constexpr u32 kMagic       = 0x5653454E;  // "NESV"
+        static constexpr u32 kVersion     = 1;
+        static constexpr u32 kMaxFeatures = 64;
+
+        struct Entry {
+            u64 variant;
+            u64 source;  // Variant whose .spv/.refl this one shares, itself if its code is unique
+        };
+
+        vector<string> features;
+        vector<Entry> variants;
+
+        /// @brief Name of a variant's compiled files, e.g. ("Mesh.frag", 0x3) -> "Mesh.frag.v3". Variant 0 keeps the
+        /// plain name.
+        static string GetVariantName(const string& name, u64 variant);
+
+        static fs::path GetPath(const string& name);
+
+        /// @return false if the file is missing, malformed or from another version
+        static bool Load(const fs::path& path, ShaderVariantTable& out);
+        bool Save(const fs::path& path) const;
+
+        /// @brief Variant holding the code of `variant`, empty if that variant wasn't built
+        NE_ND optional<u64> Resolve(u64 variant) const;
+
+        /// @brief Mask enabling the named features, false if any of them isn't declared by the shader
+        bool GetMask(const vector<string>& names, u64& mask) const;
+    };
+}  // namespace North::Graphics
@@ -0,0 +1,416 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "TextureStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        // Staging offsets of vkCmdCopyBufferToImage have to be a multiple of the texel size and of 4
+        constexpr u64 kStagingAlignment = 16;
+
+        // Frames to wait before loading a level again after its upload didn't fit the budget
+        constexpr u64 kRetryDelay = 60;
+
+        u32 LevelSize(u32 size, u32 mipLevel) {
+            return NE_MAX(size >> mipLevel, 1u);
+        }
+    }  // namespace
+
+    bool TextureStreamer::Initialize(VkDevice device,
+                                     VmaAllocator allocator,
+                                     DeletionQueue& deletionQueue,
+                                     BindlessTable& bindlessTable,
+                                     ThreadPool& threadPool) {
+        mDevice        = device;
+        mAllocator     = allocator;
+        mDeletionQueue = &deletionQueue;
+        mBindlessTable = &bindlessTable;
+        mThreadPool    = &threadPool;
+
+        RefreshBudget();
+        return true;
+    }
+
+    void TextureStreamer::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        // Workers push into mCompleted, none may still be running when it goes away
+        mThreadPool->WaitIdle();
+
+        for (auto& texture : mTextures) {
+            texture.image.Destroy();
+        }
+        mTextures.clear();
+        mFreeIds.clear();
+        mCompleted.clear();
+        mReady.clear();
+        mResidentBytes = 0;
+
+        mDevice = VK_NULL_HANDLE;
+    }
+
+    StreamedTextureId TextureStreamer::Register(StreamedTextureDesc desc) {
+        if (desc.width == 0 || desc.height == 0 || !desc.loader) {
+            std::cerr << "Cannot stream a texture without a size or loader!" << std::endl;
+            return kInvalidTexture;
+        }
+        if (GetTexelSize(desc.format) == 0) {
+            std::cerr << "Texture format " << desc.format << " can't be streamed!" << std::endl;
+            return kInvalidTexture;
+        }
+
+        const u32 fullChain = Image::GetMipCount({desc.width, desc.height, 1});
+        desc.mipLevels      = desc.mipLevels == 0 ? fullChain : NE_MIN(desc.mipLevels, fullChain);
+
+        StreamedTextureId id;
+        if (!mFreeIds.empty()) {
+            id = mFreeIds.back();
+            mFreeIds.pop_back();
+        } else {
+            id = CAST<StreamedTextureId>(mTextures.size());
+            mTextures.emplace_back();
+        }
+
+        Texture& texture = mTextures[id];
+        texture.desc     = std::move(desc);
+
+        // A chain cut short may not reach kTailSize, its smallest level is the tail then
+        u32 tailMip = 0;
+        while (tailMip + 1 < texture.desc.mipLevels &&
+               NE_MAX(LevelSize(texture.desc.width, tailMip), LevelSize(texture.desc.height, tailMip)) > kTailSize) {
+            tailMip++;
+        }
+
+        texture.bindlessIndex = BindlessTable::kInvalidIndex;
+        texture.residentMip   = texture.desc.mipLevels;
+        texture.tailMip       = tailMip;
+        texture.wantedMip     = tailMip;
+        texture.lastUsedFrame = mFrame;
+        texture.retryFrame    = 0;
+        texture.alive         = true;
+        texture.loading       = false;
+
+        return id;
+    }
+
+    void TextureStreamer::Unregister(StreamedTextureId id) {
+        if (id >= mTextures.size() || !mTextures[id].alive) return;
+
+        Texture& texture = mTextures[id];
+        if (texture.bindlessIndex != BindlessTable::kInvalidIndex) {
+            mBindlessTable->ReleaseImage(texture.bindlessIndex);
+        }
+        if (texture.image.IsValid()) {
+            mResidentBytes -= texture.image.GetMemorySize();
+            texture.image.Retire(*mDeletionQueue);
+        }
+
+        // A load still running for it finishes into the void
+        texture.desc.loader = nullptr;
+        texture.generation++;
+        texture.alive   = false;
+        texture.loading = false;
+        mFreeIds.push_back(id);
+    }
+
+    void TextureStreamer::RequestResolution(StreamedTextureId id, f32 screenPixels) {
+        if (id >= mTextures.size() || !mTextures[id].alive) return;
+
+        Texture& texture = mTextures[id];
+        u32 mipLevel     = texture.tailMip;
+        if (screenPixels > 0) {
+            const f32 size  = CAST<f32>(NE_MAX(texture.desc.width, texture.desc.height));
+            const f32 level = std::floor(std::log2(size / screenPixels));
+            mipLevel        = level <= 0 ? 0 : NE_MIN(CAST<u32>(level), texture.tailMip);
+        }
+
+        texture.wantedMip     = NE_MIN(texture.wantedMip, mipLevel);
+        texture.lastUsedFrame = mFrame;
+    }
+
+    f32 TextureStreamer::GetScreenSize(f32 worldSize, f32 distance, f32 fovY, u32 viewportHeight) {
+        const f32 viewHeight = 2.0f * distance * std::tan(fovY * 0.5f);
+        if (viewHeight <= 0) return CAST<f32>(viewportHeight);
+        return worldSize / viewHeight * CAST<f32>(viewportHeight);
+    }
+
+    void TextureStreamer::Update(VkCommandBuffer cmd) {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        RefreshBudget();
+
+        {
+            std::lock_guard lock(mCompletedMutex);
+            for (auto& load : mCompleted) {
+                mReady.push_back(std::move(load));
+            }
+            mCompleted.clear();
+        }
+
+        // Upload what finished loading, oldest first
+        u64 uploadedBytes = 0;
+        size_t uploaded   = 0;
+        for (; uploaded < mReady.size() && uploadedBytes < kMaxUploadBytesPerFrame; uploaded++) {
+            CompletedLoad& load = mReady[uploaded];
+            if (load.id >= mTextures.size()) continue;
+
+            Texture& texture = mTextures[load.id];
+            if (!texture.alive || texture.generation != load.generation) continue;
+
+            texture.loading = false;
+            if (!load.succeeded) continue;
+
+            // Tails are tiny and every texture needs one, only finer levels have to fit the budget
+            const bool isTail = texture.residentMip == texture.desc.mipLevels;
+            const u64 growth  = GetLevelsSize(texture, load.firstMip) - GetLevelsSize(texture, texture.residentMip);
+            if (!isTail && !MakeRoom(cmd, growth, load.id)) {
+                texture.retryFrame = mFrame + kRetryDelay;
+                mDeferredUploads++;
+                continue;
+            }
+
+            vector<u64> offsets;
+            u64 stagingSize = 0;
+            for (const auto& level : load.levels) {
+                stagingSize = (stagingSize + kStagingAlignment - 1) & ~(kStagingAlignment - 1);
+                offsets.push_back(stagingSize);
+                stagingSize += level.size();
+            }
+
+            Buffer staging;
+            staging.Create(mAllocator, stagingSize, Buffer::Type::Staging, Buffer::MemoryUsage::CPU_To_GPU);
+            if (!staging.IsValid()) continue;
+            for (size_t i = 0; i < load.levels.size(); i++) {
+                staging.Upload(load.levels[i].data(), load.levels[i].size(), offsets[i]);
+            }
+
+            if (Reallocate(cmd, texture, load.firstMip, &staging, offsets)) {
+                uploadedBytes += stagingSize;
+                mUploadedBytes += stagingSize;
+            }
+
+            // The copies are in this frame's command buffer, the staging memory goes once the frame completes
+            staging.Retire(*mDeletionQueue);
+        }
+        mReady.erase(mReady.begin(), mReady.begin() + CAST<std::ptrdiff_t>(uploaded));
+
+        // Start loads for textures missing their tail or wanting a finer level, the furthest behind first
+        vector<StreamedTextureId> wanted;
+        for (StreamedTextureId id = 0; id < mTextures.size(); id++) {
+            const Texture& texture = mTextures[id];
+            if (!texture.alive || texture.loading || texture.retryFrame > mFrame) continue;
+            if (texture.residentMip == texture.desc.mipLevels || texture.wantedMip < texture.residentMip) {
+                wanted.push_back(id);
+            }
+        }
+        auto missingLevels = [this](StreamedTextureId id) {
+            return mTextures[id].residentMip - mTextures[id].wantedMip;
+        };
+        std::sort(wanted.begin(), wanted.end(), [&](StreamedTextureId a, StreamedTextureId b) {
+            return missingLevels(a) > missingLevels(b);
+        });
+        for (StreamedTextureId id : wanted) {
+            if (mLoadsInFlight >= kMaxLoadsInFlight) break;
+            StartLoad(id);
+        }
+
+        // Requests only count for the frame they were made in
+        for (auto& texture : mTextures) {
+            texture.wantedMip = texture.tailMip;
+        }
+        mFrame++;
+    }
+
+    u32 TextureStreamer::GetBindlessIndex(StreamedTextureId id) const {
+        if (id >= mTextures.size() || !mTextures[id].alive) return BindlessTable::kInvalidIndex;
+        return mTextures[id].bindlessIndex;
+    }
+
+    u32 TextureStreamer::GetResidentMip(StreamedTextureId id) const {
+        if (id >= mTextures.size() || !mTextures[id].alive) return 0;
+        return mTextures[id].residentMip;
+    }
+
+    TextureStreamerStats TextureStreamer::GetStats() const {
+        TextureStreamerStats stats;
+        stats.budgetBytes     = mEffectiveBudget;
+        stats.residentBytes   = mResidentBytes;
+        stats.textures        = CAST<u32>(mTextures.size() - mFreeIds.size());
+        stats.pendingLoads    = mLoadsInFlight;
+        stats.uploadedBytes   = mUploadedBytes;
+        stats.evictions       = mEvictions;
+        stats.deferredUploads = mDeferredUploads;
+        return stats;
+    }
+
+    u32 TextureStreamer::GetTexelSize(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_R8_UNORM:
+                return 1;
+            case VK_FORMAT_R8G8_UNORM:
+                return 2;
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+                return 4;
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+                return 8;
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    void TextureStreamer::RefreshBudget() {
+        VmaBudget budgets[VK_MAX_MEMORY_HEAPS] {};
+        vmaGetHeapBudgets(mAllocator, budgets);
+
+        const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+        vmaGetMemoryProperties(mAllocator, &properties);
+
+        // Headroom left in the heaps textures live in, minus a margin for everything else allocated meanwhile
+        u64 available = 0;
+        for (u32 heap = 0; heap < properties->memoryHeapCount; heap++) {
+            if (!(properties->memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)) continue;
+            if (budgets[heap].budget > budgets[heap].usage) { available += budgets[heap].budget - budgets[heap].usage; }
+        }
+
+        mEffectiveBudget = NE_MIN(mBudget, mResidentBytes + available / 10 * 9);
+    }
+
+    void TextureStreamer::StartLoad(StreamedTextureId id) {
+        Texture& texture = mTextures[id];
+
+        // The whole tail in one go, then one level at a time so each upload stays small
+        const u32 lastMip  = texture.residentMip;
+        const u32 firstMip = lastMip == texture.desc.mipLevels ? texture.tailMip : lastMip - 1;
+
+        vector<u64> sizes;
+        for (u32 mip = firstMip; mip < lastMip; mip++) {
+            sizes.push_back(CAST<u64>(LevelSize(texture.desc.width, mip)) * LevelSize(texture.desc.height, mip) *
+                            GetTexelSize(texture.desc.format));
+        }
+
+        texture.loading = true;
+        mLoadsInFlight++;
+
+        const u32 generation   = texture.generation;
+        const MipLoader loader = texture.desc.loader;
+        mThreadPool->Enqueue([this, id, generation, firstMip, sizes = std::move(sizes), loader] {
+            CompletedLoad load;
+            load.id         = id;
+            load.generation = generation;
+            load.firstMip   = firstMip;
+            load.succeeded  = true;
+
+            for (u32 i = 0; i < sizes.size(); i++) {
+                vector<u8> texels;
+                if (!loader(firstMip + i, texels) || texels.size() != sizes[i]) {
+                    std::cerr << "Failed to load mip " << firstMip + i << " of streamed texture " << id << std::endl;
+                    load.succeeded = false;
+                    break;
+                }
+                load.levels.push_back(std::move(texels));
+            }
+
+            {
+                std::lock_guard lock(mCompletedMutex);
+                mCompleted.push_back(std::move(load));
+            }
+            mLoadsInFlight--;
+        });
+    }
+
+    bool TextureStreamer::Reallocate(
+      VkCommandBuffer cmd, Texture& texture, u32 firstMip, const Buffer* staging, const vector<u64>& offsets) {
+        const u32 oldFirstMip = texture.residentMip;
+
+        ImageDesc desc;
+        desc.extent    = {LevelSize(texture.desc.width, firstMip), LevelSize(texture.desc.height, firstMip), 1};
+        desc.format    = texture.desc.format;
+        desc.usage     = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        desc.mipLevels = texture.desc.mipLevels - firstMip;
+
+        Image image;
+        if (!image.Create(mDevice, mAllocator, desc)) return false;
+
+        for (u32 mip = firstMip; mip < texture.desc.mipLevels; mip++) {
+            if (mip < oldFirstMip) {
+                image.CopyFrom(cmd, *staging, mip - firstMip, 0, 1, offsets[mip - firstMip]);
+            } else {
+                image.CopyFrom(cmd, texture.image, mip - oldFirstMip, mip - firstMip);
+            }
+        }
+        image.Transition(cmd,
+                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_SHADER_READ_BIT);
+
+        // Frames already recorded may still sample the old image, it goes once they have completed
+        if (texture.image.IsValid()) {
+            mResidentBytes -= texture.image.GetMemorySize();
+            texture.image.Retire(*mDeletionQueue);
+        }
+        texture.image       = std::move(image);
+        texture.residentMip = firstMip;
+        mResidentBytes += texture.image.GetMemorySize();
+
+        // The defragmenter may move the image later on, the old copy is retired the same way
+        const auto id = CAST<StreamedTextureId>(&texture - mTextures.data());
+        texture.image.SetRelocatable([this, id] { RebindImage(mTextures[id]); });
+
+        RebindImage(texture);
+        return true;
+    }
+
+    void TextureStreamer::RebindImage(Texture& texture) {
+        // Pending frames may read the old entry, and update-unused-while-pending doesn't allow rewriting it
+        const u32 previous    = texture.bindlessIndex;
+        texture.bindlessIndex = mBindlessTable->RegisterImage(texture.image.GetView());
+        if (previous != BindlessTable::kInvalidIndex) { mBindlessTable->ReleaseImage(previous); }
+    }
+
+    bool TextureStreamer::MakeRoom(VkCommandBuffer cmd, u64 bytes, StreamedTextureId requester) {
+        if (mResidentBytes + bytes <= mEffectiveBudget) return true;
+
+        // Textures not requested this frame can drop to their tail, requested ones only to what was asked for
+        auto trimTarget = [this](const Texture& texture) {
+            return texture.lastUsedFrame == mFrame ? texture.wantedMip : texture.tailMip;
+        };
+
+        vector<StreamedTextureId> candidates;
+        for (StreamedTextureId id = 0; id < mTextures.size(); id++) {
+            const Texture& texture = mTextures[id];
+            if (id == requester || !texture.alive || texture.loading) continue;
+            if (texture.residentMip < trimTarget(texture)) { candidates.push_back(id); }
+        }
+
+        // Least recently used first
+        std::sort(candidates.begin(), candidates.end(), [this](StreamedTextureId a, StreamedTextureId b) {
+            return mTextures[a].lastUsedFrame < mTextures[b].lastUsedFrame;
+        });
+
+        for (StreamedTextureId id : candidates) {
+            Texture& texture = mTextures[id];
+            if (Reallocate(cmd, texture, trimTarget(texture), nullptr, {})) { mEvictions++; }
+            if (mResidentBytes + bytes <= mEffectiveBudget) return true;
+        }
+
+        return false;
+    }
+
+    u64 TextureStreamer::GetLevelsSize(const Texture& texture, u32 firstMip) const {
+        u64 size = 0;
+        for (u32 mip = firstMip; mip < texture.desc.mipLevels; mip++) {
+            size += CAST<u64>(LevelSize(texture.desc.width, mip)) * LevelSize(texture.desc.height, mip);
+        }
+        return size * GetTexelSize(texture.desc.format);
+    }
+}  // namespace North::Graphics
@@ -0,0 +1,213 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Common/ThreadPool.hpp"
+#include "BindlessTable.hpp"
+#include "DeletionQueue.hpp"
+#include "Image.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace North::Graphics {
+    using StreamedTextureId = u32;
+
+    /**
+     * @brief Reads one mip level of a streamed texture, tightly packed, into `texels`
+     *
+     * Called on a worker thread. Loads of different textures can run at the same time, never two of the same one.
+     *
+     * @return false if the level couldn't be read, it's asked for again the next time the texture wants it
+     */
+    using MipLoader = std::function<bool(u32 mipLevel, vector<u8>& texels)>;
+
+    struct StreamedTextureDesc {
+        u32 width       = 0;
+        u32 height      = 0;
+        VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+        u32 mipLevels   = 0;  // 0 = full chain
+        MipLoader loader;
+    };
+
+    struct TextureStreamerStats {
+        u64 budgetBytes     = 0;  // Effective budget as of the last Update()
+        u64 residentBytes   = 0;
+        u32 textures        = 0;
+        u32 pendingLoads    = 0;
+        u64 uploadedBytes   = 0;  // Totals since Initialize()
+        u64 evictions       = 0;
+        u64 deferredUploads = 0;  // Loaded levels dropped because nothing could be evicted to make room
+    };
+
+    /**
+     * @brief Keeps textures resident at the mip level they're seen at, within a GPU memory budget
+     *
+     * Every texture starts with only its mip tail (levels of kTailSize texels and below) and streams finer levels
+     * in, one per load, up to what RequestResolution() asked for that frame. Levels are read by the texture's
+     * MipLoader on the thread pool and uploaded through a staging buffer recorded into the frame's command buffer,
+     * at most kMaxUploadBytesPerFrame per frame.
+     *
+     * A texture's resident levels live in one Image sized for them. Gaining or losing levels allocates a new
+     * image, copies the levels that stay over on the GPU and retires the old one. Frames already submitted may
+     * still sample the old image through its bindless index, so the new image gets a new index and the old one is
+     * released along with the image: read GetBindlessIndex() every frame instead of keeping it. Shaders see the
+     * resident range as a whole chain, so sample with the view's own mip count rather than the full texture's.
+     *
+     * Resident levels count against the smaller of the budget set with SetBudget() and what the device-local
+     * heaps have left for this process (VK_EXT_memory_budget through VMA when the device has it, a VMA estimate
+     * otherwise). When an upload wouldn't fit, the least recently requested textures are trimmed first: to their
+     * tail when they weren't requested this frame, down to the requested level otherwise. Tails are always kept.
+     *
+     * Only uncompressed color formats are supported (see GetTexelSize()).
+     *
+     * Example:
+     *   auto id = streamer.Register({2048, 2048, VK_FORMAT_R8G8B8A8_SRGB, 0, LoadMipFromPackage});
+     *   ...
+     *   // Every frame the texture is visible, before RenderContext::DrawFrame()
+     *   streamer.RequestResolution(id, TextureStreamer::GetScreenSize(radius * 2, distance, fovY, height));
+     *   material.albedo = streamer.GetBindlessIndex(id);  // kInvalidIndex until the tail has been uploaded
+     */
+    class TextureStreamer {
+    public:
+        static constexpr StreamedTextureId kInvalidTexture = ~0u;
+
+        /// Levels this size and smaller are loaded together on registration and never evicted
+        static constexpr u32 kTailSize = 32;
+
+        static constexpr u32 kMaxLoadsInFlight       = 8;
+        static constexpr u64 kMaxUploadBytesPerFrame = 32ull << 20;
+        static constexpr u64 kDefaultBudget          = 512ull << 20;
+
+        TextureStreamer() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(TextureStreamer)
+
+        bool Initialize(VkDevice device,
+                        VmaAllocator allocator,
+                        DeletionQueue& deletionQueue,
+                        BindlessTable& bindlessTable,
+                        ThreadPool& threadPool);
+
+        /// @brief Waits for loads still running, then destroys every texture. The device has to be idle.
+        void Shutdown();
+
+        /// @return kInvalidTexture if the size, format or loader is invalid
+        StreamedTextureId Register(StreamedTextureDesc desc);
+
+        /// @brief Free the texture's levels and bindless index once in-flight frames are done with them
+        void Unregister(StreamedTextureId id);
+
+        /**
+         * @brief Ask for the texture to be resident at the level that covers `screenPixels` pixels
+         *
+         * Picks the level whose larger dimension is closest to (but not below) the texture's size on screen.
+         * Several requests in a frame keep the finest one. Call before the frame's Update().
+         */
+        void RequestResolution(StreamedTextureId id, f32 screenPixels);
+
+        /// @brief Height in pixels of an object `worldSize` across, seen from `distance` with a vertical FOV (rad)
+        static f32 GetScreenSize(f32 worldSize, f32 distance, f32 fovY, u32 viewportHeight);
+
+        /// @brief Upload finished loads, trim textures to fit the budget and start new loads. Once per frame,
+        /// outside a render pass.
+        void Update(VkCommandBuffer cmd);
+
+        /// @brief Bytes the streamer may keep resident. The effective budget can be lower when the heap is short.
+        void SetBudget(u64 bytes) {
+            mBudget = bytes;
+        }
+
+        NE_ND u64 GetBudget() const {
+            return mBudget;
+        }
+
+        /// @return Index into the bindless sampled image array, BindlessTable::kInvalidIndex until something
+        /// is resident
+        NE_ND u32 GetBindlessIndex(StreamedTextureId id) const;
+
+        /// @brief Finest level resident, the texture's mip count while nothing is
+        NE_ND u32 GetResidentMip(StreamedTextureId id) const;
+
+        NE_ND TextureStreamerStats GetStats() const;
+
+        /// @brief Bytes per texel, 0 for formats the streamer can't handle
+        static u32 GetTexelSize(VkFormat format);
+
+        NE_ND bool Initialized() const {
+            return mDevice != VK_NULL_HANDLE;
+        }
+
+    private:
+        struct Texture {
+            StreamedTextureDesc desc;  // mipLevels resolved
+            Image image;               // Levels [residentMip, mipLevels) of the texture, image level 0 is residentMip
+            u32 bindlessIndex = BindlessTable::kInvalidIndex;
+            u32 generation    = 0;  // Bumped on unregister, loads for an older generation are dropped
+            u32 residentMip   = 0;
+            u32 tailMip       = 0;  // First level no larger than kTailSize
+            u32 wantedMip     = 0;  // Finest level requested this frame
+            u64 lastUsedFrame = 0;
+            u64 retryFrame    = 0;  // No new load before this frame, set when an upload didn't fit
+            bool alive        = false;
+            bool loading      = false;
+        };
+
+        struct CompletedLoad {
+            StreamedTextureId id = kInvalidTexture;
+            u32 generation       = 0;
+            u32 firstMip         = 0;  // Levels [firstMip, firstMip + levels.size())
+            vector<vector<u8>> levels;
+            bool succeeded = false;
+        };
+
+        void RefreshBudget();
+        void StartLoad(StreamedTextureId id);
+
+        /// Replace the texture's image with one holding levels [firstMip, mipLevels). Levels below the old
+        /// resident range come from `staging` (at `offsets`), the rest are copied from the old image.
+        bool Reallocate(
+          VkCommandBuffer cmd, Texture& texture, u32 firstMip, const Buffer* staging, const vector<u64>& offsets);
+
+        /// Register the texture's current view under a new bindless index and release the old one, which frames in
+        /// flight may still read, once they have completed
+        void RebindImage(Texture& texture);
+
+        /// Trim least recently used textures until `bytes` more fit in the budget
+        bool MakeRoom(VkCommandBuffer cmd, u64 bytes, StreamedTextureId requester);
+
+        /// Tightly packed size of levels [firstMip, mipLevels)
+        NE_ND u64 GetLevelsSize(const Texture& texture, u32 firstMip) const;
+
+        VkDevice mDevice              = VK_NULL_HANDLE;
+        VmaAllocator mAllocator       = VK_NULL_HANDLE;
+        DeletionQueue* mDeletionQueue = nullptr;
+        BindlessTable* mBindlessTable = nullptr;
+        ThreadPool* mThreadPool       = nullptr;
+
+        vector<Texture> mTextures;
+        vector<StreamedTextureId> mFreeIds;
+        u64 mFrame = 1;  // Stamped onto requests, advanced by every Update()
+
+        u64 mBudget          = kDefaultBudget;
+        u64 mEffectiveBudget = kDefaultBudget;
+        u64 mResidentBytes   = 0;
+
+        // Filled by workers, drained by Update()
+        std::mutex mCompletedMutex;
+        vector<CompletedLoad> mCompleted;
+        vector<CompletedLoad> mReady;  // Drained but over the frame's upload limit, uploaded next frame
+        std::atomic<u32> mLoadsInFlight {0};
+
+        u64 mUploadedBytes   = 0;
+        u64 mEvictions       = 0;
+        u64 mDeferredUploads = 0;
+    };
+}  // namespace North::Graphics
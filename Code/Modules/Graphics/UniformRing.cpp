@@ -0,0 +1,174 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "UniformRing.hpp"
+#include <iostream>
+
+namespace North::Graphics {
+    namespace {
+        VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }  // namespace
+
+    bool UniformRing::Initialize(VkDevice device,
+                                 VmaAllocator allocator,
+                                 DeletionQueue& deletionQueue,
+                                 VkDeviceSize minAlignment,
+                                 u32 frameCount) {
+        mDevice        = device;
+        mAllocator     = allocator;
+        mDeletionQueue = &deletionQueue;
+        mAlignment     = NE_MAX(minAlignment, CAST<VkDeviceSize>(16));  // Always a power of two
+
+        VkDescriptorSetLayoutBinding bindings[2] {};
+        bindings[0].binding         = kFrameBinding;
+        bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[1].binding         = kDrawBinding;
+        bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 2;
+        layoutInfo.pBindings    = bindings;
+
+        if (vkCreateDescriptorSetLayout(mDevice, &layoutInfo, nullptr, &mDescriptorSetLayout) != VK_SUCCESS) {
+            std::cerr << "Failed to create uniform ring descriptor set layout!" << std::endl;
+            return false;
+        }
+
+        return Reserve(frameCount);
+    }
+
+    void UniformRing::Shutdown() {
+        if (mDevice == VK_NULL_HANDLE) return;
+
+        for (auto& slot : mFrames) {
+            vkDestroyDescriptorPool(mDevice, slot.descriptorPool, nullptr);
+        }
+        mFrames.clear();
+
+        vkDestroyDescriptorSetLayout(mDevice, mDescriptorSetLayout, nullptr);
+        mDescriptorSetLayout = VK_NULL_HANDLE;
+        mDevice              = VK_NULL_HANDLE;
+        mCurrentFrame        = 0;
+    }
+
+    bool UniformRing::Reserve(u32 frameCount) {
+        while (mFrames.size() < frameCount) {
+            mFrames.emplace_back();
+            if (!CreateSlot(mFrames.back())) {
+                std::cerr << "Failed to create uniform ring frame slot!" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void UniformRing::BeginFrame(u32 frameIndex) {
+        mCurrentFrame   = frameIndex;
+        FrameSlot& slot = mFrames[frameIndex];
+
+        // Nothing in flight uses this slot anymore, so a buffer that overflowed last time can be replaced
+        if (slot.required > slot.buffer.GetSize()) {
+            VkDeviceSize size = NE_MAX(slot.buffer.GetSize(), kInitialSize);
+            while (size < slot.required) {
+                size *= 2;
+            }
+
+            slot.buffer.Retire(*mDeletionQueue);
+            if (CreateBuffer(slot, size)) { WriteDescriptorSet(slot); }
+        }
+
+        slot.head     = 0;
+        slot.required = 0;
+    }
+
+    UniformAllocation UniformRing::Allocate(VkDeviceSize size) {
+        FrameSlot& slot          = mFrames[mCurrentFrame];
+        const VkDeviceSize start = AlignUp(slot.head, mAlignment);
+        const VkDeviceSize end   = start + size;
+
+        // The descriptor ranges are fixed, so whatever is bound at this offset has to fit entirely
+        const VkDeviceSize bindableEnd = start + NE_MAX(size, kMaxDrawDataSize);
+
+        slot.required = NE_MAX(slot.required, bindableEnd);
+        if (!slot.buffer.IsValid() || bindableEnd > slot.buffer.GetSize()) { return {}; }
+        slot.head = end;
+
+        UniformAllocation allocation;
+        allocation.data   = CAST<u8*>(slot.buffer.Map()) + start;
+        allocation.offset = CAST<u32>(start);
+        allocation.size   = size;
+        return allocation;
+    }
+
+    void UniformRing::Flush() {
+        if (mFrames.empty()) return;
+
+        // The slot is persistently mapped and may not be host coherent, only the bumped range was written
+        FrameSlot& slot = mFrames[mCurrentFrame];
+        if (slot.head > 0 && slot.buffer.IsValid()) { slot.buffer.Flush(0, slot.head); }
+    }
+
+    bool UniformRing::CreateSlot(FrameSlot& slot) {
+        VkDescriptorPoolSize poolSize {};
+        poolSize.type            = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        poolSize.descriptorCount = 2;
+
+        VkDescriptorPoolCreateInfo poolInfo {};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes    = &poolSize;
+
+        if (vkCreateDescriptorPool(mDevice, &poolInfo, nullptr, &slot.descriptorPool) != VK_SUCCESS) {
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo {};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool     = slot.descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts        = &mDescriptorSetLayout;
+
+        if (vkAllocateDescriptorSets(mDevice, &allocInfo, &slot.descriptorSet) != VK_SUCCESS) { return false; }
+        if (!CreateBuffer(slot, kInitialSize)) { return false; }
+
+        WriteDescriptorSet(slot);
+        return true;
+    }
+
+    bool UniformRing::CreateBuffer(FrameSlot& slot, VkDeviceSize size) {
+        slot.buffer.Create(mAllocator, size, Buffer::Type::Uniform, Buffer::MemoryUsage::CPU_To_GPU);
+        if (!slot.buffer.IsValid()) {
+            std::cerr << "Failed to create " << size << " byte uniform ring buffer!" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void UniformRing::WriteDescriptorSet(const FrameSlot& slot) const {
+        // The ranges are fixed, dynamic offsets only move where they start
+        VkDescriptorBufferInfo bufferInfos[2] {};
+        bufferInfos[0] = {slot.buffer.GetHandle(), 0, sizeof(FrameConstants)};
+        bufferInfos[1] = {slot.buffer.GetHandle(), 0, kMaxDrawDataSize};
+
+        VkWriteDescriptorSet writes[2] {};
+        for (u32 i = 0; i < 2; i++) {
+            writes[i].sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet          = slot.descriptorSet;
+            writes[i].dstBinding      = i == 0 ? kFrameBinding : kDrawBinding;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            writes[i].pBufferInfo     = &bufferInfos[i];
+        }
+
+        vkUpdateDescriptorSets(mDevice, 2, writes, 0, nullptr);
+    }
+}  // namespace North::Graphics
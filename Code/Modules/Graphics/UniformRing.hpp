@@ -0,0 +1,121 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Buffer.hpp"
+#include "DeletionQueue.hpp"
+#include "RenderCommand.hpp"
+
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+#include <cstring>
+
+namespace North::Graphics {
+    /// @brief Slice of a frame's uniform ring. `offset` is the dynamic offset to bind it with.
+    struct UniformAllocation {
+        void* data        = nullptr;
+        u32 offset        = 0;
+        VkDeviceSize size = 0;
+
+        NE_ND bool IsValid() const {
+            return data != nullptr;
+        }
+    };
+
+    /**
+     * @brief Per-frame uniform data suballocated from one persistently mapped buffer per frame in flight
+     *
+     * Allocations are bumped off the frame's buffer at minUniformBufferOffsetAlignment and never freed
+     * individually, the whole slot is reset by BeginFrame() once the frame that last used it has completed.
+     *
+     * Each slot has a descriptor set (the global set) with two dynamic uniform buffer bindings over its buffer,
+     * FrameConstants at kFrameBinding and up to kMaxDrawDataSize bytes of per-draw data at kDrawBinding.
+     * Pointing either at new data is just a different dynamic offset in vkCmdBindDescriptorSets, no descriptor
+     * set per object.
+     *
+     * A frame that runs out of space gets invalid allocations; the slot grows to fit the next time it begins.
+     */
+    class UniformRing {
+    public:
+        static constexpr u32 kFrameBinding             = 0;
+        static constexpr u32 kDrawBinding              = 1;
+        static constexpr VkDeviceSize kMaxDrawDataSize = 256;
+        static constexpr VkDeviceSize kInitialSize     = 64 * 1024;
+
+        UniformRing() = default;
+
+        NE_CLASS_PREVENT_MOVES_COPIES(UniformRing)
+
+        bool Initialize(VkDevice device,
+                        VmaAllocator allocator,
+                        DeletionQueue& deletionQueue,
+                        VkDeviceSize minAlignment,
+                        u32 frameCount);
+        void Shutdown();
+
+        /// @brief Grow to at least `frameCount` per-frame slots
+        bool Reserve(u32 frameCount);
+
+        /// @brief Reset the slot for a new frame. The frame that last used it must be complete.
+        void BeginFrame(u32 frameIndex);
+
+        /// @brief Allocate from the current frame's slot
+        UniformAllocation Allocate(VkDeviceSize size);
+
+        /// @brief Flush everything allocated in the current frame so the GPU sees it. Call before the frame's submit,
+        /// after the last write through an allocation.
+        void Flush();
+
+        /// @brief Copy `value` into the current frame's slot
+        template<typename T>
+        UniformAllocation Push(const T& value) {
+            UniformAllocation allocation = Allocate(sizeof(T));
+            if (allocation.IsValid()) { std::memcpy(allocation.data, &value, sizeof(T)); }
+            return allocation;
+        }
+
+        NE_ND VkDescriptorSetLayout GetDescriptorSetLayout() const {
+            return mDescriptorSetLayout;
+        }
+
+        NE_ND VkDescriptorSet GetDescriptorSet(u32 frameIndex) const {
+            return mFrames[frameIndex].descriptorSet;
+        }
+
+        NE_ND Buffer& GetBuffer(u32 frameIndex) {
+            return mFrames[frameIndex].buffer;
+        }
+
+        /// @brief Bytes allocated so far in the current frame
+        NE_ND VkDeviceSize GetUsed() const {
+            return mFrames.empty() ? 0 : mFrames[mCurrentFrame].head;
+        }
+
+    private:
+        struct FrameSlot {
+            Buffer buffer;
+            VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+            VkDescriptorSet descriptorSet   = VK_NULL_HANDLE;
+            VkDeviceSize head               = 0;
+            VkDeviceSize required           = 0;  // Peak demand, including allocations that didn't fit
+        };
+
+        bool CreateSlot(FrameSlot& slot);
+        bool CreateBuffer(FrameSlot& slot, VkDeviceSize size);
+        void WriteDescriptorSet(const FrameSlot& slot) const;
+
+        VkDevice mDevice              = VK_NULL_HANDLE;
+        VmaAllocator mAllocator       = VK_NULL_HANDLE;
+        DeletionQueue* mDeletionQueue = nullptr;
+        VkDeviceSize mAlignment       = 256;
+
+        VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+
+        vector<FrameSlot> mFrames;
+        u32 mCurrentFrame = 0;
+    };
+}  // namespace North::Graphics
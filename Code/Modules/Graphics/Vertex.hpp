@@ -0,0 +1,19 @@
+// Author: Jake Rieger
+// Created: 11/21/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+namespace North::Graphics {
+    /// @brief Standard mesh vertex, every mesh in the geometry pool uses this layout
+    struct Vertex {
+        Vec3 position;
+        Vec3 normal;
+        Vec2 uv;
+    };
+
+    /// @brief Index type of all pooled geometry (VK_INDEX_TYPE_UINT32)
+    using Index = u32;
+}  // namespace North::Graphics
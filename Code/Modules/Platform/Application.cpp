@@ -3,28 +3,25 @@
 //
 
 #include "Application.hpp"
+#include "Common/Clock.hpp"
 
 #include <GLFW/glfw3.h>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
 
 namespace North::Platform {
     i32 IApplication::Run() {
         Initialize();
         OnAwake();
         {
-            mRunning       = true;
-            mLastFrameTime = glfwGetTime();
+            mRunning     = true;
+            mAccumulator = 0;
 
-            // Main loop
-            while (mRunning && !glfwWindowShouldClose(mWindow)) {
-                const f64 currentTime = glfwGetTime();
-                const auto dT         = CAST<f32>(currentTime - mLastFrameTime);
-                mLastFrameTime        = currentTime;
-
-                OnUpdate(dT);
-                OnRender();
-                OnLateUpdate();
-
-                glfwPollEvents();
+            if (mHeadless) {
+                RunHeadless();
+            } else {
+                RunWindowed();
             }
 
             mRunning = false;
@@ -39,6 +36,53 @@ namespace North::Platform {
         mRunning = false;
     }
 
+    void IApplication::SetHeadless(u32 frameCount, bool renderOffscreen) {
+        if (mRunning) { throw std::logic_error("Headless mode must be set before Run()"); }
+        mHeadless           = true;
+        mRenderOffscreen    = renderOffscreen;
+        mHeadlessFrameCount = frameCount;
+    }
+
+    bool IApplication::IsHeadless() const {
+        return mHeadless;
+    }
+
+    bool IApplication::IsRenderingOffscreen() const {
+        return mHeadless && mRenderOffscreen;
+    }
+
+    void IApplication::SetTickRate(f64 ticksPerSecond) {
+        if (ticksPerSecond <= 0) { throw std::invalid_argument("Tick rate must be positive"); }
+        mTickRate = ticksPerSecond;
+    }
+
+    void IApplication::SetMaxSubsteps(u32 maxSubsteps) {
+        mMaxSubsteps = NE_MAX(maxSubsteps, 1u);
+    }
+
+    f64 IApplication::GetTickRate() const {
+        return mTickRate;
+    }
+
+    f32 IApplication::GetFixedDeltaTime() const {
+        return CAST<f32>(1.0 / mTickRate);
+    }
+
+    f32 IApplication::GetInterpolationAlpha() const {
+        return mInterpolationAlpha;
+    }
+
+    f64 IApplication::TakeInputTimestamp() {
+        const f64 timestamp = mPendingInputTime;
+        mPendingInputTime   = 0;
+        return timestamp;
+    }
+
+    void IApplication::MarkInput() {
+        // Keep the oldest one, a frame is only as responsive as its slowest-handled input
+        if (mPendingInputTime == 0) { mPendingInputTime = Clock::Now(); }
+    }
+
     GLFWwindow* IApplication::GetWindow() const {
         return mWindow;
     }
@@ -56,7 +100,62 @@ namespace North::Platform {
         return mTitle;
     }
 
+    void IApplication::RunWindowed() {
+        mLastFrameTime = glfwGetTime();
+
+        // Main loop
+        while (mRunning && !glfwWindowShouldClose(mWindow)) {
+            const f64 currentTime = glfwGetTime();
+            Tick(currentTime - mLastFrameTime);
+            mLastFrameTime = currentTime;
+
+            glfwPollEvents();
+        }
+    }
+
+    void IApplication::RunHeadless() {
+        const f64 step      = 1.0 / mTickRate;
+        const f64 startTime = Clock::Now();
+        u32 frames          = 0;
+
+        // No pacing, every frame is exactly one tick so results don't depend on how fast the machine is
+        while (mRunning && (mHeadlessFrameCount == 0 || frames < mHeadlessFrameCount)) {
+            Tick(step);
+            frames++;
+        }
+
+        const f64 elapsed = Clock::Now() - startTime;
+        if (frames > 0) {
+            std::cout << "Headless run: " << frames << " frames in " << elapsed << "s ("
+                      << (elapsed * 1000.0) / frames << " ms/frame, " << frames / elapsed << " fps)" << std::endl;
+        }
+    }
+
+    void IApplication::Tick(f64 elapsed) {
+        mAccumulator += elapsed;
+
+        // Simulation always advances in whole fixed ticks so its cost and results don't depend on frame rate
+        const f64 step = 1.0 / mTickRate;
+        u32 substeps   = 0;
+        while (mAccumulator >= step && substeps < mMaxSubsteps) {
+            OnUpdate(CAST<f32>(step));
+            mAccumulator -= step;
+            substeps++;
+        }
+
+        // Hit the substep cap, drop the backlog instead of carrying it into the next frame (spiral of death)
+        if (mAccumulator >= step) { mAccumulator = std::fmod(mAccumulator, step); }
+
+        mInterpolationAlpha = CAST<f32>(mAccumulator / step);
+
+        OnRender();
+        OnLateUpdate();
+    }
+
     void IApplication::Initialize() {
+        // Headless runs never touch GLFW, so they work on machines without a display server
+        if (mHeadless) { return; }
+
         if (!glfwInit()) { throw std::runtime_error("Failed to initialize GLFW"); }
 
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -86,6 +185,7 @@ namespace North::Platform {
     void IApplication::KeyCallback(GLFWwindow* window, i32 key, i32 scancode, i32 action, i32 mods) {
         auto* app = CAST<IApplication*>(glfwGetWindowUserPointer(window));
         if (app) {
+            app->MarkInput();
             app->OnKey(key);
             if (action == GLFW_PRESS) {
                 app->OnKeyPress(key);
@@ -98,6 +198,7 @@ namespace North::Platform {
     void IApplication::MouseButtonCallback(GLFWwindow* window, i32 button, i32 action, i32 mods) {
         auto* app = CAST<IApplication*>(glfwGetWindowUserPointer(window));
         if (app) {
+            app->MarkInput();
             app->OnMouseButton(button);
             if (action == GLFW_PRESS) {
                 app->OnMouseButtonPress(button);
@@ -109,7 +210,10 @@ namespace North::Platform {
 
     void IApplication::CursorPosCallback(GLFWwindow* window, f64 xpos, f64 ypos) {
         auto* app = CAST<IApplication*>(glfwGetWindowUserPointer(window));
-        if (app) { app->OnMouseMove((f32)xpos, (f32)ypos); }
+        if (app) {
+            app->MarkInput();
+            app->OnMouseMove((f32)xpos, (f32)ypos);
+        }
     }
 
     void IApplication::FramebufferSizeCallback(GLFWwindow* window, i32 width, i32 height) {
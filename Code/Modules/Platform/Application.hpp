@@ -17,6 +17,11 @@ namespace North::Platform {
         static constexpr u32 kDefaultWidth  = 1280;
         static constexpr u32 kDefaultHeight = 720;
 
+        /// @brief Default number of fixed simulation ticks per second
+        static constexpr f64 kDefaultTickRate = 60.0;
+        /// @brief Default cap on simulation ticks run in a single frame
+        static constexpr u32 kDefaultMaxSubsteps = 5;
+
         IApplication() = default;
         explicit IApplication(string title, u32 width = kDefaultWidth, u32 height = kDefaultHeight)
             : mTitle(std::move(title)) {}
@@ -27,6 +32,37 @@ namespace North::Platform {
         i32 Run();
         void Quit();
 
+        /// @brief Sets how many fixed simulation ticks (OnUpdate calls) run per second
+        void SetTickRate(f64 ticksPerSecond);
+        /// @brief Caps how many ticks a single frame may run before leftover time is dropped
+        void SetMaxSubsteps(u32 maxSubsteps);
+
+        /**
+         * @brief Run without GLFW, a window or a surface
+         *
+         * Must be called before Run(). Frames are run back-to-back with no pacing, each advancing the
+         * simulation by exactly one fixed tick, which makes headless runs deterministic and usable for
+         * benchmarking. A timing summary is printed when the run ends.
+         *
+         * @param frameCount Number of frames to run, 0 runs until Quit() is called
+         * @param renderOffscreen Whether to still render, into an offscreen target instead of a swapchain
+         */
+        void SetHeadless(u32 frameCount, bool renderOffscreen = true);
+
+        NE_ND bool IsHeadless() const;
+        NE_ND bool IsRenderingOffscreen() const;
+
+        NE_ND f64 GetTickRate() const;
+        NE_ND f32 GetFixedDeltaTime() const;
+
+        /// @brief How far (0..1) the current frame sits between the last tick and the next one.
+        /// Rendering blends previous and current simulation state with this.
+        NE_ND f32 GetInterpolationAlpha() const;
+
+        /// @brief Returns (and clears) when the oldest input event not yet handed to a frame arrived, 0 if there
+        /// was none. Used to measure input-to-present latency.
+        f64 TakeInputTimestamp();
+
         virtual void OnAwake() {}
         virtual void OnUpdate(f32 dT) {}
         virtual void OnLateUpdate() {}
@@ -58,11 +94,24 @@ namespace North::Platform {
         u32 mHeight {kDefaultHeight};
         string mTitle;
         f64 mLastFrameTime {0};
+        f64 mTickRate {kDefaultTickRate};
+        u32 mMaxSubsteps {kDefaultMaxSubsteps};
+        f64 mAccumulator {0};
+        f32 mInterpolationAlpha {0};
+        bool mHeadless {false};
+        bool mRenderOffscreen {false};
+        u32 mHeadlessFrameCount {0};
+        f64 mPendingInputTime {0};
         std::atomic<bool> mRunning {false};
 
         void Initialize();
         void Shutdown() const;
 
+        void RunWindowed();
+        void RunHeadless();
+        void Tick(f64 elapsed);
+        void MarkInput();
+
         static void KeyCallback(GLFWwindow* window, i32 key, i32 scancode, i32 action, i32 mods);
         static void MouseButtonCallback(GLFWwindow* window, i32 button, i32 action, i32 mods);
         static void CursorPosCallback(GLFWwindow* window, f64 xpos, f64 ypos);
@@ -8,7 +8,11 @@ namespace North::Platform {
     void GameApplication::OnAwake() {
         u32 width, height;
         GetWindowDimensions(width, height);
-        mGame.Initialize(GetWindow(), width, height);
+        if (IsHeadless()) {
+            mGame.InitializeHeadless(width, height, IsRenderingOffscreen());
+        } else {
+            mGame.Initialize(GetWindow(), width, height);
+        }
         if (!mGame.Initialized()) { throw std::runtime_error("Failed to initialize game"); }
         mGame.Awake();
     }
@@ -23,7 +27,9 @@ namespace North::Platform {
     }
 
     void GameApplication::OnRender() {
-        mGame.RequestFrame();
+        // Input polled since the last frame is what this one reacts to
+        if (!IsHeadless()) { mGame.GetRenderContext().MarkInput(TakeInputTimestamp()); }
+        mGame.RequestFrame(GetInterpolationAlpha());
     }
 
     void GameApplication::OnLateUpdate() {
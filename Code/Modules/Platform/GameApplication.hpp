@@ -22,6 +22,10 @@ namespace North::Platform {
         void OnLateUpdate() override;
         void OnResize(u32 width, u32 height) override;
 
+        NE_ND Engine::Game& GetGame() {
+            return mGame;
+        }
+
     private:
         Engine::Game mGame;
     };
@@ -5,18 +5,252 @@
 #include <Platform/GameApplication.hpp>
 #include <Input/InputCodes.hpp>
 
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+
 namespace North {
     class SandboxApp final : public Platform::GameApplication {
     public:
         SandboxApp() : GameApplication("Sandbox") {}
 
+        /// @brief Run the mip generation benchmark at startup, for a size x size texture
+        void SetMipBenchmarkSize(u32 size) {
+            mMipBenchmarkSize = size;
+        }
+
+        /// @brief Run the CPU occlusion culling benchmark at startup, testing count boxes against a row of walls
+        void SetOcclusionBenchmarkCount(u32 count) {
+            mOcclusionBenchmarkCount = count;
+        }
+
+        void OnAwake() override {
+            GameApplication::OnAwake();
+            if (mOcclusionBenchmarkCount > 0) { RunOcclusionBenchmark(); }
+            if (mMipBenchmarkSize == 0) return;
+
+            constexpr u32 kIterations = 10;
+            const auto result = GetGame().GetRenderContext().BenchmarkMipGeneration(mMipBenchmarkSize, kIterations);
+            std::cout << "Mip chain " << mMipBenchmarkSize << "x" << mMipBenchmarkSize << " (" << result.levels
+                      << " levels): " << result.computeMs << " ms compute, " << result.blitMs << " ms blit, "
+                      << result.cpuMs << " ms CPU" << std::endl;
+        }
+
         void OnKeyPress(u32 keyCode) override {
             if (keyCode == Input::Keys::Escape) { Quit(); }
         }
+
+        /// @brief Write VMA's detailed JSON stats here on exit
+        void SetMemoryReportPath(const char* path) {
+            mMemoryReportPath = path;
+        }
+
+        void OnDestroy() override {
+            const auto& latency = GetGame().GetRenderContext().GetPresentLatency();
+            if (latency.samples > 0) {
+                std::cout << "Input-to-present latency: " << latency.averageMs << " ms avg, " << latency.maxMs
+                          << " ms max (" << latency.samples << " frames)" << std::endl;
+            }
+
+            const auto pipelines = GetGame().GetRenderContext().GetPipelineManager().GetStats();
+            if (pipelines.misses > 0) {
+                std::cout << "Pipelines: " << pipelines.compiled << " compiled off-thread in "
+                          << pipelines.compileTimeMs << " ms, " << pipelines.failed << " failed, " << pipelines.hits
+                          << " cache hits" << std::endl;
+            }
+
+            auto& renderContext = GetGame().GetRenderContext();
+            if (renderContext.Initialized()) {
+                Graphics::MemoryReport::Print(renderContext.GetMemoryStats(), std::cout);
+
+                const auto defrag = renderContext.GetDefragmenter().GetStats();
+                if (defrag.runs > 0) {
+                    std::cout << "Defragmentation: " << defrag.runs << " runs, " << defrag.allocationsMoved
+                              << " allocations (" << defrag.bytesMoved << " bytes) moved in " << defrag.passes
+                              << " passes, " << defrag.blocksFreed << " blocks freed" << std::endl;
+                }
+
+                if (mMemoryReportPath) {
+                    std::ofstream file(mMemoryReportPath);
+                    file << renderContext.GetMemoryStatsJson(true);
+                }
+            }
+            GameApplication::OnDestroy();
+        }
+
+    private:
+        u32 mMipBenchmarkSize         = 0;
+        u32 mOcclusionBenchmarkCount  = 0;
+        const char* mMemoryReportPath = nullptr;
+
+        // Five walls 20 units down -Z and random boxes around them, through the renderer's culler and worker threads
+        void RunOcclusionBenchmark() {
+            using namespace Graphics;
+
+            // Unit cube, counter-clockwise seen from outside
+            static const Vec3 kCubePositions[8] = {
+              {-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1}, {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1}};
+            static const u32 kCubeIndices[36] = {4, 5, 6, 4, 6, 7, 1, 0, 3, 1, 3, 2, 5, 1, 2, 5, 2, 6,
+                                                 0, 4, 7, 0, 7, 3, 7, 6, 2, 7, 2, 3, 0, 1, 5, 0, 5, 4};
+
+            auto& renderContext = GetGame().GetRenderContext();
+            auto& culler        = renderContext.GetCpuOcclusionCuller();
+            if (!renderContext.Initialized() || culler.GetWidth() == 0) return;
+
+            const f32 aspect      = CAST<f32>(culler.GetWidth()) / CAST<f32>(culler.GetHeight());
+            Mat4x4 viewProjection = glm::perspectiveRH_ZO(glm::radians(60.0f), aspect, 0.1f, 200.0f);
+            viewProjection[1][1] *= -1.0f;
+
+            vector<Occluder> walls;
+            for (i32 i = -2; i <= 2; i++) {
+                Occluder& wall     = walls.emplace_back();
+                wall.positions     = kCubePositions;
+                wall.indices       = kCubeIndices;
+                wall.triangleCount = 12;
+                wall.modelMatrix   = glm::scale(glm::translate(Mat4x4(1.0f), Vec3(CAST<f32>(i) * 7.0f, 0, -20)),
+                                              Vec3(3, 4, 0.5f));
+            }
+
+            vector<OcclusionBounds> boxes;
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<f32> unit(-1.0f, 1.0f);
+            for (u32 i = 0; i < mOcclusionBenchmarkCount; i++) {
+                const Vec3 center(unit(rng) * 30.0f, unit(rng) * 12.0f, -45.0f + unit(rng) * 40.0f);
+                const Vec3 halfSize(0.3f + (unit(rng) + 1.0f) * 0.8f);
+                boxes.push_back({center - halfSize, center + halfSize});
+            }
+
+            constexpr u32 kIterations = 10;
+            vector<u8> visible(boxes.size());
+            f64 renderMs = 0;
+            f64 testMs   = 0;
+            for (u32 iteration = 0; iteration < kIterations; iteration++) {
+                culler.BeginFrame(viewProjection);
+                for (const auto& wall : walls) {
+                    culler.AddOccluder(wall);
+                }
+                culler.RenderOccluders(renderContext.GetThreadPool());
+                culler.TestBounds(renderContext.GetThreadPool(), boxes.data(), CAST<u32>(boxes.size()), visible.data());
+                renderMs += culler.GetStats().renderMs;
+                testMs += culler.GetStats().testMs;
+            }
+
+            const auto& stats = culler.GetStats();
+            std::cout << "CPU occlusion " << culler.GetWidth() << "x" << culler.GetHeight() << ": "
+                      << stats.triangles << " occluder triangles, " << stats.occluded << " of " << stats.tested
+                      << " boxes hidden, " << renderMs / kIterations << " ms render, " << testMs / kIterations
+                      << " ms test" << std::endl;
+        }
     };
+
+    static bool ParsePresentMode(const char* name, Graphics::PresentMode& mode) {
+        if (std::strcmp(name, "fifo") == 0) {
+            mode = Graphics::PresentMode::Fifo;
+        } else if (std::strcmp(name, "fifo-relaxed") == 0) {
+            mode = Graphics::PresentMode::FifoRelaxed;
+        } else if (std::strcmp(name, "mailbox") == 0) {
+            mode = Graphics::PresentMode::Mailbox;
+        } else if (std::strcmp(name, "immediate") == 0) {
+            mode = Graphics::PresentMode::Immediate;
+        } else {
+            return false;
+        }
+        return true;
+    }
 }  // namespace North
 
-int main() {
+// Usage: sandbox [--headless [frames]] [--no-render] [--present-mode <mode>] [--swapchain-images <count>]
+//                [--pipeline-cache <path|none>] [--cold-start] [--mip-benchmark <size>] [--memory-report <path>]
+//                [--render-pass] [--no-occlusion] [--occlusion-benchmark <n>]
+//   --headless [frames]         Run without a window for a fixed number of frames (0 = until quit) and print timings
+//   --no-render                 With --headless, skip Vulkan entirely and only run the simulation
+//   --present-mode <mode>       fifo (default), fifo-relaxed, mailbox or immediate
+//   --swapchain-images <count>  Minimum swapchain image count, fewer means less queued latency
+//   --pipeline-cache <path>     Pipeline cache file, "none" to not persist it
+//   --cold-start                Delete the pipeline cache first, to compare startup time against a warm run
+//   --mip-benchmark <size>      Time compute, blit and CPU mip generation of a size x size texture, then exit
+//   --memory-report <path>      Write VMA's detailed JSON memory stats on exit
+//   --render-pass               Draw through a render pass and framebuffers even if dynamic rendering is supported
+//   --no-occlusion              Frustum cull only, skip the Hi-Z occlusion test and the depth prepass
+//   --occlusion-benchmark <n>   Time CPU occlusion culling of n boxes behind a row of walls, then exit
+int main(int argc, char** argv) {
+    bool headless                     = false;
+    bool render                       = true;
+    North::u32 frameCount             = 0;
+    North::u32 swapchainImages        = 0;
+    North::Graphics::PresentMode mode = North::Graphics::PresentMode::Fifo;
+    bool coldStart                    = false;
+    const char* pipelineCachePath     = nullptr;
+    North::u32 mipBenchmarkSize       = 0;
+    North::u32 occlusionBoxes         = 0;
+    const char* memoryReportPath      = nullptr;
+    bool dynamicRendering             = true;
+    bool occlusionCulling             = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+            // The frame count is optional, the next flag isn't one
+            if (i + 1 < argc && std::isdigit((unsigned char)argv[i + 1][0])) {
+                frameCount = (North::u32)std::strtoul(argv[++i], nullptr, 10);
+            }
+        } else if (std::strcmp(argv[i], "--no-render") == 0) {
+            render = false;
+        } else if (std::strcmp(argv[i], "--present-mode") == 0 && i + 1 < argc) {
+            if (!North::ParsePresentMode(argv[++i], mode)) {
+                std::cerr << "Unknown present mode: " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+        } else if (std::strcmp(argv[i], "--swapchain-images") == 0 && i + 1 < argc) {
+            swapchainImages = (North::u32)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--pipeline-cache") == 0 && i + 1 < argc) {
+            pipelineCachePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--cold-start") == 0) {
+            coldStart = true;
+        } else if (std::strcmp(argv[i], "--mip-benchmark") == 0 && i + 1 < argc) {
+            mipBenchmarkSize = (North::u32)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--occlusion-benchmark") == 0 && i + 1 < argc) {
+            occlusionBoxes = (North::u32)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--memory-report") == 0 && i + 1 < argc) {
+            memoryReportPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--render-pass") == 0) {
+            dynamicRendering = false;
+        } else if (std::strcmp(argv[i], "--no-occlusion") == 0) {
+            occlusionCulling = false;
+        }
+    }
+
     North::SandboxApp app;
+    if (headless) { app.SetHeadless(frameCount, render); }
+    if (mipBenchmarkSize > 0) {
+        // One headless frame after the benchmark and the app exits
+        app.SetHeadless(1, true);
+        app.SetMipBenchmarkSize(mipBenchmarkSize);
+    }
+    if (occlusionBoxes > 0) {
+        app.SetHeadless(1, true);
+        app.SetOcclusionBenchmarkCount(occlusionBoxes);
+    }
+
+    if (memoryReportPath) { app.SetMemoryReportPath(memoryReportPath); }
+
+    auto& renderContext = app.GetGame().GetRenderContext();
+    renderContext.SetPresentMode(mode);
+    renderContext.SetSwapchainImageCount(swapchainImages);
+    renderContext.SetDynamicRendering(dynamicRendering);
+    renderContext.SetOcclusionCulling(occlusionCulling);
+    if (pipelineCachePath) {
+        renderContext.SetPipelineCachePath(std::strcmp(pipelineCachePath, "none") == 0 ? "" : pipelineCachePath);
+    }
+    if (coldStart && !renderContext.GetPipelineCachePath().empty()) {
+        std::error_code error;
+        North::fs::remove(renderContext.GetPipelineCachePath(), error);
+    }
+
     return app.Run();
 }
\ No newline at end of file
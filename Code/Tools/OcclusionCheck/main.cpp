@@ -0,0 +1,200 @@
+// Author: Jake Rieger
+// Created: 11/24/25.
+//
+
+#include "Graphics/CpuOcclusionCuller.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+// Usage: OcclusionCheck [--boxes <count>] [--seed <seed>]
+//
+// Renders a row of walls with CpuOcclusionCuller, tests random boxes against it and compares every box it hides
+// with a per-pixel depth buffer of the same walls. Fails when a box with any pixel in front of the walls was
+// hidden, or when boxes that are plainly in front of or behind a wall come out wrong. Built with NE_ENABLE_AVX2
+// it checks the AVX2 path.
+namespace {
+    using namespace North;
+    using namespace North::Graphics;
+
+    constexpr u32 kWidth  = 320;
+    constexpr u32 kHeight = 180;
+
+    // Unit cube, counter-clockwise seen from outside
+    const Vec3 kCubePositions[8] = {
+      {-1, -1, -1}, {1, -1, -1}, {1, 1, -1}, {-1, 1, -1}, {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1}};
+    const u32 kCubeIndices[36] = {4, 5, 6, 4, 6, 7, 1, 0, 3, 1, 3, 2, 5, 1, 2, 5, 2, 6,
+                                  0, 4, 7, 0, 7, 3, 7, 6, 2, 7, 2, 3, 0, 1, 5, 0, 5, 4};
+
+    Mat4x4 BoxMatrix(const Vec3& center, const Vec3& halfSize) {
+        Mat4x4 model = glm::translate(Mat4x4(1.0f), center);
+        return glm::scale(model, halfSize);
+    }
+
+    /// Nearest occluder depth at every pixel center, both windings, no clipping (the walls are all in view)
+    vector<f32> RasterizeReference(const vector<Occluder>& occluders, const Mat4x4& viewProjection) {
+        vector<f32> depth(kWidth * kHeight, 1.0f);
+
+        for (const auto& occluder : occluders) {
+            const Mat4x4 transform = viewProjection * occluder.modelMatrix;
+            for (u32 t = 0; t < occluder.triangleCount; t++) {
+                Vec3 v[3];
+                for (u32 i = 0; i < 3; i++) {
+                    const Vec4 clip = transform * Vec4(occluder.positions[occluder.indices[t * 3 + i]], 1.0f);
+                    v[i]            = Vec3((clip.x / clip.w * 0.5f + 0.5f) * kWidth,
+                                (clip.y / clip.w * 0.5f + 0.5f) * kHeight,
+                                clip.z / clip.w);
+                }
+
+                const auto edge = [](const Vec3& a, const Vec3& b, f32 x, f32 y) {
+                    return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+                };
+                const f32 area = edge(v[0], v[1], v[2].x, v[2].y);
+                if (area == 0) continue;
+
+                for (u32 y = 0; y < kHeight; y++) {
+                    for (u32 x = 0; x < kWidth; x++) {
+                        const f32 px = CAST<f32>(x) + 0.5f;
+                        const f32 py = CAST<f32>(y) + 0.5f;
+                        const f32 e0 = edge(v[1], v[2], px, py) / area;
+                        const f32 e1 = edge(v[2], v[0], px, py) / area;
+                        const f32 e2 = edge(v[0], v[1], px, py) / area;
+                        if (e0 < 0 || e1 < 0 || e2 < 0) continue;
+
+                        f32& nearest = depth[y * kWidth + x];
+                        nearest      = std::min(nearest, e0 * v[0].z + e1 * v[1].z + e2 * v[2].z);
+                    }
+                }
+            }
+        }
+        return depth;
+    }
+
+    /// True when some pixel the box's screen rectangle touches has the box in front of the reference depth,
+    /// the same rectangle CpuOcclusionCuller::IsVisible() tests
+    bool ReferenceVisible(const OcclusionBounds& bounds, const Mat4x4& viewProjection, const vector<f32>& depth) {
+        f32 minX    = 1.0f;
+        f32 minY    = 1.0f;
+        f32 maxX    = -1.0f;
+        f32 maxY    = -1.0f;
+        f32 nearest = 1.0f;
+        for (u32 i = 0; i < 8; i++) {
+            const Vec4 corner((i & 1) ? bounds.max.x : bounds.min.x,
+                              (i & 2) ? bounds.max.y : bounds.min.y,
+                              (i & 4) ? bounds.max.z : bounds.min.z,
+                              1.0f);
+            const Vec4 clip = viewProjection * corner;
+            if (clip.z < 0 || clip.w <= 0) return true;
+
+            minX    = std::min(minX, clip.x / clip.w);
+            minY    = std::min(minY, clip.y / clip.w);
+            maxX    = std::max(maxX, clip.x / clip.w);
+            maxY    = std::max(maxY, clip.y / clip.w);
+            nearest = std::min(nearest, clip.z / clip.w);
+        }
+        if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f || nearest > 1.0f) return false;
+
+        const i32 xBegin = std::max(CAST<i32>(std::floor((minX * 0.5f + 0.5f) * kWidth)), 0);
+        const i32 yBegin = std::max(CAST<i32>(std::floor((minY * 0.5f + 0.5f) * kHeight)), 0);
+        const i32 xEnd   = std::min(CAST<i32>(std::floor((maxX * 0.5f + 0.5f) * kWidth)) + 1, CAST<i32>(kWidth));
+        const i32 yEnd   = std::min(CAST<i32>(std::floor((maxY * 0.5f + 0.5f) * kHeight)) + 1, CAST<i32>(kHeight));
+        for (i32 y = yBegin; y < yEnd; y++) {
+            for (i32 x = xBegin; x < xEnd; x++) {
+                if (nearest <= depth[y * kWidth + x]) return true;
+            }
+        }
+        return false;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    u32 boxCount = 20000;
+    u32 seed     = 42;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--boxes") == 0 && hasValue) {
+            boxCount = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Camera at the origin looking down -Z, Vulkan clip space like the renderer
+    Mat4x4 viewProjection = glm::perspectiveRH_ZO(glm::radians(60.0f), CAST<f32>(kWidth) / kHeight, 0.1f, 200.0f);
+    viewProjection[1][1] *= -1.0f;
+
+    // Five walls side by side 20 units ahead, with gaps between them
+    vector<Occluder> walls;
+    for (i32 i = -2; i <= 2; i++) {
+        Occluder& wall     = walls.emplace_back();
+        wall.positions     = kCubePositions;
+        wall.indices       = kCubeIndices;
+        wall.triangleCount = 12;
+        wall.modelMatrix   = BoxMatrix(Vec3(CAST<f32>(i) * 7.0f, 0, -20), Vec3(3, 4, 0.5f));
+    }
+
+    // Known answers first, then boxes scattered in front of, between and behind the walls
+    vector<OcclusionBounds> boxes = {
+      {{-0.5f, -0.5f, -31}, {0.5f, 0.5f, -30}},    // Behind the middle wall
+      {{-0.5f, -0.5f, -6}, {0.5f, 0.5f, -5}},      // In front of it
+      {{4.9f, -0.5f, -30.5f}, {5.5f, 0.5f, -30}},  // Seen through the gap between two walls
+    };
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<f32> unit(-1.0f, 1.0f);
+    for (u32 i = 0; i < boxCount; i++) {
+        const Vec3 center(unit(rng) * 30.0f, unit(rng) * 12.0f, -45.0f + unit(rng) * 40.0f);
+        const Vec3 halfSize(0.3f + (unit(rng) + 1.0f) * 0.8f);
+        boxes.push_back({center - halfSize, center + halfSize});
+    }
+
+    ThreadPool threadPool;
+    threadPool.Start();
+
+    CpuOcclusionCuller culler;
+    culler.Resize(kWidth, kHeight);
+    culler.BeginFrame(viewProjection);
+    for (const auto& wall : walls) {
+        culler.AddOccluder(wall);
+    }
+    culler.RenderOccluders(threadPool);
+
+    vector<u8> visible(boxes.size());
+    culler.TestBounds(threadPool, boxes.data(), CAST<u32>(boxes.size()), visible.data());
+    threadPool.Stop();
+
+    const vector<f32> depth = RasterizeReference(walls, viewProjection);
+    u32 falseOcclusions     = 0;
+    u32 referenceOccluded   = 0;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        const bool referenceVisible = ReferenceVisible(boxes[i], viewProjection, depth);
+        referenceOccluded += referenceVisible ? 0 : 1;
+        if (!visible[i] && referenceVisible) { falseOcclusions++; }
+    }
+
+    const auto& stats = culler.GetStats();
+    std::cout << stats.triangles << " occluder triangles, " << stats.occluded << " of " << stats.tested
+              << " boxes hidden (" << referenceOccluded << " per pixel), " << falseOcclusions
+              << " hidden but visible" << std::endl;
+
+    bool passed = falseOcclusions == 0;
+    if (visible[0] || !visible[1] || !visible[2]) {
+        std::cerr << "Known boxes came out wrong: behind " << CAST<u32>(visible[0]) << ", in front "
+                  << CAST<u32>(visible[1]) << ", through the gap " << CAST<u32>(visible[2]) << std::endl;
+        passed = false;
+    }
+    if (stats.occluded == 0) {
+        std::cerr << "Nothing was hidden" << std::endl;
+        passed = false;
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
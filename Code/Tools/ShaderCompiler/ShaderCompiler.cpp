@@ -0,0 +1,443 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "ShaderCompiler.hpp"
+#include "SpirvReflector.hpp"
+#include "Common/ThreadPool.hpp"
+#include "Graphics/Shader.hpp"
+#include "Graphics/ShaderReflection.hpp"
+#include "Graphics/ShaderVariants.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace North::Tools {
+    namespace {
+        constexpr u64 kHashSeed = 14695981039346656037ull;
+
+        /// FNV-1a
+        u64 Hash(const char* data, size_t size, u64 hash) {
+            for (size_t i = 0; i < size; i++) {
+                hash ^= CAST<u8>(data[i]);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        u64 Hash(const string& value, u64 hash) {
+            return Hash(value.data(), value.size(), hash);
+        }
+
+        bool ReadFile(const fs::path& path, string& out) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) return false;
+
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            out = contents.str();
+            return true;
+        }
+
+        /// Path of an `#include "file"` or `#include <file>` directive, empty for any other line
+        string GetIncludePath(const string& line) {
+            const size_t start = line.find_first_not_of(" \t");
+            if (start == string::npos || line.compare(start, 8, "#include") != 0) return {};
+
+            const size_t open = line.find_first_of("\"<", start + 8);
+            if (open == string::npos) return {};
+
+            const size_t close = line.find(line[open] == '"' ? '"' : '>', open + 1);
+            if (close == string::npos) return {};
+
+            return line.substr(open + 1, close - open - 1);
+        }
+
+        string Quote(const fs::path& path) {
+            return "\"" + path.string() + "\"";
+        }
+
+        /// Names from the source's `// @features` line, in bit order
+        vector<string> ReadFeatures(const string& contents) {
+            std::istringstream lines(contents);
+            string line;
+            while (std::getline(lines, line)) {
+                const size_t start = line.find("// @features");
+                if (start == string::npos) continue;
+
+                vector<string> features;
+                std::istringstream names(line.substr(start + 12));
+                string name;
+                while (names >> name) {
+                    features.push_back(name);
+                }
+                return features;
+            }
+            return {};
+        }
+
+        /// glslc stage name (the GLSL extension) to the matching HLSL shader model profile
+        const char* GetHlslProfile(const string& stage) {
+            if (stage == "vert") return "vs_6_0";
+            if (stage == "frag") return "ps_6_0";
+            if (stage == "comp") return "cs_6_0";
+            if (stage == "geom") return "gs_6_0";
+            if (stage == "tesc") return "hs_6_0";
+            if (stage == "tese") return "ds_6_0";
+            return nullptr;
+        }
+    }  // namespace
+
+    ShaderCompiler::ShaderCompiler(ShaderCompilerOptions options) : mOptions(std::move(options)) {}
+
+    bool ShaderCompiler::Run() {
+        if (!fs::is_directory(mOptions.sourceDir)) {
+            std::cerr << "Shader source directory not found: " << mOptions.sourceDir.string() << std::endl;
+            return false;
+        }
+
+        std::error_code error;
+        fs::create_directories(mOptions.outputDir, error);
+        if (error) {
+            std::cerr << "Failed to create shader output directory: " << mOptions.outputDir.string() << std::endl;
+            return false;
+        }
+
+        if (!mOptions.force) { LoadManifest(); }
+        if (!LoadVariantList()) return false;
+
+        vector<fs::path> sources;
+        for (const auto& entry : fs::directory_iterator(mOptions.sourceDir)) {
+            if (entry.is_regular_file()) { sources.push_back(entry.path()); }
+        }
+        std::sort(sources.begin(), sources.end());
+
+        vector<Job> jobs;
+        for (const auto& source : sources) {
+            Job job;
+            if (CreateJob(source, job)) { jobs.push_back(std::move(job)); }
+        }
+
+        RemoveStaleOutputs(jobs);
+
+        vector<const Job*> pending;
+        for (const auto& job : jobs) {
+            const auto it       = mManifest.find(job.name);
+            const bool upToDate = it != mManifest.end() && it->second == job.hash &&
+                                  fs::exists(mOptions.outputDir / (job.name + ".spv")) &&
+                                  fs::exists(mOptions.outputDir / (job.name + ".refl"));
+            if (!upToDate) { pending.push_back(&job); }
+        }
+
+        // Each job writes only its own result slot, the manifest is updated once every worker has finished
+        vector<u8> succeeded(pending.size(), 0);
+        {
+            // This thread only waits, so 0 gets a worker per hardware thread instead of ThreadPool's one less
+            const u32 hardwareThreads = NE_MAX(std::thread::hardware_concurrency(), 1u);
+            ThreadPool pool;
+            pool.Start(mOptions.threadCount > 0 ? mOptions.threadCount : hardwareThreads);
+            for (size_t i = 0; i < pending.size(); i++) {
+                pool.Enqueue([this, &pending, &succeeded, i] { succeeded[i] = Compile(*pending[i]) ? 1 : 0; });
+            }
+            pool.Stop();
+        }
+
+        u32 failed = 0;
+        for (size_t i = 0; i < pending.size(); i++) {
+            if (succeeded[i]) {
+                mManifest[pending[i]->name] = pending[i]->hash;
+            } else {
+                mManifest.erase(pending[i]->name);
+                failed++;
+            }
+        }
+
+        const bool saved = SaveManifest();
+        std::cout << "Shaders: " << pending.size() - failed << " compiled, " << jobs.size() - pending.size()
+                  << " up to date, " << failed << " failed" << std::endl;
+
+        return failed == 0 && mErrors == 0 && saved;
+    }
+
+    bool ShaderCompiler::CreateJob(const fs::path& source, Job& job) {
+        const string extension = source.extension().string();
+        job.name               = source.filename().string();
+        job.source             = source;
+
+        if (extension == ".hlsl") {
+            const string stage = source.stem().extension().string();
+            job.hlslProfile    = stage.empty() ? nullptr : GetHlslProfile(stage.substr(1));
+            if (!job.hlslProfile) {
+                std::cerr << "Skipping " << job.name
+                          << ", HLSL files need their stage before the extension (e.g. Blur.comp.hlsl)" << std::endl;
+                return false;
+            }
+        } else if (extension != ".vert" && extension != ".frag" && extension != ".comp" && extension != ".geom" &&
+                   extension != ".tesc" && extension != ".tese") {
+            return false;  // Include files and anything else that isn't a shader stage
+        }
+
+        string contents;
+        if (!ReadFile(source, contents)) {
+            std::cerr << "Failed to read " << source.string() << std::endl;
+            mErrors++;
+            return false;
+        }
+
+        job.features = ReadFeatures(contents);
+        if (job.features.size() > Graphics::ShaderVariantTable::kMaxFeatures) {
+            std::cerr << job.name << " declares more than " << Graphics::ShaderVariantTable::kMaxFeatures
+                      << " features" << std::endl;
+            mErrors++;
+            return false;
+        }
+
+        // Only the combinations content asks for, anything else would be built for nothing
+        Graphics::ShaderVariantTable table;
+        table.features = job.features;
+        job.variants   = {0};
+        if (const auto it = mRequestedVariants.find(job.name); it != mRequestedVariants.end()) {
+            for (const auto& featureSet : it->second) {
+                u64 variant = 0;
+                if (!table.GetMask(featureSet, variant)) {
+                    std::cerr << kVariantListName << " requests a feature " << job.name << " doesn't declare"
+                              << std::endl;
+                    mErrors++;
+                    continue;
+                }
+                job.variants.push_back(variant);
+            }
+        }
+        std::sort(job.variants.begin(), job.variants.end());
+        job.variants.erase(std::unique(job.variants.begin(), job.variants.end()), job.variants.end());
+
+        // Compiler settings, variants and the output formats are part of the hash, changing any of them rebuilds
+        // the shader
+        std::ostringstream settings;
+        settings << BuildCommand(job, 0, {}) << " reflection " << Graphics::ShaderReflection::kVersion << " variants "
+                 << Graphics::ShaderVariantTable::kVersion;
+        for (const u64 variant : job.variants) {
+            settings << " " << variant;
+        }
+
+        vector<fs::path> visited;
+        job.hash = HashSource(source, Hash(settings.str(), kHashSeed), visited);
+
+        return true;
+    }
+
+    string ShaderCompiler::BuildCommand(const Job& job, u64 variant, const fs::path& output) const {
+        string defines;
+        for (size_t i = 0; i < job.features.size(); i++) {
+            if (variant & (1ull << i)) { defines += " -D" + job.features[i] + "=1"; }
+        }
+
+        // Paths are left out when building the settings hash, so moving the checkout doesn't rebuild everything
+        const bool forHash = output.empty();
+        string command;
+        if (job.hlslProfile) {
+            command = (forHash ? string("dxc") : Quote(mOptions.dxc)) +
+                      " -spirv -fspv-target-env=vulkan1.2 -O3 -E main -T " + job.hlslProfile + defines;
+            if (!forHash) {
+                command += " -I " + Quote(mOptions.sourceDir) + " " + Quote(job.source) + " -Fo " + Quote(output);
+            }
+        } else {
+            command = (forHash ? string("glslc") : Quote(mOptions.glslc)) + " --target-env=vulkan1.2 -O" + defines;
+            if (!forHash) {
+                command += " -I " + Quote(mOptions.sourceDir) + " " + Quote(job.source) + " -o " + Quote(output);
+            }
+        }
+
+#ifdef NE_PLATFORM_WINDOWS
+        // cmd.exe strips the outer quotes of the whole command line when it starts with a quoted path
+        if (!forHash) { command = "\"" + command + "\""; }
+#endif
+
+        return command;
+    }
+
+    bool ShaderCompiler::Compile(const Job& job) {
+        // Variants dropped from the list since the last build shouldn't linger
+        RemoveOutputs(job.name);
+
+        Graphics::ShaderVariantTable table;
+        table.features = job.features;
+
+        struct UniqueCode {
+            u64 variant;
+            u64 hash;
+            vector<u32> code;
+        };
+        vector<UniqueCode> unique;
+
+        for (const u64 variant : job.variants) {
+            const string variantName = Graphics::ShaderVariantTable::GetVariantName(job.name, variant);
+            const fs::path output    = mOptions.outputDir / (variantName + ".spv");
+
+            if (std::system(BuildCommand(job, variant, output).c_str()) != 0) {
+                Log("Failed to compile " + variantName);
+                return false;
+            }
+
+            vector<u32> code = Graphics::Shader::LoadSpirv(output);
+            if (code.empty()) {
+                Log("Compiler produced no SPIR-V for " + variantName);
+                return false;
+            }
+
+            // Features that don't change this stage's code leave identical SPIR-V, keep a single copy
+            const u64 hash = Hash(RCAST<const char*>(code.data()), code.size() * sizeof(u32), kHashSeed);
+            const auto it  = std::find_if(unique.begin(), unique.end(), [&](const UniqueCode& other) {
+                return other.hash == hash && other.code == code;
+            });
+            if (it != unique.end()) {
+                std::error_code error;
+                fs::remove(output, error);
+                table.variants.push_back({variant, it->variant});
+                continue;
+            }
+
+            Graphics::ShaderReflection reflection;
+            string error;
+            if (!SpirvReflector::Reflect(code, reflection, error)) {
+                Log("Failed to reflect " + variantName + ": " + error);
+                return false;
+            }
+
+            reflection.sourceHash = job.hash;
+            if (!reflection.Save(mOptions.outputDir / (variantName + ".refl"))) return false;
+
+            table.variants.push_back({variant, variant});
+            unique.push_back({variant, hash, std::move(code)});
+        }
+
+        if (!job.features.empty() && !table.Save(mOptions.outputDir / (job.name + ".variants"))) return false;
+
+        if (job.variants.size() > 1) {
+            Log("Compiled " + job.name + " (" + std::to_string(job.variants.size()) + " variants, " +
+                std::to_string(unique.size()) + " unique)");
+        } else {
+            Log("Compiled " + job.name);
+        }
+        return true;
+    }
+
+    u64 ShaderCompiler::HashSource(const fs::path& source, u64 hash, vector<fs::path>& visited) const {
+        string contents;
+        if (!ReadFile(source, contents)) return hash;  // Missing includes are left for the compiler to report
+
+        visited.push_back(fs::weakly_canonical(source));
+        hash = Hash(contents, hash);
+
+        std::istringstream lines(contents);
+        string line;
+        while (std::getline(lines, line)) {
+            const string include = GetIncludePath(line);
+            if (include.empty()) continue;
+
+            // Same search order as the compilers: next to the including file, then the source directory
+            fs::path path = source.parent_path() / include;
+            if (!fs::exists(path)) { path = mOptions.sourceDir / include; }
+            if (!fs::exists(path)) continue;
+
+            if (std::find(visited.begin(), visited.end(), fs::weakly_canonical(path)) != visited.end()) continue;
+            hash = HashSource(path, Hash(include, hash), visited);
+        }
+
+        return hash;
+    }
+
+    bool ShaderCompiler::LoadVariantList() {
+        std::ifstream file(mOptions.sourceDir / kVariantListName);
+        if (!file.is_open()) return true;  // Optional, without it only base variants are built
+
+        string line;
+        while (std::getline(file, line)) {
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream tokens(line);
+            string shader;
+            if (!(tokens >> shader)) continue;
+
+            vector<string> features;
+            string feature;
+            while (tokens >> feature) {
+                features.push_back(feature);
+            }
+            mRequestedVariants[shader].push_back(std::move(features));
+        }
+
+        return true;
+    }
+
+    void ShaderCompiler::LoadManifest() {
+        std::ifstream file(mOptions.outputDir / kManifestName);
+        if (!file.is_open()) return;
+
+        u64 hash = 0;
+        string name;
+        while (file >> std::hex >> hash >> name) {
+            mManifest[name] = hash;
+        }
+    }
+
+    bool ShaderCompiler::SaveManifest() const {
+        vector<std::pair<string, u64>> entries(mManifest.begin(), mManifest.end());
+        std::sort(entries.begin(), entries.end());
+
+        std::ofstream file(mOptions.outputDir / kManifestName, std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write shader manifest in " << mOptions.outputDir.string() << std::endl;
+            return false;
+        }
+
+        for (const auto& [name, hash] : entries) {
+            file << std::hex << hash << " " << name << "\n";
+        }
+
+        return file.good();
+    }
+
+    void ShaderCompiler::RemoveStaleOutputs(const vector<Job>& jobs) {
+        for (auto it = mManifest.begin(); it != mManifest.end();) {
+            const string& name = it->first;
+            const bool exists  =
+              std::any_of(jobs.begin(), jobs.end(), [&](const Job& job) { return job.name == name; });
+            if (exists) {
+                ++it;
+                continue;
+            }
+
+            RemoveOutputs(name);
+            std::cout << "Removed outputs of deleted shader " << name << std::endl;
+            it = mManifest.erase(it);
+        }
+    }
+
+    void ShaderCompiler::RemoveOutputs(const string& name) const {
+        std::error_code error;
+        fs::remove(mOptions.outputDir / (name + ".variants"), error);
+
+        for (const auto& entry : fs::directory_iterator(mOptions.outputDir, error)) {
+            const string extension = entry.path().extension().string();
+            if (extension != ".spv" && extension != ".refl") continue;
+
+            // "<name>" or "<name>.v<hex mask>", other shaders can share the prefix (Blur.comp, Blur.comp.hlsl)
+            const string stem    = entry.path().stem().string();
+            const string tag     = name + ".v";
+            const bool isBase    = stem == name;
+            const bool isVariant = stem.size() > tag.size() && stem.compare(0, tag.size(), tag) == 0 &&
+                                   stem.find_first_not_of("0123456789abcdef", tag.size()) == string::npos;
+            if (isBase || isVariant) { fs::remove(entry.path(), error); }
+        }
+    }
+
+    void ShaderCompiler::Log(const string& message) {
+        std::lock_guard lock(mLogMutex);
+        std::cout << message << std::endl;
+    }
+}  // namespace North::Tools
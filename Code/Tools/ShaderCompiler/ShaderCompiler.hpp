@@ -0,0 +1,78 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace North::Tools {
+    struct ShaderCompilerOptions {
+        fs::path sourceDir;
+        fs::path outputDir;
+        string glslc    = "glslc";
+        string dxc      = "dxc";
+        bool force      = false;  // Rebuild everything, ignoring the manifest
+        u32 threadCount = 0;      // 0 uses every hardware thread
+    };
+
+    /**
+     * @brief Offline shader build
+     *
+     * Compiles every shader in the source directory to `<file name>.spv` in the output directory and writes its
+     * reflection next to it as `<file name>.refl` (see Graphics::ShaderReflection). GLSL stages are picked by
+     * extension (.vert, .frag, .comp, .geom, .tesc, .tese) and built with glslc. HLSL files name their stage
+     * before the extension, e.g. "Blur.comp.hlsl", and are built with dxc using `main` as the entry point.
+     *
+     * Shaders with a `// @features NAME ...` line get a variant per feature combination listed for them in the
+     * source directory's Variants.txt (`Mesh.frag ALPHA_TEST NORMAL_MAP`, one combination per line), on top of the
+     * base variant. Each is compiled with its features defined to 1; variants that come out identical are stored
+     * once and a ShaderVariantTable maps every variant to the files holding its code.
+     *
+     * Builds are incremental: each shader's hash covers its source, every file it #includes, its variants and the
+     * compiler settings, and is stored in the output directory's manifest. Shaders whose hash and outputs are
+     * unchanged are skipped, the rest are compiled in parallel.
+     */
+    class ShaderCompiler {
+    public:
+        static constexpr const char* kManifestName    = "ShaderManifest.txt";
+        static constexpr const char* kVariantListName = "Variants.txt";
+
+        explicit ShaderCompiler(ShaderCompilerOptions options);
+
+        /// @return false if any shader failed to build
+        bool Run();
+
+    private:
+        struct Job {
+            string name;
+            fs::path source;
+            const char* hlslProfile = nullptr;  // Null for GLSL
+            vector<string> features;
+            vector<u64> variants;  // Sorted, always starts with the base variant
+            u64 hash = 0;
+        };
+
+        bool CreateJob(const fs::path& source, Job& job);
+        string BuildCommand(const Job& job, u64 variant, const fs::path& output) const;
+        bool Compile(const Job& job);
+        u64 HashSource(const fs::path& source, u64 hash, vector<fs::path>& visited) const;
+
+        bool LoadVariantList();
+        void LoadManifest();
+        bool SaveManifest() const;
+        void RemoveStaleOutputs(const vector<Job>& jobs);
+        void RemoveOutputs(const string& name) const;
+
+        void Log(const string& message);
+
+        ShaderCompilerOptions mOptions;
+        std::unordered_map<string, u64> mManifest;
+        std::unordered_map<string, vector<vector<string>>> mRequestedVariants;  // Feature sets by shader name
+        u32 mErrors = 0;
+        std::mutex mLogMutex;
+    };
+}  // namespace North::Tools
@@ -0,0 +1,431 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "SpirvReflector.hpp"
+
+namespace North::Tools {
+    namespace {
+        constexpr u32 kSpirvMagic = 0x07230203;
+        constexpr u32 kHeaderSize = 5;
+        constexpr u32 kUnset      = ~0u;
+
+        // Opcodes
+        constexpr u32 kOpEntryPoint                   = 15;
+        constexpr u32 kOpTypeBool                     = 20;
+        constexpr u32 kOpTypeInt                      = 21;
+        constexpr u32 kOpTypeFloat                    = 22;
+        constexpr u32 kOpTypeVector                   = 23;
+        constexpr u32 kOpTypeMatrix                   = 24;
+        constexpr u32 kOpTypeImage                    = 25;
+        constexpr u32 kOpTypeSampler                  = 26;
+        constexpr u32 kOpTypeSampledImage             = 27;
+        constexpr u32 kOpTypeArray                    = 28;
+        constexpr u32 kOpTypeRuntimeArray             = 29;
+        constexpr u32 kOpTypeStruct                   = 30;
+        constexpr u32 kOpTypePointer                  = 32;
+        constexpr u32 kOpConstant                     = 43;
+        constexpr u32 kOpVariable                     = 59;
+        constexpr u32 kOpDecorate                     = 71;
+        constexpr u32 kOpMemberDecorate               = 72;
+        constexpr u32 kOpTypeAccelerationStructureKHR = 5341;
+
+        // Decorations
+        constexpr u32 kDecorationBufferBlock   = 3;
+        constexpr u32 kDecorationArrayStride   = 6;
+        constexpr u32 kDecorationMatrixStride  = 7;
+        constexpr u32 kDecorationBuiltIn       = 11;
+        constexpr u32 kDecorationLocation      = 30;
+        constexpr u32 kDecorationBinding       = 33;
+        constexpr u32 kDecorationDescriptorSet = 34;
+        constexpr u32 kDecorationOffset        = 35;
+
+        // Storage classes
+        constexpr u32 kStorageUniformConstant = 0;
+        constexpr u32 kStorageInput           = 1;
+        constexpr u32 kStorageUniform         = 2;
+        constexpr u32 kStoragePushConstant    = 9;
+        constexpr u32 kStorageStorageBuffer   = 12;
+
+        // Image dimensions
+        constexpr u32 kDimBuffer      = 5;
+        constexpr u32 kDimSubpassData = 6;
+
+        struct Member {
+            u32 offset       = 0;
+            u32 matrixStride = 0;
+        };
+
+        /// Everything known about one result id
+        struct Id {
+            u32 opcode = 0;
+            vector<u32> operands;  // Words after the result id (result type first for constants/variables)
+
+            u32 set          = kUnset;
+            u32 binding      = kUnset;
+            u32 location     = kUnset;
+            u32 arrayStride  = 0;
+            bool builtIn     = false;
+            bool bufferBlock = false;
+            vector<Member> members;
+        };
+
+        class Module {
+        public:
+            explicit Module(const vector<u32>& code) : mCode(code) {}
+
+            bool Parse(string& error) {
+                if (mCode.size() < kHeaderSize || mCode[0] != kSpirvMagic) {
+                    error = "not a SPIR-V module";
+                    return false;
+                }
+
+                mIds.resize(mCode[3]);  // Id bound
+
+                size_t offset = kHeaderSize;
+                while (offset < mCode.size()) {
+                    const u32 wordCount = mCode[offset] >> 16;
+                    const u32 opcode    = mCode[offset] & 0xFFFF;
+                    if (wordCount == 0 || offset + wordCount > mCode.size()) {
+                        error = "truncated instruction";
+                        return false;
+                    }
+
+                    if (!ParseInstruction(opcode, &mCode[offset], wordCount, error)) return false;
+                    offset += wordCount;
+                }
+
+                if (mExecutionModel == kUnset) {
+                    error = "module has no entry point";
+                    return false;
+                }
+
+                return true;
+            }
+
+            NE_ND VkShaderStageFlagBits GetStage() const {
+                switch (mExecutionModel) {
+                    case 0:
+                        return VK_SHADER_STAGE_VERTEX_BIT;
+                    case 1:
+                        return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+                    case 2:
+                        return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+                    case 3:
+                        return VK_SHADER_STAGE_GEOMETRY_BIT;
+                    case 4:
+                        return VK_SHADER_STAGE_FRAGMENT_BIT;
+                    case 5:
+                        return VK_SHADER_STAGE_COMPUTE_BIT;
+                    default:
+                        return VK_SHADER_STAGE_ALL;
+                }
+            }
+
+            NE_ND const vector<Id>& GetIds() const {
+                return mIds;
+            }
+
+            NE_ND const Id* Get(u32 id) const {
+                return id < mIds.size() ? &mIds[id] : nullptr;
+            }
+
+            NE_ND u32 GetConstant(u32 id) const {
+                const Id* constant = Get(id);
+                return constant && constant->opcode == kOpConstant && constant->operands.size() >= 2
+                         ? constant->operands[1]
+                         : 0;
+            }
+
+            /// Size in bytes of a type as laid out in a block, 0 for runtime arrays
+            NE_ND u32 GetTypeSize(u32 typeId, u32 matrixStride = 0) const {
+                const Id* type = Get(typeId);
+                if (!type) return 0;
+
+                switch (type->opcode) {
+                    case kOpTypeBool:
+                        return 4;
+                    case kOpTypeInt:
+                    case kOpTypeFloat:
+                        return type->operands[0] / 8;
+                    case kOpTypeVector:
+                        return type->operands[1] * GetTypeSize(type->operands[0]);
+                    case kOpTypeMatrix: {
+                        const u32 columnSize = matrixStride != 0 ? matrixStride : GetTypeSize(type->operands[0]);
+                        return type->operands[1] * columnSize;
+                    }
+                    case kOpTypeArray: {
+                        const u32 stride = type->arrayStride != 0 ? type->arrayStride : GetTypeSize(type->operands[0]);
+                        return GetConstant(type->operands[1]) * stride;
+                    }
+                    case kOpTypeStruct: {
+                        u32 size = 0;
+                        for (size_t i = 0; i < type->operands.size(); i++) {
+                            const Member member = i < type->members.size() ? type->members[i] : Member {};
+                            size = NE_MAX(size, member.offset + GetTypeSize(type->operands[i], member.matrixStride));
+                        }
+                        return size;
+                    }
+                    default:
+                        return 0;
+                }
+            }
+
+        private:
+            bool ParseInstruction(u32 opcode, const u32* words, u32 wordCount, string& error) {
+                switch (opcode) {
+                    case kOpEntryPoint:
+                        if (mExecutionModel != kUnset) {
+                            error = "modules with more than one entry point aren't supported";
+                            return false;
+                        }
+                        mExecutionModel = words[1];
+                        break;
+
+                    case kOpDecorate: {
+                        Id* target = Lookup(words[1]);
+                        if (!target || wordCount < 3) break;
+                        const u32 value = wordCount > 3 ? words[3] : 0;
+                        switch (words[2]) {
+                            case kDecorationBufferBlock:
+                                target->bufferBlock = true;
+                                break;
+                            case kDecorationArrayStride:
+                                target->arrayStride = value;
+                                break;
+                            case kDecorationBuiltIn:
+                                target->builtIn = true;
+                                break;
+                            case kDecorationLocation:
+                                target->location = value;
+                                break;
+                            case kDecorationBinding:
+                                target->binding = value;
+                                break;
+                            case kDecorationDescriptorSet:
+                                target->set = value;
+                                break;
+                            default:
+                                break;
+                        }
+                        break;
+                    }
+
+                    case kOpMemberDecorate: {
+                        Id* target = Lookup(words[1]);
+                        if (!target || wordCount < 5) break;
+                        const u32 member = words[2];
+                        if (target->members.size() <= member) { target->members.resize(member + 1); }
+                        if (words[3] == kDecorationOffset) { target->members[member].offset = words[4]; }
+                        if (words[3] == kDecorationMatrixStride) { target->members[member].matrixStride = words[4]; }
+                        break;
+                    }
+
+                    case kOpTypeBool:
+                    case kOpTypeInt:
+                    case kOpTypeFloat:
+                    case kOpTypeVector:
+                    case kOpTypeMatrix:
+                    case kOpTypeImage:
+                    case kOpTypeSampler:
+                    case kOpTypeSampledImage:
+                    case kOpTypeArray:
+                    case kOpTypeRuntimeArray:
+                    case kOpTypeStruct:
+                    case kOpTypePointer:
+                    case kOpTypeAccelerationStructureKHR:
+                        if (!Define(words[1], opcode, words + 2, wordCount - 2, error)) return false;
+                        break;
+
+                    case kOpConstant:
+                    case kOpVariable:
+                        // Result type comes before the result id, keep it as the first operand
+                        if (wordCount < 3) break;
+                        if (!Define(words[2], opcode, words + 3, wordCount - 3, error)) return false;
+                        mIds[words[2]].operands.insert(mIds[words[2]].operands.begin(), words[1]);
+                        break;
+
+                    default:
+                        break;
+                }
+
+                return true;
+            }
+
+            bool Define(u32 id, u32 opcode, const u32* operands, u32 operandCount, string& error) {
+                Id* result = Lookup(id);
+                if (!result) {
+                    error = "id out of bounds";
+                    return false;
+                }
+
+                result->opcode = opcode;
+                result->operands.assign(operands, operands + operandCount);
+                return true;
+            }
+
+            Id* Lookup(u32 id) {
+                return id < mIds.size() ? &mIds[id] : nullptr;
+            }
+
+            const vector<u32>& mCode;
+            vector<Id> mIds;
+            u32 mExecutionModel = kUnset;
+        };
+
+        /// Maps the pointee of a resource variable to its descriptor type
+        bool GetDescriptorType(const Module& module, const Id& type, u32 storageClass, VkDescriptorType& out) {
+            if (storageClass == kStorageStorageBuffer) {
+                out = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                return true;
+            }
+
+            if (storageClass == kStorageUniform) {
+                // Before SPIR-V 1.3 storage buffers were Uniform blocks decorated BufferBlock
+                out = type.bufferBlock ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                return true;
+            }
+
+            switch (type.opcode) {
+                case kOpTypeSampler:
+                    out = VK_DESCRIPTOR_TYPE_SAMPLER;
+                    return true;
+                case kOpTypeSampledImage: {
+                    const Id* image = module.Get(type.operands[0]);
+                    out = image && image->operands[1] == kDimBuffer ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER
+                                                                    : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                    return true;
+                }
+                case kOpTypeImage: {
+                    const u32 dim     = type.operands[1];
+                    const bool stored = type.operands[5] == 2;  // Sampled == 2 means read/write without a sampler
+                    if (dim == kDimSubpassData) {
+                        out = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                    } else if (dim == kDimBuffer) {
+                        out = stored ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
+                                     : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                    } else {
+                        out = stored ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                    }
+                    return true;
+                }
+                case kOpTypeAccelerationStructureKHR:
+                    out = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        /// Vertex input format of a 32-bit scalar or vector type
+        VkFormat GetVertexFormat(const Module& module, const Id& type) {
+            u32 components   = 1;
+            const Id* scalar = &type;
+            if (type.opcode == kOpTypeVector) {
+                components = type.operands[1];
+                scalar     = module.Get(type.operands[0]);
+            }
+
+            if (!scalar || components < 1 || components > 4) return VK_FORMAT_UNDEFINED;
+            if (scalar->opcode != kOpTypeFloat && scalar->opcode != kOpTypeInt) return VK_FORMAT_UNDEFINED;
+            if (scalar->operands[0] != 32) return VK_FORMAT_UNDEFINED;
+
+            static constexpr VkFormat kFloatFormats[] = {VK_FORMAT_R32_SFLOAT,
+                                                         VK_FORMAT_R32G32_SFLOAT,
+                                                         VK_FORMAT_R32G32B32_SFLOAT,
+                                                         VK_FORMAT_R32G32B32A32_SFLOAT};
+            static constexpr VkFormat kIntFormats[]   = {
+              VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+            static constexpr VkFormat kUintFormats[]  = {
+              VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+
+            if (scalar->opcode == kOpTypeFloat) return kFloatFormats[components - 1];
+            return scalar->operands[1] != 0 ? kIntFormats[components - 1] : kUintFormats[components - 1];
+        }
+    }  // namespace
+
+    bool SpirvReflector::Reflect(const vector<u32>& code, Graphics::ShaderReflection& out, string& error) {
+        Module module(code);
+        if (!module.Parse(error)) return false;
+
+        const VkShaderStageFlagBits stage = module.GetStage();
+        out.stage                         = stage;
+        out.bindings.clear();
+        out.pushConstants.clear();
+        out.vertexInputs.clear();
+
+        for (const Id& variable : module.GetIds()) {
+            if (variable.opcode != kOpVariable || variable.operands.size() < 2) continue;
+
+            const Id* pointer = module.Get(variable.operands[0]);
+            if (!pointer || pointer->opcode != kOpTypePointer) continue;
+
+            const u32 storageClass = variable.operands[1];
+            const Id* type         = module.Get(pointer->operands[1]);
+            if (!type) continue;
+
+            switch (storageClass) {
+                case kStorageUniformConstant:
+                case kStorageUniform:
+                case kStorageStorageBuffer: {
+                    if (variable.set == kUnset || variable.binding == kUnset) continue;
+
+                    // Arrays of resources become descriptor counts, runtime arrays are sized by the layout
+                    u32 count = 1;
+                    while (type && (type->opcode == kOpTypeArray || type->opcode == kOpTypeRuntimeArray)) {
+                        count = type->opcode == kOpTypeArray ? count * module.GetConstant(type->operands[1]) : 0;
+                        type  = module.Get(type->operands[0]);
+                    }
+
+                    Graphics::ReflectedBinding binding {};
+                    binding.set             = variable.set;
+                    binding.binding         = variable.binding;
+                    binding.descriptorCount = count;
+                    binding.stageFlags      = stage;
+                    if (!type || !GetDescriptorType(module, *type, storageClass, binding.descriptorType)) {
+                        error = "unsupported resource at set " + std::to_string(variable.set) + " binding " +
+                                std::to_string(variable.binding);
+                        return false;
+                    }
+
+                    out.bindings.push_back(binding);
+                    break;
+                }
+
+                case kStoragePushConstant: {
+                    if (type->opcode != kOpTypeStruct) continue;
+
+                    // Blocks declared with layout(offset = N) don't start at 0
+                    u32 offset = kUnset;
+                    for (size_t i = 0; i < type->operands.size(); i++) {
+                        offset = NE_MIN(offset, i < type->members.size() ? type->members[i].offset : 0);
+                    }
+                    if (offset == kUnset) continue;
+
+                    VkPushConstantRange range {};
+                    range.stageFlags = stage;
+                    range.offset     = offset;
+                    range.size       = module.GetTypeSize(pointer->operands[1]) - offset;
+                    out.pushConstants.push_back(range);
+                    break;
+                }
+
+                case kStorageInput: {
+                    if (stage != VK_SHADER_STAGE_VERTEX_BIT || variable.builtIn) continue;
+                    if (variable.location == kUnset) continue;
+
+                    Graphics::ReflectedVertexInput input {};
+                    input.location = variable.location;
+                    input.format   = GetVertexFormat(module, *type);
+                    out.vertexInputs.push_back(input);
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        return true;
+    }
+}  // namespace North::Tools
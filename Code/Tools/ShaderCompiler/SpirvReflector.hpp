@@ -0,0 +1,22 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#pragma once
+
+#include "Common/Common.hpp"
+#include "Graphics/ShaderReflection.hpp"
+
+namespace North::Tools {
+    /**
+     * @brief Extracts descriptor bindings, push constant ranges and vertex inputs from a SPIR-V module
+     *
+     * Only walks the debug-free subset of the module the reflection needs: entry point, decorations, types,
+     * constants and global variables. The module is expected to have a single entry point.
+     */
+    class SpirvReflector {
+    public:
+        /// @return false with `error` set if the module is malformed or uses something that can't be reflected
+        static bool Reflect(const vector<u32>& code, Graphics::ShaderReflection& out, string& error);
+    };
+}  // namespace North::Tools
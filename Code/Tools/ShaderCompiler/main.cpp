@@ -0,0 +1,51 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+
+#include "ShaderCompiler.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Usage: ShaderCompiler --source <dir> --output <dir> [--glslc <path>] [--dxc <path>] [--threads <count>] [--force]
+//   --source <dir>     Shader sources (Content/Shaders/Source)
+//   --output <dir>     Where .spv, .refl and the manifest are written (Content/Shaders/Compiled)
+//   --glslc <path>     GLSL compiler, found on PATH by default
+//   --dxc <path>       HLSL compiler, found on PATH by default
+//   --threads <count>  Parallel compiles, 0 (default) uses every hardware thread
+//   --force            Rebuild every shader
+int main(int argc, char** argv) {
+    using namespace North;
+
+    Tools::ShaderCompilerOptions options;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--source") == 0 && hasValue) {
+            options.sourceDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            options.outputDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--glslc") == 0 && hasValue) {
+            options.glslc = argv[++i];
+        } else if (std::strcmp(argv[i], "--dxc") == 0 && hasValue) {
+            options.dxc = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threadCount = CAST<u32>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--force") == 0) {
+            options.force = true;
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (options.sourceDir.empty() || options.outputDir.empty()) {
+        std::cerr << "Usage: ShaderCompiler --source <dir> --output <dir> [--glslc <path>] [--dxc <path>] "
+                     "[--threads <count>] [--force]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Tools::ShaderCompiler compiler(std::move(options));
+    return compiler.Run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
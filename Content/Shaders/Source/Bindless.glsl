@@ -0,0 +1,21 @@
+// Author: Jake Rieger
+// Created: 11/23/25.
+//
+// Declarations for the bindless table (Graphics/BindlessTable.hpp), bound at set 2. Include it with
+// GL_GOOGLE_include_directive; indices come from BindlessTable::Register*.
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 2, binding = 0) uniform texture2D bindlessTextures[];
+
+layout(std430, set = 2, binding = 1) buffer BindlessBuffer {
+    uint data[];
+} bindlessBuffers[];
+
+layout(set = 2, binding = 2) uniform sampler bindlessSamplers[];
+
+vec4 SampleBindless(uint textureIndex, uint samplerIndex, vec2 uv) {
+    texture2D image = bindlessTextures[nonuniformEXT(textureIndex)];
+    sampler filter  = bindlessSamplers[nonuniformEXT(samplerIndex)];
+    return texture(sampler2D(image, filter), uv);
+}
@@ -0,0 +1,17 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#version 460
+
+layout(location = 0) in vec3 inNormal;
+layout(location = 1) in vec2 inUV;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // Fixed directional light until materials and lights exist
+    const vec3 lightDirection = normalize(vec3(0.4, 1.0, 0.3));
+    float diffuse = max(dot(normalize(inNormal), lightDirection), 0.0);
+    outColor = vec4(vec3(0.1 + 0.9 * diffuse), 1.0);
+}
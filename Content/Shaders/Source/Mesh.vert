@@ -0,0 +1,50 @@
+// Author: Jake Rieger
+// Created: 11/22/25.
+//
+
+#version 460
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+
+struct Object {
+    mat4 model;
+    vec4 boundingSphere;
+    uint batchIndex;
+    uint flags;
+    uint padding0;
+    uint padding1;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+    Object objects[];
+};
+
+layout(std430, set = 0, binding = 2) readonly buffer VisibleInstances {
+    uint visibleInstances[];
+};
+
+// Global set from the uniform ring, bound with a dynamic offset per frame
+layout(std140, set = 1, binding = 0) uniform FrameConstants {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 cameraPosition;
+    float time;
+    float deltaTime;
+    uint frameIndex;
+    uint padding;
+} frame;
+
+layout(location = 0) out vec3 outNormal;
+layout(location = 1) out vec2 outUV;
+
+void main() {
+    // gl_InstanceIndex includes the batch's firstInstance, culling stored the object index there
+    mat4 model = objects[visibleInstances[gl_InstanceIndex]].model;
+
+    gl_Position = frame.viewProjection * model * vec4(inPosition, 1.0);
+    outNormal   = mat3(model) * inNormal;
+    outUV       = inUV;
+}